@@ -17,6 +17,7 @@
 
 // VR Logic includes
 #include "vtkSlicerVirtualRealityLogic.h"
+#include "vtkVirtualRealityMath.h"
 
 // VR MRML includes
 #include "vtkMRMLVirtualRealityViewNode.h"
@@ -494,6 +495,55 @@ bool vtkSlicerVirtualRealityLogic::ShouldConsiderQuickViewMotion(
   return true; // Default
 }
 
+//---------------------------------------------------------------------------
+void vtkSlicerVirtualRealityLogic::ComputeDeviceToWorldMatrix(
+  vtkMatrix4x4* deviceToPhysicalMatrix, vtkMatrix4x4* physicalToWorldMatrix, vtkMatrix4x4* deviceToWorldMatrix)
+{
+  if (!deviceToPhysicalMatrix || !physicalToWorldMatrix || !deviceToWorldMatrix)
+  {
+    return;
+  }
+
+  vtkMatrix4x4::Multiply4x4(physicalToWorldMatrix, deviceToPhysicalMatrix, deviceToWorldMatrix);
+
+  // Physical-to-world matrix includes the physical scale, normalize axes to only keep the rotation
+  for (int column = 0; column < 3; ++column)
+  {
+    double axis[3] = {
+      deviceToWorldMatrix->GetElement(0, column),
+      deviceToWorldMatrix->GetElement(1, column),
+      deviceToWorldMatrix->GetElement(2, column) };
+    double norm = vtkMath::Norm(axis);
+    if (norm == 0.0)
+    {
+      continue;
+    }
+    for (int row = 0; row < 3; ++row)
+    {
+      deviceToWorldMatrix->SetElement(row, column, axis[row] / norm);
+    }
+  }
+}
+
+//---------------------------------------------------------------------------
+bool vtkSlicerVirtualRealityLogic::AreMatricesEqual(vtkMatrix4x4* matrix1, vtkMatrix4x4* matrix2, double tolerance)
+{
+  if (!matrix1 || !matrix2)
+  {
+    return false;
+  }
+  const double* elements1 = matrix1->GetData();
+  const double* elements2 = matrix2->GetData();
+  for (int i = 0; i < 16; ++i)
+  {
+    if (fabs(elements1[i] - elements2[i]) > tolerance)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
 //---------------------------------------------------------------------------
 bool vtkSlicerVirtualRealityLogic::CalculateCombinedControllerPose(
   vtkMatrix4x4* controller0Pose, vtkMatrix4x4* controller1Pose, vtkMatrix4x4* combinedPose)
@@ -502,64 +552,44 @@ bool vtkSlicerVirtualRealityLogic::CalculateCombinedControllerPose(
   {
     return false;
   }
-
-  // The position will be the average position
-  double controllerCenterPos[3] = {
-    (controller0Pose->GetElement(0,3) + controller1Pose->GetElement(0,3)) / 2.0,
-    (controller0Pose->GetElement(1,3) + controller1Pose->GetElement(1,3)) / 2.0,
-    (controller0Pose->GetElement(2,3) + controller1Pose->GetElement(2,3)) / 2.0 };
-
-  // Scaling will be the distance between the two controllers
-  double controllerDistance = sqrt(
-    (controller0Pose->GetElement(0,3) - controller1Pose->GetElement(0,3))
-      * (controller0Pose->GetElement(0,3) - controller1Pose->GetElement(0,3)) +
-    (controller0Pose->GetElement(1,3) - controller1Pose->GetElement(1,3))
-      * (controller0Pose->GetElement(1,3) - controller1Pose->GetElement(1,3)) +
-    (controller0Pose->GetElement(2,3) - controller1Pose->GetElement(2,3))
-      * (controller0Pose->GetElement(2,3) - controller1Pose->GetElement(2,3)) );
-
-  // X axis is the displacement vector from controller 0 to 1
-  double xAxis[3] = {
-    controller1Pose->GetElement(0,3) - controller0Pose->GetElement(0,3),
-    controller1Pose->GetElement(1,3) - controller0Pose->GetElement(1,3),
-    controller1Pose->GetElement(2,3) - controller0Pose->GetElement(2,3) };
-  vtkMath::Normalize(xAxis);
-
-  // Y axis is calculated from a Y' and Z.
-  // 1. Y' is the average orientation of the two controller directions
-  // 2. If X and Y' are almost parallel, then return failure
-  // 3. Z is the cross product of X and Y'
-  // 4. Y is then the cross product of Z and X
-  double yAxisPrime[3] = {
-    controller0Pose->GetElement(0,1) + controller1Pose->GetElement(0,1),
-    controller0Pose->GetElement(1,1) + controller1Pose->GetElement(1,1),
-    controller0Pose->GetElement(2,1) + controller1Pose->GetElement(2,1) };
-  vtkMath::Normalize(yAxisPrime);
-
-  if (fabs(vtkMath::Dot(xAxis, yAxisPrime)) > 0.99)
-  {
-    // The two axes are almost parallel
+  vtkVirtualRealityMath::Matrix4 combined = vtkVirtualRealityMath::Matrix4::FromVTK(combinedPose);
+  if (!vtkVirtualRealityMath::CombinedControllerPose(vtkVirtualRealityMath::Matrix4::FromVTK(controller0Pose),
+    vtkVirtualRealityMath::Matrix4::FromVTK(controller1Pose), combined))
+  {
     return false;
   }
+  combined.ToVTK(combinedPose);
+  return true;
+}
 
-  double zAxis[3] = {0.0};
-  vtkMath::Cross(xAxis, yAxisPrime, zAxis);
-  vtkMath::Normalize(zAxis);
-
-  double yAxis[3] = {0.0};
-  vtkMath::Cross(zAxis, xAxis, yAxis);
-  vtkMath::Normalize(yAxis);
-
-  // Assemble matrix from the axes, the scaling, and the position
-  for (int row=0;row<3;++row)
+//---------------------------------------------------------------------------
+void vtkSlicerVirtualRealityLogic::ComputePinch3DPhysicalToWorldMatrix(
+  vtkMatrix4x4* startingPhysicalToWorldMatrix, vtkMatrix4x4* combinedStartingControllerPose,
+  vtkMatrix4x4* combinedCurrentControllerPose, vtkMatrix4x4* physicalToWorldMatrix)
+{
+  if (!startingPhysicalToWorldMatrix || !combinedStartingControllerPose
+    || !combinedCurrentControllerPose || !physicalToWorldMatrix)
   {
-    combinedPose->SetElement(row, 0, xAxis[row]*controllerDistance);
-    combinedPose->SetElement(row, 1, yAxis[row]*controllerDistance);
-    combinedPose->SetElement(row, 2, zAxis[row]*controllerDistance);
-    combinedPose->SetElement(row, 3, controllerCenterPos[row]);
+    return;
   }
+  vtkVirtualRealityMath::Pinch3DPhysicalToWorld(
+    vtkVirtualRealityMath::Matrix4::FromVTK(startingPhysicalToWorldMatrix),
+    vtkVirtualRealityMath::Matrix4::FromVTK(combinedStartingControllerPose),
+    vtkVirtualRealityMath::Matrix4::FromVTK(combinedCurrentControllerPose)).ToVTK(physicalToWorldMatrix);
+}
 
-  return true;
+//---------------------------------------------------------------------------
+void vtkSlicerVirtualRealityLogic::ComputeScaledPhysicalToWorldMatrix(
+  vtkMatrix4x4* physicalToWorldMatrix, const double focusPoint_World[3], double scaleFactor,
+  vtkMatrix4x4* scaledPhysicalToWorldMatrix)
+{
+  if (!physicalToWorldMatrix || !focusPoint_World || !scaledPhysicalToWorldMatrix)
+  {
+    return;
+  }
+  vtkVirtualRealityMath::ScaledPhysicalToWorld(
+    vtkVirtualRealityMath::Matrix4::FromVTK(physicalToWorldMatrix), focusPoint_World, scaleFactor)
+    .ToVTK(scaledPhysicalToWorldMatrix);
 }
 
 //---------------------------------------------------------------------------
@@ -672,6 +702,12 @@ void vtkSlicerVirtualRealityLogic::SetGestureButtonToNone(vtkVRRenderWindowInter
 //-----------------------------------------------------------------------------
 std::string vtkSlicerVirtualRealityLogic::ComputeActionManifestPath(vtkMRMLVirtualRealityViewNode::XRBackendType xrBackend)
 {
+  if (xrBackend == vtkMRMLVirtualRealityViewNode::Simulated)
+  {
+    // Actions of the simulated backend are set up by its interactor style, no manifest is needed
+    return std::string();
+  }
+
   std::string actionManifestPath =
       Self::ComputeActionManifestPath(this->GetModuleShareDirectory(), xrBackend, this->ModuleInstalled);
 
@@ -721,6 +757,11 @@ std::string vtkSlicerVirtualRealityLogic::ComputeActionManifestPath(
 {
   std::string actionManifestPath;
 
+  if (xrBackend == vtkMRMLVirtualRealityViewNode::Simulated)
+  {
+    return actionManifestPath;
+  }
+
   if(installed)
   {
     // Since the output of vtkSlicerModuleLogic::GetModuleShareDirectory() is
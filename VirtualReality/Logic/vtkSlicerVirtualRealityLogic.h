@@ -134,13 +134,41 @@ public:
       double lastViewPos[3], double lastViewDir[3], double lastViewUp[3],
       double viewPos[3], double viewDir[3], double viewUp[3]);
 
+  /// Compute the device-to-world matrix from the device-to-physical and physical-to-world matrices.
+  ///
+  /// Physical scale is removed from the rotation part of the result, which corresponds to the position and
+  /// orientation returned by vtkVRRenderWindowInteractor::ConvertPoseToWorldCoordinates().
+  static void ComputeDeviceToWorldMatrix(
+      vtkMatrix4x4* deviceToPhysicalMatrix, vtkMatrix4x4* physicalToWorldMatrix, vtkMatrix4x4* deviceToWorldMatrix);
+
+  /// Return true if no element of the two matrices differs by more than the tolerance.
+  static bool AreMatricesEqual(vtkMatrix4x4* matrix1, vtkMatrix4x4* matrix2, double tolerance);
+
   /// Calculate the average pose of the two controllers for pinch 3D operations
   ///
   /// \return Success flag. Failure happens when the average orientation coincides
   ///         with the direction of the displacement of the two controllers
+  /// \sa vtkVirtualRealityMath::CombinedControllerPose()
   static bool CalculateCombinedControllerPose(
       vtkMatrix4x4* controller0Pose, vtkMatrix4x4* controller1Pose, vtkMatrix4x4* combinedPose);
 
+  /// Compute the physical-to-world matrix resulting from a pinch 3D gesture.
+  ///
+  /// The world is moved, rotated and scaled so that it follows the combined controller pose
+  /// from the start of the gesture to the current pose.
+  ///
+  /// \sa CalculateCombinedControllerPose(), vtkVirtualRealityMath::Pinch3DPhysicalToWorld()
+  static void ComputePinch3DPhysicalToWorldMatrix(
+      vtkMatrix4x4* startingPhysicalToWorldMatrix, vtkMatrix4x4* combinedStartingControllerPose,
+      vtkMatrix4x4* combinedCurrentControllerPose, vtkMatrix4x4* physicalToWorldMatrix);
+
+  /// Compute the physical-to-world matrix that scales the world by scaleFactor around a focus point
+  /// specified in world coordinates.
+  /// \sa vtkVirtualRealityMath::ScaledPhysicalToWorld()
+  static void ComputeScaledPhysicalToWorldMatrix(
+      vtkMatrix4x4* physicalToWorldMatrix, const double focusPoint_World[3], double scaleFactor,
+      vtkMatrix4x4* scaledPhysicalToWorldMatrix);
+
   /// Set trigger button function
   /// By default it is the same as grab (\sa GetButtonFunctionIdForGrabObjectsAndWorld)
   /// Empty string disables button
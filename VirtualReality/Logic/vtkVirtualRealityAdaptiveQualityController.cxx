@@ -0,0 +1,130 @@
+/*==============================================================================
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// VR Logic includes
+#include "vtkVirtualRealityAdaptiveQualityController.h"
+
+// VTK includes
+#include <vtkObjectFactory.h>
+
+// STD includes
+#include <algorithm>
+#include <cmath>
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkVirtualRealityAdaptiveQualityController);
+
+//----------------------------------------------------------------------------
+vtkVirtualRealityAdaptiveQualityController::vtkVirtualRealityAdaptiveQualityController() = default;
+
+//----------------------------------------------------------------------------
+vtkVirtualRealityAdaptiveQualityController::~vtkVirtualRealityAdaptiveQualityController() = default;
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityAdaptiveQualityController::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "TargetFrameTime: " << this->TargetFrameTime << "\n";
+  os << indent << "LowerFrameTimeFraction: " << this->LowerFrameTimeFraction << "\n";
+  os << indent << "UpperFrameTimeFraction: " << this->UpperFrameTimeFraction << "\n";
+  os << indent << "FrameTimeSmoothingWeight: " << this->FrameTimeSmoothingWeight << "\n";
+  os << indent << "QualityIncreaseStep: " << this->QualityIncreaseStep << "\n";
+  os << indent << "QualityDecreaseStep: " << this->QualityDecreaseStep << "\n";
+  os << indent << "MinimumQuality: " << this->MinimumQuality << "\n";
+  os << indent << "MaximumQuality: " << this->MaximumQuality << "\n";
+  os << indent << "Quality: " << this->Quality << "\n";
+  os << indent << "SmoothedFrameTime: " << this->SmoothedFrameTime << "\n";
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityAdaptiveQualityController::Reset(double quality)
+{
+  this->Quality = std::max(this->MinimumQuality, std::min(this->MaximumQuality, quality));
+  this->SmoothedFrameTime = 0.0;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+bool vtkVirtualRealityAdaptiveQualityController::Update(double frameTime, bool allowIncrease, bool allowDecrease)
+{
+  if (frameTime <= 0.0)
+  {
+    // no measurement
+    return false;
+  }
+
+  if (this->SmoothedFrameTime <= 0.0)
+  {
+    this->SmoothedFrameTime = frameTime;
+  }
+  else
+  {
+    this->SmoothedFrameTime += this->FrameTimeSmoothingWeight * (frameTime - this->SmoothedFrameTime);
+  }
+
+  double quality = this->Quality;
+  if (this->SmoothedFrameTime > this->UpperFrameTimeFraction * this->TargetFrameTime)
+  {
+    if (allowDecrease)
+    {
+      quality -= this->QualityDecreaseStep;
+    }
+  }
+  else if (allowIncrease && this->SmoothedFrameTime < this->LowerFrameTimeFraction * this->TargetFrameTime)
+  {
+    quality += this->QualityIncreaseStep;
+  }
+  // Range may have changed since last update
+  quality = std::max(this->MinimumQuality, std::min(this->MaximumQuality, quality));
+
+  if (quality == this->Quality)
+  {
+    // no change
+    return false;
+  }
+  this->Quality = quality;
+  this->Modified();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkVirtualRealityAdaptiveQualityController::UpdateCascade(vtkVirtualRealityAdaptiveQualityController* first,
+  vtkVirtualRealityAdaptiveQualityController* second, double frameTime, bool allowIncrease/*=true*/)
+{
+  if (first == nullptr || second == nullptr)
+  {
+    vtkGenericWarningMacro("vtkVirtualRealityAdaptiveQualityController::UpdateCascade failed: invalid controller");
+    return false;
+  }
+  // Limits are checked before updating, so that at most one controller changes
+  bool firstAtMinimum = first->Quality <= first->MinimumQuality;
+  bool secondAtMaximum = second->Quality >= second->MaximumQuality;
+  bool firstChanged = first->Update(frameTime, allowIncrease && secondAtMaximum, true);
+  bool secondChanged = second->Update(frameTime, true, firstAtMinimum);
+  return firstChanged || secondChanged;
+}
+
+//----------------------------------------------------------------------------
+double vtkVirtualRealityAdaptiveQualityController::InterpolateLogarithmic(
+  double quality, double lowQualityValue, double highQualityValue)
+{
+  if (lowQualityValue <= 0.0 || highQualityValue <= 0.0)
+  {
+    vtkGenericWarningMacro("vtkVirtualRealityAdaptiveQualityController::InterpolateLogarithmic failed: values must be positive");
+    return lowQualityValue;
+  }
+  quality = std::max(0.0, std::min(1.0, quality));
+  return std::exp(std::log(lowQualityValue) + quality * (std::log(highQualityValue) - std::log(lowQualityValue)));
+}
@@ -0,0 +1,143 @@
+/*==============================================================================
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#ifndef vtkVirtualRealityAdaptiveQualityController_h
+#define vtkVirtualRealityAdaptiveQualityController_h
+
+// VR Logic includes
+#include "vtkSlicerVirtualRealityModuleLogicExport.h"
+
+// VTK includes
+#include <vtkObject.h>
+
+/// \brief Closed-loop controller of the rendering quality of the virtual reality view.
+///
+/// The controller is updated with the measured frame time of each frame and adjusts
+/// a continuous quality level (between MinimumQuality and MaximumQuality) to hold the
+/// target frame time:
+/// - the measured frame time is smoothed with an exponential moving average,
+/// - quality decreases when the smoothed frame time is above UpperFrameTimeFraction of the
+///   target, and increases when it is below LowerFrameTimeFraction of the target. Quality is
+///   kept unchanged in between, which avoids oscillations,
+/// - quality changes by at most QualityDecreaseStep or QualityIncreaseStep per frame, so
+///   that quality ramps instead of snapping.
+///
+/// The quality level is mapped to rendering parameters by the caller, for example using
+/// InterpolateLogarithmic() to compute the desired update rate of the render window.
+/// When two controllers adjust different rendering parameters from the same frame time,
+/// use UpdateCascade() so that their corrections do not add up.
+///
+/// Times are expressed in seconds.
+class VTK_SLICER_VIRTUALREALITY_MODULE_LOGIC_EXPORT vtkVirtualRealityAdaptiveQualityController : public vtkObject
+{
+public:
+  static vtkVirtualRealityAdaptiveQualityController* New();
+  vtkTypeMacro(vtkVirtualRealityAdaptiveQualityController, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /// Frame time to hold. Default is 1/90 s.
+  vtkSetClampMacro(TargetFrameTime, double, 0.0001, 10.0);
+  vtkGetMacro(TargetFrameTime, double);
+  ///}@
+
+  ///@{
+  /// Quality increases when the smoothed frame time is below this fraction of the target frame time.
+  /// Default is 0.7.
+  vtkSetClampMacro(LowerFrameTimeFraction, double, 0.0, 1.0);
+  vtkGetMacro(LowerFrameTimeFraction, double);
+  ///}@
+
+  ///@{
+  /// Quality decreases when the smoothed frame time is above this fraction of the target frame time.
+  /// Default is 0.9.
+  vtkSetClampMacro(UpperFrameTimeFraction, double, 0.0, 10.0);
+  vtkGetMacro(UpperFrameTimeFraction, double);
+  ///}@
+
+  ///@{
+  /// Weight of the last measured frame time in the smoothed frame time. Default is 0.2.
+  vtkSetClampMacro(FrameTimeSmoothingWeight, double, 0.0, 1.0);
+  vtkGetMacro(FrameTimeSmoothingWeight, double);
+  ///}@
+
+  ///@{
+  /// Largest change of the quality level per frame. Quality decreases faster than it
+  /// increases to quickly recover from frames over budget. Defaults are 0.01 and 0.05.
+  vtkSetClampMacro(QualityIncreaseStep, double, 0.0, 1.0);
+  vtkGetMacro(QualityIncreaseStep, double);
+  vtkSetClampMacro(QualityDecreaseStep, double, 0.0, 1.0);
+  vtkGetMacro(QualityDecreaseStep, double);
+  ///}@
+
+  ///@{
+  /// Range of the quality level. Defaults are 0.0 and 1.0.
+  vtkSetClampMacro(MinimumQuality, double, 0.0, 1.0);
+  vtkGetMacro(MinimumQuality, double);
+  vtkSetClampMacro(MaximumQuality, double, 0.0, 1.0);
+  vtkGetMacro(MaximumQuality, double);
+  ///}@
+
+  /// Current quality level, between MinimumQuality and MaximumQuality.
+  vtkGetMacro(Quality, double);
+
+  /// Smoothed frame time. 0 if no frame time has been measured since the last reset.
+  vtkGetMacro(SmoothedFrameTime, double);
+
+  /// Reset frame time measurements and set the current quality level.
+  void Reset(double quality);
+
+  /// Update the quality level from the frame time measured for the last frame.
+  /// If \a allowIncrease is false then quality may only decrease, for example while the view is moving quickly.
+  /// If \a allowDecrease is false then quality may only increase. The frame time is measured in all cases.
+  /// Return true if the quality level changed.
+  bool Update(double frameTime, bool allowIncrease = true, bool allowDecrease = true);
+
+  /// Update two controllers from the same frame time, so that only one of them changes its quality level
+  /// at each frame. The \a first controller is lowered first: the \a second one is only lowered once the
+  /// first is at its MinimumQuality. The \a second controller is raised first: the \a first one is only
+  /// raised once the second is at its MaximumQuality. If \a allowIncrease is false then the first
+  /// controller may only decrease.
+  /// Return true if the quality level of any of the controllers changed.
+  static bool UpdateCascade(vtkVirtualRealityAdaptiveQualityController* first,
+    vtkVirtualRealityAdaptiveQualityController* second, double frameTime, bool allowIncrease = true);
+
+  /// Interpolate between a low and a high quality value (both must be positive) along a logarithmic scale.
+  /// Logarithmic scale is suitable for rendering parameters that span several orders of magnitude,
+  /// such as the desired update rate of a render window.
+  static double InterpolateLogarithmic(double quality, double lowQualityValue, double highQualityValue);
+
+protected:
+  vtkVirtualRealityAdaptiveQualityController();
+  ~vtkVirtualRealityAdaptiveQualityController() override;
+
+  double TargetFrameTime{1.0 / 90.0};
+  double LowerFrameTimeFraction{0.7};
+  double UpperFrameTimeFraction{0.9};
+  double FrameTimeSmoothingWeight{0.2};
+  double QualityIncreaseStep{0.01};
+  double QualityDecreaseStep{0.05};
+  double MinimumQuality{0.0};
+  double MaximumQuality{1.0};
+
+  double Quality{0.0};
+  double SmoothedFrameTime{0.0};
+
+private:
+  vtkVirtualRealityAdaptiveQualityController(const vtkVirtualRealityAdaptiveQualityController&) = delete;
+  void operator=(const vtkVirtualRealityAdaptiveQualityController&) = delete;
+};
+
+#endif
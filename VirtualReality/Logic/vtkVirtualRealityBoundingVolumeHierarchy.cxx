@@ -0,0 +1,255 @@
+/*==============================================================================
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// VR Logic includes
+#include "vtkVirtualRealityBoundingVolumeHierarchy.h"
+
+// VTK includes
+#include <vtkObjectFactory.h>
+
+// STD includes
+#include <algorithm>
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkVirtualRealityBoundingVolumeHierarchy);
+
+//----------------------------------------------------------------------------
+vtkVirtualRealityBoundingVolumeHierarchy::vtkVirtualRealityBoundingVolumeHierarchy() = default;
+
+//----------------------------------------------------------------------------
+vtkVirtualRealityBoundingVolumeHierarchy::~vtkVirtualRealityBoundingVolumeHierarchy() = default;
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityBoundingVolumeHierarchy::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfItems: " << this->GetNumberOfItems() << "\n";
+  os << indent << "MaximumNumberOfItemsPerLeaf: " << this->MaximumNumberOfItemsPerLeaf << "\n";
+  os << indent << "NumberOfHierarchyNodes: " << this->GetNumberOfHierarchyNodes() << "\n";
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityBoundingVolumeHierarchy::Initialize()
+{
+  this->ItemBounds.clear();
+  this->SortedItems.clear();
+  this->ItemLeaves.clear();
+  this->Nodes.clear();
+  this->Built = false;
+}
+
+//----------------------------------------------------------------------------
+int vtkVirtualRealityBoundingVolumeHierarchy::AddItem(const double bounds[6])
+{
+  this->ItemBounds.push_back({ bounds[0], bounds[1], bounds[2], bounds[3], bounds[4], bounds[5] });
+  this->Built = false;
+  return static_cast<int>(this->ItemBounds.size()) - 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkVirtualRealityBoundingVolumeHierarchy::GetNumberOfItems() const
+{
+  return static_cast<int>(this->ItemBounds.size());
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityBoundingVolumeHierarchy::SetItemBounds(int itemIndex, const double bounds[6])
+{
+  if (itemIndex < 0 || itemIndex >= this->GetNumberOfItems())
+  {
+    vtkErrorMacro("SetItemBounds failed: invalid item index " << itemIndex);
+    return;
+  }
+  std::copy(bounds, bounds + 6, this->ItemBounds[itemIndex].begin());
+  if (!this->Built)
+  {
+    return;
+  }
+  // Refit the leaf and its ancestors
+  for (int nodeIndex = this->ItemLeaves[itemIndex]; nodeIndex >= 0; nodeIndex = this->Nodes[nodeIndex].Parent)
+  {
+    this->UpdateNodeBounds(nodeIndex);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityBoundingVolumeHierarchy::GetItemBounds(int itemIndex, double bounds[6]) const
+{
+  if (itemIndex < 0 || itemIndex >= this->GetNumberOfItems())
+  {
+    vtkErrorMacro("GetItemBounds failed: invalid item index " << itemIndex);
+    return;
+  }
+  std::copy(this->ItemBounds[itemIndex].begin(), this->ItemBounds[itemIndex].end(), bounds);
+}
+
+//----------------------------------------------------------------------------
+int vtkVirtualRealityBoundingVolumeHierarchy::GetNumberOfHierarchyNodes() const
+{
+  return this->Built ? static_cast<int>(this->Nodes.size()) : 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityBoundingVolumeHierarchy::Build()
+{
+  int numberOfItems = this->GetNumberOfItems();
+  this->Nodes.clear();
+  this->SortedItems.resize(numberOfItems);
+  this->ItemLeaves.resize(numberOfItems);
+  for (int itemIndex = 0; itemIndex < numberOfItems; ++itemIndex)
+  {
+    this->SortedItems[itemIndex] = itemIndex;
+  }
+  if (numberOfItems > 0)
+  {
+    this->Nodes.reserve(2 * numberOfItems);
+    this->BuildNode(-1, 0, numberOfItems);
+  }
+  this->Built = true;
+}
+
+//----------------------------------------------------------------------------
+int vtkVirtualRealityBoundingVolumeHierarchy::BuildNode(int parent, int begin, int end)
+{
+  int nodeIndex = static_cast<int>(this->Nodes.size());
+  this->Nodes.emplace_back();
+  this->Nodes[nodeIndex].Parent = parent;
+  this->Nodes[nodeIndex].Begin = begin;
+  this->Nodes[nodeIndex].End = end;
+
+  if (end - begin <= this->MaximumNumberOfItemsPerLeaf)
+  {
+    for (int sortedIndex = begin; sortedIndex < end; ++sortedIndex)
+    {
+      this->ItemLeaves[this->SortedItems[sortedIndex]] = nodeIndex;
+    }
+    this->UpdateNodeBounds(nodeIndex);
+    return nodeIndex;
+  }
+
+  // Split at the median of the item centers along the axis of largest extent
+  double centerBounds[6] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN, VTK_DOUBLE_MAX, VTK_DOUBLE_MIN, VTK_DOUBLE_MAX, VTK_DOUBLE_MIN };
+  for (int sortedIndex = begin; sortedIndex < end; ++sortedIndex)
+  {
+    const std::array<double, 6>& itemBounds = this->ItemBounds[this->SortedItems[sortedIndex]];
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      double center = 0.5 * (itemBounds[2 * axis] + itemBounds[2 * axis + 1]);
+      centerBounds[2 * axis] = std::min(centerBounds[2 * axis], center);
+      centerBounds[2 * axis + 1] = std::max(centerBounds[2 * axis + 1], center);
+    }
+  }
+  int splitAxis = 0;
+  for (int axis = 1; axis < 3; ++axis)
+  {
+    if (centerBounds[2 * axis + 1] - centerBounds[2 * axis] > centerBounds[2 * splitAxis + 1] - centerBounds[2 * splitAxis])
+    {
+      splitAxis = axis;
+    }
+  }
+  int middle = begin + (end - begin) / 2;
+  std::nth_element(this->SortedItems.begin() + begin, this->SortedItems.begin() + middle, this->SortedItems.begin() + end,
+    [this, splitAxis](int item1, int item2)
+    {
+      return this->ItemBounds[item1][2 * splitAxis] + this->ItemBounds[item1][2 * splitAxis + 1]
+        < this->ItemBounds[item2][2 * splitAxis] + this->ItemBounds[item2][2 * splitAxis + 1];
+    });
+
+  // Nodes may be reallocated while building children, therefore they are accessed by index
+  int left = this->BuildNode(nodeIndex, begin, middle);
+  int right = this->BuildNode(nodeIndex, middle, end);
+  this->Nodes[nodeIndex].Left = left;
+  this->Nodes[nodeIndex].Right = right;
+  this->UpdateNodeBounds(nodeIndex);
+  return nodeIndex;
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityBoundingVolumeHierarchy::UpdateNodeBounds(int nodeIndex)
+{
+  HierarchyNode& node = this->Nodes[nodeIndex];
+  double bounds[6] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN, VTK_DOUBLE_MAX, VTK_DOUBLE_MIN, VTK_DOUBLE_MAX, VTK_DOUBLE_MIN };
+  auto addBounds = [&bounds](const double* otherBounds)
+  {
+    for (int axis = 0; axis < 3; ++axis)
+    {
+      bounds[2 * axis] = std::min(bounds[2 * axis], otherBounds[2 * axis]);
+      bounds[2 * axis + 1] = std::max(bounds[2 * axis + 1], otherBounds[2 * axis + 1]);
+    }
+  };
+  if (node.Left < 0)
+  {
+    for (int sortedIndex = node.Begin; sortedIndex < node.End; ++sortedIndex)
+    {
+      addBounds(this->ItemBounds[this->SortedItems[sortedIndex]].data());
+    }
+  }
+  else
+  {
+    addBounds(this->Nodes[node.Left].Bounds);
+    addBounds(this->Nodes[node.Right].Bounds);
+  }
+  std::copy(bounds, bounds + 6, node.Bounds);
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityBoundingVolumeHierarchy::FindItemsAtPoint(
+  const double point[3], double tolerance, std::vector<int>& itemIndices)
+{
+  itemIndices.clear();
+  if (!this->Built)
+  {
+    this->Build();
+  }
+  if (this->Nodes.empty())
+  {
+    return;
+  }
+
+  auto containsPoint = [point, tolerance](const double* bounds)
+  {
+    return point[0] >= bounds[0] - tolerance && point[0] <= bounds[1] + tolerance
+      && point[1] >= bounds[2] - tolerance && point[1] <= bounds[3] + tolerance
+      && point[2] >= bounds[4] - tolerance && point[2] <= bounds[5] + tolerance;
+  };
+
+  this->Stack.clear();
+  this->Stack.push_back(0);
+  while (!this->Stack.empty())
+  {
+    const HierarchyNode& node = this->Nodes[this->Stack.back()];
+    this->Stack.pop_back();
+    if (!containsPoint(node.Bounds))
+    {
+      continue;
+    }
+    if (node.Left < 0)
+    {
+      for (int sortedIndex = node.Begin; sortedIndex < node.End; ++sortedIndex)
+      {
+        int itemIndex = this->SortedItems[sortedIndex];
+        if (containsPoint(this->ItemBounds[itemIndex].data()))
+        {
+          itemIndices.push_back(itemIndex);
+        }
+      }
+    }
+    else
+    {
+      this->Stack.push_back(node.Left);
+      this->Stack.push_back(node.Right);
+    }
+  }
+}
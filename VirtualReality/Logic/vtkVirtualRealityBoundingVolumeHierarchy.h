@@ -0,0 +1,111 @@
+/*==============================================================================
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#ifndef vtkVirtualRealityBoundingVolumeHierarchy_h
+#define vtkVirtualRealityBoundingVolumeHierarchy_h
+
+// VR Logic includes
+#include "vtkSlicerVirtualRealityModuleLogicExport.h"
+
+// VTK includes
+#include <vtkObject.h>
+
+// STD includes
+#include <array>
+#include <vector>
+
+/// \brief Bounding volume hierarchy of axis-aligned boxes for point queries.
+///
+/// Items are identified by the index returned by AddItem(). The hierarchy is built
+/// with a median split along the longest axis of the item centers, either explicitly
+/// with Build() or on the first query after items were added.
+///
+/// SetItemBounds() refits the hierarchy: bounds of the leaf containing the item and
+/// of its ancestors are updated, the tree topology is kept. This is cheap but the
+/// hierarchy may become less efficient after large displacements, Build() may be called
+/// to optimize it again.
+class VTK_SLICER_VIRTUALREALITY_MODULE_LOGIC_EXPORT vtkVirtualRealityBoundingVolumeHierarchy : public vtkObject
+{
+public:
+  static vtkVirtualRealityBoundingVolumeHierarchy* New();
+  vtkTypeMacro(vtkVirtualRealityBoundingVolumeHierarchy, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /// Remove all items.
+  void Initialize();
+
+  /// Add an item and return its index. The hierarchy is rebuilt at the next query.
+  int AddItem(const double bounds[6]);
+
+  /// Number of items added since the last Initialize().
+  int GetNumberOfItems() const;
+
+  ///@{
+  /// Set/get bounds of an item. Setting bounds refits the hierarchy if it is already built.
+  void SetItemBounds(int itemIndex, const double bounds[6]);
+  void GetItemBounds(int itemIndex, double bounds[6]) const;
+  ///}@
+
+  ///@{
+  /// Maximum number of items stored in a leaf. Default is 4.
+  vtkSetClampMacro(MaximumNumberOfItemsPerLeaf, int, 1, 64);
+  vtkGetMacro(MaximumNumberOfItemsPerLeaf, int);
+  ///}@
+
+  /// Build the hierarchy from the current item bounds.
+  void Build();
+
+  /// Number of nodes of the hierarchy (0 if not built).
+  int GetNumberOfHierarchyNodes() const;
+
+  /// Get indices of the items whose bounds, enlarged by tolerance, contain the point.
+  void FindItemsAtPoint(const double point[3], double tolerance, std::vector<int>& itemIndices);
+
+protected:
+  vtkVirtualRealityBoundingVolumeHierarchy();
+  ~vtkVirtualRealityBoundingVolumeHierarchy() override;
+
+  struct HierarchyNode
+  {
+    double Bounds[6];
+    int Parent{-1};
+    int Left{-1};
+    int Right{-1};
+    /// Range of items in SortedItems, only used by leaves
+    int Begin{0};
+    int End{0};
+  };
+
+  int BuildNode(int parent, int begin, int end);
+  void UpdateNodeBounds(int nodeIndex);
+
+  int MaximumNumberOfItemsPerLeaf{4};
+  bool Built{false};
+
+  std::vector<std::array<double, 6>> ItemBounds;
+  /// Item indices ordered so that each leaf refers to a contiguous range
+  std::vector<int> SortedItems;
+  /// Leaf node index of each item
+  std::vector<int> ItemLeaves;
+  std::vector<HierarchyNode> Nodes;
+  /// Traversal stack, kept to avoid allocations in queries
+  std::vector<int> Stack;
+
+private:
+  vtkVirtualRealityBoundingVolumeHierarchy(const vtkVirtualRealityBoundingVolumeHierarchy&) = delete;
+  void operator=(const vtkVirtualRealityBoundingVolumeHierarchy&) = delete;
+};
+
+#endif
@@ -0,0 +1,138 @@
+/*==============================================================================
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// VR Logic includes
+#include "vtkVirtualRealityFramePacer.h"
+
+// VTK includes
+#include <vtkObjectFactory.h>
+
+// STD includes
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace
+{
+// Weights of the exponential moving average used for estimating the frame duration.
+// The estimate rises quickly when frames get slower and decays slowly when they get faster,
+// so that a single fast frame does not make the next wake-up too late.
+const double FrameDurationRisingWeight = 0.5;
+const double FrameDurationFallingWeight = 0.05;
+}
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkVirtualRealityFramePacer);
+
+//----------------------------------------------------------------------------
+vtkVirtualRealityFramePacer::vtkVirtualRealityFramePacer() = default;
+
+//----------------------------------------------------------------------------
+vtkVirtualRealityFramePacer::~vtkVirtualRealityFramePacer() = default;
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityFramePacer::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "RefreshRate: " << this->RefreshRate << "\n";
+  os << indent << "WakeUpMargin: " << this->WakeUpMargin << "\n";
+  os << indent << "NumberOfFrames: " << this->NumberOfFrames << "\n";
+  os << indent << "NumberOfMissedDeadlines: " << this->NumberOfMissedDeadlines << "\n";
+  os << indent << "LastFrameMissedDeadline: " << this->LastFrameMissedDeadline << "\n";
+  os << indent << "LastFrameDuration: " << this->LastFrameDuration << "\n";
+  os << indent << "EstimatedFrameDuration: " << this->EstimatedFrameDuration << "\n";
+}
+
+//----------------------------------------------------------------------------
+double vtkVirtualRealityFramePacer::GetTime()
+{
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//----------------------------------------------------------------------------
+double vtkVirtualRealityFramePacer::GetFramePeriod() const
+{
+  return 1.0 / this->RefreshRate;
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityFramePacer::Reset()
+{
+  this->GridOrigin = -1.0;
+  this->FrameStartTime = 0.0;
+  this->FrameDeadline = 0.0;
+  this->NextWakeUpTime = 0.0;
+  this->NumberOfFrames = 0;
+  this->NumberOfMissedDeadlines = 0;
+  this->LastFrameMissedDeadline = false;
+  this->LastFrameDuration = 0.0;
+  this->EstimatedFrameDuration = 0.0;
+}
+
+//----------------------------------------------------------------------------
+double vtkVirtualRealityFramePacer::GetNextGridPoint(double time) const
+{
+  const double framePeriod = this->GetFramePeriod();
+  double numberOfPeriods = std::floor((time - this->GridOrigin) / framePeriod) + 1.0;
+  return this->GridOrigin + numberOfPeriods * framePeriod;
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityFramePacer::BeginFrame()
+{
+  double now = vtkVirtualRealityFramePacer::GetTime();
+  if (this->GridOrigin < 0.0)
+  {
+    this->GridOrigin = now;
+  }
+  this->FrameStartTime = now;
+  this->FrameDeadline = this->GetNextGridPoint(now);
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityFramePacer::EndFrame()
+{
+  double now = vtkVirtualRealityFramePacer::GetTime();
+
+  this->NumberOfFrames++;
+  this->LastFrameDuration = now - this->FrameStartTime;
+  this->LastFrameMissedDeadline = (now > this->FrameDeadline);
+  if (this->LastFrameMissedDeadline)
+  {
+    this->NumberOfMissedDeadlines++;
+    // Re-anchor the grid on the late frame so that the next frame gets a full period
+    this->GridOrigin = now;
+  }
+
+  if (this->NumberOfFrames == 1)
+  {
+    this->EstimatedFrameDuration = this->LastFrameDuration;
+  }
+  else
+  {
+    double weight = (this->LastFrameDuration > this->EstimatedFrameDuration)
+      ? FrameDurationRisingWeight : FrameDurationFallingWeight;
+    this->EstimatedFrameDuration += weight * (this->LastFrameDuration - this->EstimatedFrameDuration);
+  }
+
+  double nextDeadline = this->GetNextGridPoint(now);
+  this->NextWakeUpTime = std::max(now, nextDeadline - this->EstimatedFrameDuration - this->WakeUpMargin);
+}
+
+//----------------------------------------------------------------------------
+double vtkVirtualRealityFramePacer::GetTimeUntilNextWakeUp() const
+{
+  return std::max(0.0, this->NextWakeUpTime - vtkVirtualRealityFramePacer::GetTime());
+}
@@ -0,0 +1,121 @@
+/*==============================================================================
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#ifndef vtkVirtualRealityFramePacer_h
+#define vtkVirtualRealityFramePacer_h
+
+// VR Logic includes
+#include "vtkSlicerVirtualRealityModuleLogicExport.h"
+
+// VTK includes
+#include <vtkObject.h>
+
+/// \brief Deadline-driven scheduler for the virtual reality render loop.
+///
+/// Frames are laid out on a grid whose period is derived from the headset
+/// refresh rate. Each frame has a deadline (the next grid point) by which input
+/// polling, pose publishing and rendering must be completed. After a frame is
+/// completed, GetTimeUntilNextWakeUp() returns how long the caller may sleep so
+/// that the next frame starts just early enough to meet its deadline, based on
+/// a running estimate of the frame duration.
+///
+/// Typical usage:
+/// \code
+/// pacer->BeginFrame();
+/// // poll input, publish poses, render
+/// pacer->EndFrame();
+/// timer.start(pacer->GetTimeUntilNextWakeUp() * 1000.0);
+/// \endcode
+///
+/// Times are expressed in seconds and measured with a monotonic clock.
+class VTK_SLICER_VIRTUALREALITY_MODULE_LOGIC_EXPORT vtkVirtualRealityFramePacer : public vtkObject
+{
+public:
+  static vtkVirtualRealityFramePacer* New();
+  vtkTypeMacro(vtkVirtualRealityFramePacer, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /// Headset display refresh rate (in Hz). The frame period is its inverse.
+  /// Default is 90 Hz.
+  vtkSetClampMacro(RefreshRate, double, 1.0, 1000.0);
+  vtkGetMacro(RefreshRate, double);
+  ///}@
+
+  /// Get frame period in seconds.
+  double GetFramePeriod() const;
+
+  ///@{
+  /// Time (in seconds) reserved on top of the estimated frame duration when
+  /// computing the wake-up point, to absorb timer and scheduling jitter.
+  /// Default is 0.002 s.
+  vtkSetClampMacro(WakeUpMargin, double, 0.0, 1.0);
+  vtkGetMacro(WakeUpMargin, double);
+  ///}@
+
+  /// Reset frame statistics and re-anchor the frame grid at the next frame.
+  void Reset();
+
+  /// Mark the beginning of the work for a frame.
+  void BeginFrame();
+
+  /// Mark the end of the work for the current frame. Updates the frame duration
+  /// estimate, checks the deadline and computes the next wake-up point.
+  void EndFrame();
+
+  /// Get the time (in seconds) the caller should wait before starting the next frame.
+  /// Returns 0 if the wake-up point is already in the past.
+  double GetTimeUntilNextWakeUp() const;
+
+  ///@{
+  /// Frame statistics.
+  vtkGetMacro(NumberOfFrames, vtkTypeInt64);
+  vtkGetMacro(NumberOfMissedDeadlines, vtkTypeInt64);
+  vtkGetMacro(LastFrameMissedDeadline, bool);
+  vtkGetMacro(LastFrameDuration, double);
+  vtkGetMacro(EstimatedFrameDuration, double);
+  ///}@
+
+  /// Get current time of the monotonic clock used by the pacer (in seconds).
+  static double GetTime();
+
+protected:
+  vtkVirtualRealityFramePacer();
+  ~vtkVirtualRealityFramePacer() override;
+
+  /// Return the first grid point strictly after \a time.
+  double GetNextGridPoint(double time) const;
+
+  double RefreshRate{90.0};
+  double WakeUpMargin{0.002};
+
+  /// Time origin of the frame grid. Negative value means not anchored.
+  double GridOrigin{-1.0};
+  double FrameStartTime{0.0};
+  double FrameDeadline{0.0};
+  double NextWakeUpTime{0.0};
+
+  vtkTypeInt64 NumberOfFrames{0};
+  vtkTypeInt64 NumberOfMissedDeadlines{0};
+  bool LastFrameMissedDeadline{false};
+  double LastFrameDuration{0.0};
+  double EstimatedFrameDuration{0.0};
+
+private:
+  vtkVirtualRealityFramePacer(const vtkVirtualRealityFramePacer&) = delete;
+  void operator=(const vtkVirtualRealityFramePacer&) = delete;
+};
+
+#endif
@@ -0,0 +1,332 @@
+/*==============================================================================
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// VR Logic includes
+#include "vtkVirtualRealityFramePacer.h"
+#include "vtkVirtualRealityFrameTimingLog.h"
+
+// VTK includes
+#include <vtkCommand.h>
+#include <vtkObjectFactory.h>
+
+// STD includes
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkVirtualRealityFrameTimingLog);
+
+//----------------------------------------------------------------------------
+vtkVirtualRealityFrameTimingLog::vtkVirtualRealityFrameTimingLog()
+{
+  this->SetCapacity(1024);
+}
+
+//----------------------------------------------------------------------------
+vtkVirtualRealityFrameTimingLog::~vtkVirtualRealityFrameTimingLog() = default;
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityFrameTimingLog::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Capacity: " << this->GetCapacity() << "\n";
+  os << indent << "NumberOfFrames: " << this->NumberOfFrames << "\n";
+  os << indent << "NumberOfRecordedFrames: " << this->NumberOfRecordedFrames << "\n";
+  os << indent << "NumberOfDroppedFrames: " << this->GetNumberOfDroppedFrames() << "\n";
+}
+
+//----------------------------------------------------------------------------
+const char* vtkVirtualRealityFrameTimingLog::GetPhaseAsString(int phase)
+{
+  switch (phase)
+  {
+    case InteractorEventPhase: return "InteractorEvent";
+    case MotionCheckPhase: return "MotionCheck";
+    case ControllerPosePhase: return "ControllerPose";
+    case HMDPosePhase: return "HMDPose";
+    case TrackerPosePhase: return "TrackerPose";
+    case RenderPhase: return "Render";
+    case TotalPhase: return "Total";
+    default:
+      // invalid id
+      return "";
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkVirtualRealityFrameTimingLog::GetPhaseFromString(const char* name)
+{
+  if (name == nullptr)
+  {
+    // invalid name
+    return -1;
+  }
+  for (int phase = 0; phase < Phase_Last; phase++)
+  {
+    if (strcmp(name, vtkVirtualRealityFrameTimingLog::GetPhaseAsString(phase)) == 0)
+    {
+      // found a matching name
+      return phase;
+    }
+  }
+  // unknown name
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityFrameTimingLog::SetCapacity(int capacity)
+{
+  if (capacity < 1)
+  {
+    vtkErrorMacro("SetCapacity failed: capacity must be positive");
+    return;
+  }
+  this->Frames.assign(capacity, FrameRecord());
+  this->SortedDurations.assign(capacity, 0.0);
+  this->Clear();
+}
+
+//----------------------------------------------------------------------------
+int vtkVirtualRealityFrameTimingLog::GetCapacity() const
+{
+  return static_cast<int>(this->Frames.size());
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityFrameTimingLog::Clear()
+{
+  this->NextFrameIndex = 0;
+  this->NumberOfFrames = 0;
+  this->NumberOfRecordedFrames = 0;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityFrameTimingLog::StartFrame()
+{
+  this->CurrentFrame = FrameRecord();
+  this->CurrentFrame.StartTime = vtkVirtualRealityFramePacer::GetTime();
+  this->InvokeEvent(vtkCommand::StartEvent);
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityFrameTimingLog::StartPhase(int phase)
+{
+  if (phase < 0 || phase >= Phase_Last)
+  {
+    return;
+  }
+  this->CurrentPhaseStartTimes[phase] = vtkVirtualRealityFramePacer::GetTime();
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityFrameTimingLog::EndPhase(int phase)
+{
+  if (phase < 0 || phase >= Phase_Last)
+  {
+    return;
+  }
+  this->CurrentFrame.PhaseDurations[phase] +=
+    vtkVirtualRealityFramePacer::GetTime() - this->CurrentPhaseStartTimes[phase];
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityFrameTimingLog::EndFrame(bool dropped)
+{
+  this->CurrentFrame.PhaseDurations[TotalPhase] =
+    vtkVirtualRealityFramePacer::GetTime() - this->CurrentFrame.StartTime;
+  this->CurrentFrame.Dropped = dropped;
+
+  this->Frames[this->NextFrameIndex] = this->CurrentFrame;
+  this->NextFrameIndex = (this->NextFrameIndex + 1) % this->GetCapacity();
+  this->NumberOfFrames = std::min(this->NumberOfFrames + 1, this->GetCapacity());
+  this->NumberOfRecordedFrames++;
+  this->InvokeEvent(vtkCommand::EndEvent);
+}
+
+//----------------------------------------------------------------------------
+double vtkVirtualRealityFrameTimingLog::GetCurrentPhaseDuration(int phase) const
+{
+  if (phase < 0 || phase >= Phase_Last)
+  {
+    vtkErrorMacro("GetCurrentPhaseDuration failed: invalid phase " << phase);
+    return 0.0;
+  }
+  return this->CurrentFrame.PhaseDurations[phase];
+}
+
+//----------------------------------------------------------------------------
+int vtkVirtualRealityFrameTimingLog::GetNumberOfFrames() const
+{
+  return this->NumberOfFrames;
+}
+
+//----------------------------------------------------------------------------
+const vtkVirtualRealityFrameTimingLog::FrameRecord& vtkVirtualRealityFrameTimingLog::GetFrame(int frameIndex) const
+{
+  int capacity = this->GetCapacity();
+  int oldestFrameIndex = (this->NextFrameIndex - this->NumberOfFrames + capacity) % capacity;
+  return this->Frames[(oldestFrameIndex + frameIndex) % capacity];
+}
+
+//----------------------------------------------------------------------------
+double vtkVirtualRealityFrameTimingLog::GetPhaseDuration(int frameIndex, int phase) const
+{
+  if (frameIndex < 0 || frameIndex >= this->NumberOfFrames || phase < 0 || phase >= Phase_Last)
+  {
+    vtkErrorMacro("GetPhaseDuration failed: invalid frame index " << frameIndex << " or phase " << phase);
+    return 0.0;
+  }
+  return this->GetFrame(frameIndex).PhaseDurations[phase];
+}
+
+//----------------------------------------------------------------------------
+double vtkVirtualRealityFrameTimingLog::GetFrameStartTime(int frameIndex) const
+{
+  if (frameIndex < 0 || frameIndex >= this->NumberOfFrames)
+  {
+    vtkErrorMacro("GetFrameStartTime failed: invalid frame index " << frameIndex);
+    return 0.0;
+  }
+  return this->GetFrame(frameIndex).StartTime;
+}
+
+//----------------------------------------------------------------------------
+bool vtkVirtualRealityFrameTimingLog::GetFrameDropped(int frameIndex) const
+{
+  if (frameIndex < 0 || frameIndex >= this->NumberOfFrames)
+  {
+    vtkErrorMacro("GetFrameDropped failed: invalid frame index " << frameIndex);
+    return false;
+  }
+  return this->GetFrame(frameIndex).Dropped;
+}
+
+//----------------------------------------------------------------------------
+double vtkVirtualRealityFrameTimingLog::GetPhaseDurationPercentile(int phase, double percentile) const
+{
+  if (phase < 0 || phase >= Phase_Last)
+  {
+    vtkErrorMacro("GetPhaseDurationPercentile failed: invalid phase " << phase);
+    return 0.0;
+  }
+  if (this->NumberOfFrames == 0)
+  {
+    return 0.0;
+  }
+  percentile = std::max(0.0, std::min(100.0, percentile));
+
+  for (int frameIndex = 0; frameIndex < this->NumberOfFrames; ++frameIndex)
+  {
+    this->SortedDurations[frameIndex] = this->GetFrame(frameIndex).PhaseDurations[phase];
+  }
+
+  // Nearest-rank method
+  int rank = static_cast<int>(std::ceil(percentile / 100.0 * this->NumberOfFrames)) - 1;
+  rank = std::max(0, std::min(this->NumberOfFrames - 1, rank));
+  std::vector<double>::iterator begin = this->SortedDurations.begin();
+  std::nth_element(begin, begin + rank, begin + this->NumberOfFrames);
+  return this->SortedDurations[rank];
+}
+
+//----------------------------------------------------------------------------
+double vtkVirtualRealityFrameTimingLog::GetPhaseDurationMean(int phase) const
+{
+  if (phase < 0 || phase >= Phase_Last)
+  {
+    vtkErrorMacro("GetPhaseDurationMean failed: invalid phase " << phase);
+    return 0.0;
+  }
+  if (this->NumberOfFrames == 0)
+  {
+    return 0.0;
+  }
+  double sum = 0.0;
+  for (int frameIndex = 0; frameIndex < this->NumberOfFrames; ++frameIndex)
+  {
+    sum += this->GetFrame(frameIndex).PhaseDurations[phase];
+  }
+  return sum / this->NumberOfFrames;
+}
+
+//----------------------------------------------------------------------------
+double vtkVirtualRealityFrameTimingLog::GetPhaseDurationMaximum(int phase) const
+{
+  if (phase < 0 || phase >= Phase_Last)
+  {
+    vtkErrorMacro("GetPhaseDurationMaximum failed: invalid phase " << phase);
+    return 0.0;
+  }
+  double maximum = 0.0;
+  for (int frameIndex = 0; frameIndex < this->NumberOfFrames; ++frameIndex)
+  {
+    maximum = std::max(maximum, this->GetFrame(frameIndex).PhaseDurations[phase]);
+  }
+  return maximum;
+}
+
+//----------------------------------------------------------------------------
+int vtkVirtualRealityFrameTimingLog::GetNumberOfDroppedFrames() const
+{
+  int numberOfDroppedFrames = 0;
+  for (int frameIndex = 0; frameIndex < this->NumberOfFrames; ++frameIndex)
+  {
+    if (this->GetFrame(frameIndex).Dropped)
+    {
+      numberOfDroppedFrames++;
+    }
+  }
+  return numberOfDroppedFrames;
+}
+
+//----------------------------------------------------------------------------
+bool vtkVirtualRealityFrameTimingLog::WriteCSV(const char* fileName) const
+{
+  if (fileName == nullptr)
+  {
+    vtkErrorMacro("WriteCSV failed: invalid file name");
+    return false;
+  }
+  std::ofstream file(fileName);
+  if (!file.is_open())
+  {
+    vtkErrorMacro("WriteCSV failed: unable to open file " << fileName);
+    return false;
+  }
+
+  file << "Frame,StartTime";
+  for (int phase = 0; phase < Phase_Last; phase++)
+  {
+    file << "," << vtkVirtualRealityFrameTimingLog::GetPhaseAsString(phase);
+  }
+  file << ",Dropped\n";
+
+  double firstStartTime = this->NumberOfFrames > 0 ? this->GetFrame(0).StartTime : 0.0;
+  for (int frameIndex = 0; frameIndex < this->NumberOfFrames; ++frameIndex)
+  {
+    const FrameRecord& frame = this->GetFrame(frameIndex);
+    // Start time is relative to the oldest frame, durations are in milliseconds
+    file << frameIndex << "," << (frame.StartTime - firstStartTime);
+    for (int phase = 0; phase < Phase_Last; phase++)
+    {
+      file << "," << frame.PhaseDurations[phase] * 1000.0;
+    }
+    file << "," << (frame.Dropped ? 1 : 0) << "\n";
+  }
+
+  return file.good();
+}
@@ -0,0 +1,142 @@
+/*==============================================================================
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#ifndef vtkVirtualRealityFrameTimingLog_h
+#define vtkVirtualRealityFrameTimingLog_h
+
+// VR Logic includes
+#include "vtkSlicerVirtualRealityModuleLogicExport.h"
+
+// VTK includes
+#include <vtkObject.h>
+
+// STD includes
+#include <vector>
+
+/// \brief Fixed-size ring buffer of per-frame phase timings of the virtual reality render loop.
+///
+/// Storage is allocated when the capacity is set, recording a frame does not allocate.
+/// When the buffer is full, the oldest frames are overwritten.
+///
+/// Durations are expressed in seconds.
+class VTK_SLICER_VIRTUALREALITY_MODULE_LOGIC_EXPORT vtkVirtualRealityFrameTimingLog : public vtkObject
+{
+public:
+  static vtkVirtualRealityFrameTimingLog* New();
+  vtkTypeMacro(vtkVirtualRealityFrameTimingLog, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  enum Phases
+  {
+    InteractorEventPhase = 0, ///< Interactor->DoOneEvent(), including rendering
+    MotionCheckPhase,         ///< Detection of quick view motion
+    ControllerPosePhase,      ///< Publishing of controller transforms
+    HMDPosePhase,             ///< Publishing of HMD transform
+    TrackerPosePhase,         ///< Publishing of generic tracker transforms
+    RenderPhase,              ///< Rendering of the scene for all eyes, part of InteractorEventPhase
+    TotalPhase,               ///< Complete frame
+    Phase_Last                // must be last
+  };
+
+  static const char* GetPhaseAsString(int phase);
+  static int GetPhaseFromString(const char* name);
+
+  ///@{
+  /// Maximum number of frames kept in the log. Setting the capacity clears the log.
+  /// Default is 1024.
+  void SetCapacity(int capacity);
+  int GetCapacity() const;
+  ///}@
+
+  /// Remove all recorded frames.
+  void Clear();
+
+  ///@{
+  /// Record a frame. Phases that are not started during the frame have a zero duration.
+  /// The total frame duration is measured between StartFrame() and EndFrame().
+  /// vtkCommand::StartEvent is invoked when a frame is started and vtkCommand::EndEvent
+  /// when it is recorded.
+  void StartFrame();
+  void StartPhase(int phase);
+  void EndPhase(int phase);
+  void EndFrame(bool dropped);
+  ///@}
+
+  /// Get duration of a phase in the frame being recorded, accumulated since the frame was started.
+  double GetCurrentPhaseDuration(int phase) const;
+
+  /// Number of frames currently stored in the log.
+  int GetNumberOfFrames() const;
+
+  /// Number of frames recorded since the log was last cleared, including overwritten ones.
+  vtkGetMacro(NumberOfRecordedFrames, vtkTypeInt64);
+
+  /// Get phase duration of the i-th stored frame (0 is the oldest).
+  double GetPhaseDuration(int frameIndex, int phase) const;
+
+  /// Get start time of the i-th stored frame (0 is the oldest).
+  double GetFrameStartTime(int frameIndex) const;
+
+  /// Return true if the i-th stored frame (0 is the oldest) was dropped.
+  bool GetFrameDropped(int frameIndex) const;
+
+  /// Get percentile (in the range [0, 100]) of a phase duration over the stored frames.
+  /// Returns 0 if no frames are stored.
+  double GetPhaseDurationPercentile(int phase, double percentile) const;
+
+  /// Get mean of a phase duration over the stored frames.
+  double GetPhaseDurationMean(int phase) const;
+
+  /// Get maximum of a phase duration over the stored frames.
+  double GetPhaseDurationMaximum(int phase) const;
+
+  /// Number of dropped frames among the stored frames.
+  int GetNumberOfDroppedFrames() const;
+
+  /// Write stored frames to a CSV file, one row per frame with durations in milliseconds.
+  /// Returns false if the file cannot be written.
+  bool WriteCSV(const char* fileName) const;
+
+protected:
+  vtkVirtualRealityFrameTimingLog();
+  ~vtkVirtualRealityFrameTimingLog() override;
+
+  struct FrameRecord
+  {
+    double StartTime{0.0};
+    double PhaseDurations[Phase_Last]{};
+    bool Dropped{false};
+  };
+
+  /// Get the i-th stored frame (0 is the oldest).
+  const FrameRecord& GetFrame(int frameIndex) const;
+
+  std::vector<FrameRecord> Frames;
+  int NextFrameIndex{0};
+  int NumberOfFrames{0};
+  vtkTypeInt64 NumberOfRecordedFrames{0};
+
+  FrameRecord CurrentFrame;
+  double CurrentPhaseStartTimes[Phase_Last]{};
+
+  /// Scratch buffer used for computing percentiles, allocated along with the frames.
+  mutable std::vector<double> SortedDurations;
+
+private:
+  vtkVirtualRealityFrameTimingLog(const vtkVirtualRealityFrameTimingLog&) = delete;
+  void operator=(const vtkVirtualRealityFrameTimingLog&) = delete;
+};
+
+#endif
@@ -0,0 +1,201 @@
+/*==============================================================================
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// VR Logic includes
+#include "vtkVirtualRealityInputEventQueue.h"
+
+// VTK includes
+#include <vtkCommand.h>
+#include <vtkEventData.h>
+#include <vtkObjectFactory.h>
+
+// STD includes
+#include <cstring>
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkVirtualRealityInputEventQueue);
+
+//----------------------------------------------------------------------------
+vtkVirtualRealityInputEventQueue::vtkVirtualRealityInputEventQueue()
+{
+  this->SetCapacity(256);
+}
+
+//----------------------------------------------------------------------------
+vtkVirtualRealityInputEventQueue::~vtkVirtualRealityInputEventQueue() = default;
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityInputEventQueue::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Capacity: " << this->GetCapacity() << "\n";
+  os << indent << "NumberOfEvents: " << this->GetNumberOfEvents() << "\n";
+  os << indent << "NumberOfOverflows: " << this->GetNumberOfOverflows() << "\n";
+}
+
+//----------------------------------------------------------------------------
+const char* vtkVirtualRealityInputEventQueue::GetEventTypeAsString(int type)
+{
+  switch (type)
+  {
+    case InputEvent::ButtonEventType: return "Button";
+    case InputEvent::AxisEventType: return "Axis";
+    case InputEvent::PoseEventType: return "Pose";
+    default:
+      // invalid id
+      return "";
+  }
+}
+
+//----------------------------------------------------------------------------
+int vtkVirtualRealityInputEventQueue::GetEventTypeFromString(const char* name)
+{
+  if (name == nullptr)
+  {
+    // invalid name
+    return -1;
+  }
+  for (int type = 0; type < InputEvent::EventType_Last; type++)
+  {
+    if (strcmp(name, vtkVirtualRealityInputEventQueue::GetEventTypeAsString(type)) == 0)
+    {
+      // found a matching name
+      return type;
+    }
+  }
+  // unknown name
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityInputEventQueue::SetCapacity(int capacity)
+{
+  if (capacity < 1)
+  {
+    vtkErrorMacro("SetCapacity failed: capacity must be positive");
+    return;
+  }
+  std::size_t roundedCapacity = 1;
+  while (roundedCapacity < static_cast<std::size_t>(capacity))
+  {
+    roundedCapacity *= 2;
+  }
+  this->Events.assign(roundedCapacity, InputEvent());
+  this->IndexMask = roundedCapacity - 1;
+  this->Clear();
+}
+
+//----------------------------------------------------------------------------
+int vtkVirtualRealityInputEventQueue::GetCapacity() const
+{
+  return static_cast<int>(this->Events.size());
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityInputEventQueue::Clear()
+{
+  this->ReadIndex = 0;
+  this->WriteIndex = 0;
+  this->NumberOfOverflows = 0;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+bool vtkVirtualRealityInputEventQueue::Push(const InputEvent& event)
+{
+  std::size_t writeIndex = this->WriteIndex.load(std::memory_order_relaxed);
+  // Acquire, so that the consumer is done reading the slot before it is overwritten
+  if (writeIndex - this->ReadIndex.load(std::memory_order_acquire) >= this->Events.size())
+  {
+    this->NumberOfOverflows.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  this->Events[writeIndex & this->IndexMask] = event;
+  // Release, so that the event is visible to the consumer along with the index
+  this->WriteIndex.store(writeIndex + 1, std::memory_order_release);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkVirtualRealityInputEventQueue::PushEvent(unsigned long eventId, vtkEventDataDevice3D* eventData, double time)
+{
+  if (eventData == nullptr)
+  {
+    return false;
+  }
+  InputEvent event;
+  event.EventId = eventId;
+  event.Device = static_cast<int>(eventData->GetDevice());
+  event.Input = static_cast<int>(eventData->GetInput());
+  event.Action = static_cast<int>(eventData->GetAction());
+  event.Time = time;
+  if (eventId == vtkCommand::Move3DEvent)
+  {
+    event.Type = InputEvent::PoseEventType;
+    eventData->GetWorldPosition(event.Values);
+    eventData->GetWorldOrientation(event.Values + 3);
+  }
+  else
+  {
+    event.Type = (eventId == vtkCommand::ViewerMovement3DEvent || eventId == vtkCommand::Elevation3DEvent)
+      ? InputEvent::AxisEventType : InputEvent::ButtonEventType;
+    eventData->GetTrackPadPosition(event.Values);
+  }
+  return this->Push(event);
+}
+
+//----------------------------------------------------------------------------
+bool vtkVirtualRealityInputEventQueue::Pop(InputEvent& event)
+{
+  std::size_t readIndex = this->ReadIndex.load(std::memory_order_relaxed);
+  if (readIndex == this->WriteIndex.load(std::memory_order_acquire))
+  {
+    return false;
+  }
+  event = this->Events[readIndex & this->IndexMask];
+  this->ReadIndex.store(readIndex + 1, std::memory_order_release);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+int vtkVirtualRealityInputEventQueue::PopEvents(std::vector<InputEvent>& events, int maximumNumberOfEvents)
+{
+  std::size_t readIndex = this->ReadIndex.load(std::memory_order_relaxed);
+  std::size_t numberOfEvents = this->WriteIndex.load(std::memory_order_acquire) - readIndex;
+  if (maximumNumberOfEvents >= 0 && numberOfEvents > static_cast<std::size_t>(maximumNumberOfEvents))
+  {
+    numberOfEvents = static_cast<std::size_t>(maximumNumberOfEvents);
+  }
+  for (std::size_t index = 0; index < numberOfEvents; ++index)
+  {
+    events.push_back(this->Events[(readIndex + index) & this->IndexMask]);
+  }
+  // Release all the slots at once
+  this->ReadIndex.store(readIndex + numberOfEvents, std::memory_order_release);
+  return static_cast<int>(numberOfEvents);
+}
+
+//----------------------------------------------------------------------------
+int vtkVirtualRealityInputEventQueue::GetNumberOfEvents() const
+{
+  std::size_t readIndex = this->ReadIndex.load(std::memory_order_acquire);
+  return static_cast<int>(this->WriteIndex.load(std::memory_order_acquire) - readIndex);
+}
+
+//----------------------------------------------------------------------------
+vtkTypeInt64 vtkVirtualRealityInputEventQueue::GetNumberOfOverflows() const
+{
+  return this->NumberOfOverflows.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,136 @@
+/*==============================================================================
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#ifndef vtkVirtualRealityInputEventQueue_h
+#define vtkVirtualRealityInputEventQueue_h
+
+// VR Logic includes
+#include "vtkSlicerVirtualRealityModuleLogicExport.h"
+
+// VTK includes
+#include <vtkObject.h>
+
+// STD includes
+#include <atomic>
+#include <vector>
+
+class vtkEventDataDevice3D;
+
+/// \brief Lock-free single-producer/single-consumer ring of controller input events.
+///
+/// The virtual reality render loop pushes the input events received while processing a frame,
+/// and consumers pop them at their own cadence, possibly in batches, so that handling the
+/// input is not done while the frame is processed. Consumers running on the thread of the
+/// render loop should stop popping when the next frame is due.
+///
+/// Button, axis and pose events can be stored. qMRMLVirtualRealityView only pushes button
+/// events, axis and pose events are available for other producers.
+///
+/// Push methods must only be called from one thread (producer) and Pop methods from one
+/// thread (consumer), which may be different. Other methods must not be called while the
+/// queue is in use by another thread.
+///
+/// Storage is allocated when the capacity is set, pushing and popping events does not allocate.
+/// When the queue is full, new events are dropped and counted as overflows.
+class VTK_SLICER_VIRTUALREALITY_MODULE_LOGIC_EXPORT vtkVirtualRealityInputEventQueue : public vtkObject
+{
+public:
+  static vtkVirtualRealityInputEventQueue* New();
+  vtkTypeMacro(vtkVirtualRealityInputEventQueue, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  struct InputEvent
+  {
+    enum EventTypes
+    {
+      ButtonEventType = 0, ///< Input, Action and Values (track pad position) are set
+      AxisEventType,       ///< Input and Values (axis position) are set
+      PoseEventType,       ///< Values (world position, then world orientation as WXYZ quaternion) are set
+      EventType_Last       // must be last
+    };
+
+    int Type{ButtonEventType};
+    /// VTK event identifier the input event is created from
+    unsigned long EventId{0};
+    /// vtkEventDataDevice
+    int Device{0};
+    /// vtkEventDataDeviceInput
+    int Input{0};
+    /// vtkEventDataAction
+    int Action{0};
+    double Time{0.0};
+    double Values[7]{};
+  };
+
+  static const char* GetEventTypeAsString(int type);
+  static int GetEventTypeFromString(const char* name);
+
+  ///@{
+  /// Maximum number of events in the queue, rounded up to a power of two.
+  /// Setting the capacity clears the queue.
+  /// Default is 256.
+  void SetCapacity(int capacity);
+  int GetCapacity() const;
+  ///}@
+
+  /// Remove all events and reset the overflow count.
+  void Clear();
+
+  ///@{
+  /// Add an event at the end of the queue (producer).
+  /// Returns false if the queue is full, the event is then dropped.
+  bool Push(const InputEvent& event);
+  /// Create the event from the event data of a VTK 3D event. Move3DEvent is a pose event,
+  /// ViewerMovement3DEvent and Elevation3DEvent are axis events, other events are button events.
+  bool PushEvent(unsigned long eventId, vtkEventDataDevice3D* eventData, double time);
+  ///@}
+
+  ///@{
+  /// Remove the event at the front of the queue (consumer).
+  /// Returns false if the queue is empty.
+  bool Pop(InputEvent& event);
+  /// Remove up to maximumNumberOfEvents events (all events if negative) and append them to events.
+  /// Returns the number of removed events.
+  int PopEvents(std::vector<InputEvent>& events, int maximumNumberOfEvents = -1);
+  ///@}
+
+  /// Number of events in the queue. Exact only if called from the producer or consumer thread
+  /// while the other thread is not using the queue.
+  int GetNumberOfEvents() const;
+
+  /// Number of events dropped because the queue was full, since the queue was last cleared.
+  vtkTypeInt64 GetNumberOfOverflows() const;
+
+protected:
+  vtkVirtualRealityInputEventQueue();
+  ~vtkVirtualRealityInputEventQueue() override;
+
+  std::vector<InputEvent> Events;
+  /// Capacity minus one, used for wrapping the indices
+  std::size_t IndexMask{0};
+
+  /// Number of popped events, only written by the consumer
+  std::atomic<std::size_t> ReadIndex{0};
+  /// Number of pushed events, only written by the producer
+  std::atomic<std::size_t> WriteIndex{0};
+  /// Only written by the producer
+  std::atomic<vtkTypeInt64> NumberOfOverflows{0};
+
+private:
+  vtkVirtualRealityInputEventQueue(const vtkVirtualRealityInputEventQueue&) = delete;
+  void operator=(const vtkVirtualRealityInputEventQueue&) = delete;
+};
+
+#endif
@@ -0,0 +1,272 @@
+/*==============================================================================
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#ifndef vtkVirtualRealityMath_h
+#define vtkVirtualRealityMath_h
+
+// VTK includes
+#include <vtkMath.h>
+#include <vtkMatrix4x4.h>
+
+// STD includes
+#include <cmath>
+
+/// \brief Fixed-size matrix and quaternion value types used in the interaction hot path.
+///
+/// Interactions such as grabbing objects or two-handed pinch run at controller event rate.
+/// Unlike vtkMatrix4x4 and vtkTransform, these types are not reference counted and live on
+/// the stack, so the kernels below do not allocate. Conversion to VTK types is only done
+/// where matrices are passed to the render window or to MRML nodes.
+///
+/// Matrix4 uses the row-major element layout of vtkMatrix4x4, conversion is a copy of 16 elements.
+namespace vtkVirtualRealityMath
+{
+
+//----------------------------------------------------------------------------
+struct alignas(32) Matrix4
+{
+  double Elements[16];
+
+  static constexpr Matrix4 Identity()
+  {
+    return Matrix4{ { 1.0, 0.0, 0.0, 0.0,
+                      0.0, 1.0, 0.0, 0.0,
+                      0.0, 0.0, 1.0, 0.0,
+                      0.0, 0.0, 0.0, 1.0 } };
+  }
+
+  static constexpr Matrix4 Translation(double x, double y, double z)
+  {
+    return Matrix4{ { 1.0, 0.0, 0.0, x,
+                      0.0, 1.0, 0.0, y,
+                      0.0, 0.0, 1.0, z,
+                      0.0, 0.0, 0.0, 1.0 } };
+  }
+
+  static constexpr Matrix4 Scaling(double scale)
+  {
+    return Matrix4{ { scale, 0.0, 0.0, 0.0,
+                      0.0, scale, 0.0, 0.0,
+                      0.0, 0.0, scale, 0.0,
+                      0.0, 0.0, 0.0, 1.0 } };
+  }
+
+  static Matrix4 FromVTK(const vtkMatrix4x4* matrix)
+  {
+    Matrix4 result;
+    const double* elements = matrix->GetData();
+    for (int i = 0; i < 16; ++i)
+    {
+      result.Elements[i] = elements[i];
+    }
+    return result;
+  }
+
+  void ToVTK(vtkMatrix4x4* matrix) const
+  {
+    matrix->DeepCopy(this->Elements);
+  }
+
+  constexpr double operator()(int row, int column) const { return this->Elements[4 * row + column]; }
+  double& operator()(int row, int column) { return this->Elements[4 * row + column]; }
+};
+
+//----------------------------------------------------------------------------
+constexpr Matrix4 operator*(const Matrix4& a, const Matrix4& b)
+{
+  Matrix4 c{};
+  for (int row = 0; row < 4; ++row)
+  {
+    for (int column = 0; column < 4; ++column)
+    {
+      c.Elements[4 * row + column] =
+          a.Elements[4 * row + 0] * b.Elements[column]
+        + a.Elements[4 * row + 1] * b.Elements[4 + column]
+        + a.Elements[4 * row + 2] * b.Elements[8 + column]
+        + a.Elements[4 * row + 3] * b.Elements[12 + column];
+    }
+  }
+  return c;
+}
+
+//----------------------------------------------------------------------------
+/// Return false if the matrix is singular, inverse is not modified in this case.
+inline bool Invert(const Matrix4& matrix, Matrix4& inverse)
+{
+  if (vtkMatrix4x4::Determinant(matrix.Elements) == 0.0)
+  {
+    return false;
+  }
+  vtkMatrix4x4::Invert(matrix.Elements, inverse.Elements);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+struct alignas(32) Quaternion
+{
+  double W{1.0};
+  double X{0.0};
+  double Y{0.0};
+  double Z{0.0};
+
+  /// Axis does not need to be normalized. Identity is returned if the axis is null.
+  static Quaternion FromAngleAxis(double angleRadians, double x, double y, double z)
+  {
+    double norm = std::sqrt(x * x + y * y + z * z);
+    if (norm == 0.0)
+    {
+      return Quaternion();
+    }
+    double s = std::sin(0.5 * angleRadians) / norm;
+    return Quaternion{ std::cos(0.5 * angleRadians), s * x, s * y, s * z };
+  }
+
+  constexpr Quaternion Conjugate() const
+  {
+    return Quaternion{ this->W, -this->X, -this->Y, -this->Z };
+  }
+
+  /// Rotation matrix of the normalized quaternion.
+  Matrix4 ToMatrix() const
+  {
+    double norm2 = this->W * this->W + this->X * this->X + this->Y * this->Y + this->Z * this->Z;
+    if (norm2 == 0.0)
+    {
+      return Matrix4::Identity();
+    }
+    double s = 2.0 / norm2;
+    double wx = s * this->W * this->X, wy = s * this->W * this->Y, wz = s * this->W * this->Z;
+    double xx = s * this->X * this->X, xy = s * this->X * this->Y, xz = s * this->X * this->Z;
+    double yy = s * this->Y * this->Y, yz = s * this->Y * this->Z, zz = s * this->Z * this->Z;
+    return Matrix4{ { 1.0 - (yy + zz), xy - wz, xz + wy, 0.0,
+                      xy + wz, 1.0 - (xx + zz), yz - wx, 0.0,
+                      xz - wy, yz + wx, 1.0 - (xx + yy), 0.0,
+                      0.0, 0.0, 0.0, 1.0 } };
+  }
+};
+
+//----------------------------------------------------------------------------
+constexpr Quaternion operator*(const Quaternion& a, const Quaternion& b)
+{
+  return Quaternion{
+    a.W * b.W - a.X * b.X - a.Y * b.Y - a.Z * b.Z,
+    a.W * b.X + a.X * b.W + a.Y * b.Z - a.Z * b.Y,
+    a.W * b.Y - a.X * b.Z + a.Y * b.W + a.Z * b.X,
+    a.W * b.Z + a.X * b.Y - a.Y * b.X + a.Z * b.W };
+}
+
+//----------------------------------------------------------------------------
+// Interaction kernels
+//----------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------
+/// Average pose of the two controllers for pinch 3D operations.
+/// \sa vtkSlicerVirtualRealityLogic::CalculateCombinedControllerPose()
+inline bool CombinedControllerPose(const Matrix4& controller0Pose, const Matrix4& controller1Pose, Matrix4& combinedPose)
+{
+  // X axis is the displacement vector from controller 0 to 1, its length is the scaling
+  double xAxis[3] = {
+    controller1Pose(0, 3) - controller0Pose(0, 3),
+    controller1Pose(1, 3) - controller0Pose(1, 3),
+    controller1Pose(2, 3) - controller0Pose(2, 3) };
+  double controllerDistance = vtkMath::Normalize(xAxis);
+
+  // Y' is the average orientation of the two controller directions
+  double yAxisPrime[3] = {
+    controller0Pose(0, 1) + controller1Pose(0, 1),
+    controller0Pose(1, 1) + controller1Pose(1, 1),
+    controller0Pose(2, 1) + controller1Pose(2, 1) };
+  vtkMath::Normalize(yAxisPrime);
+
+  if (std::fabs(vtkMath::Dot(xAxis, yAxisPrime)) > 0.99)
+  {
+    // The two axes are almost parallel
+    return false;
+  }
+
+  double zAxis[3] = { 0.0, 0.0, 0.0 };
+  vtkMath::Cross(xAxis, yAxisPrime, zAxis);
+  vtkMath::Normalize(zAxis);
+
+  double yAxis[3] = { 0.0, 0.0, 0.0 };
+  vtkMath::Cross(zAxis, xAxis, yAxis);
+  vtkMath::Normalize(yAxis);
+
+  for (int row = 0; row < 3; ++row)
+  {
+    combinedPose(row, 0) = xAxis[row] * controllerDistance;
+    combinedPose(row, 1) = yAxis[row] * controllerDistance;
+    combinedPose(row, 2) = zAxis[row] * controllerDistance;
+    combinedPose(row, 3) = (controller0Pose(row, 3) + controller1Pose(row, 3)) / 2.0;
+  }
+  combinedPose(3, 0) = 0.0;
+  combinedPose(3, 1) = 0.0;
+  combinedPose(3, 2) = 0.0;
+  combinedPose(3, 3) = 1.0;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+/// Physical-to-world matrix following the combined controller pose since the start of a pinch 3D gesture.
+/// Starting physical-to-world matrix is returned if the current combined pose is singular.
+/// \sa vtkSlicerVirtualRealityLogic::ComputePinch3DPhysicalToWorldMatrix()
+inline Matrix4 Pinch3DPhysicalToWorld(const Matrix4& startingPhysicalToWorld,
+  const Matrix4& combinedStartingControllerPose, const Matrix4& combinedCurrentControllerPose)
+{
+  Matrix4 inverseCombinedCurrentControllerPose;
+  if (!Invert(combinedCurrentControllerPose, inverseCombinedCurrentControllerPose))
+  {
+    return startingPhysicalToWorld;
+  }
+  return startingPhysicalToWorld * (combinedStartingControllerPose * inverseCombinedCurrentControllerPose);
+}
+
+//----------------------------------------------------------------------------
+/// Physical-to-world matrix scaling the world by scaleFactor around a focus point in world coordinates.
+/// \sa vtkSlicerVirtualRealityLogic::ComputeScaledPhysicalToWorldMatrix()
+constexpr Matrix4 ScaledPhysicalToWorld(const Matrix4& physicalToWorld, const double focusPoint_World[3], double scaleFactor)
+{
+  // Translate focus point to origin, scale, translate back
+  return Matrix4{ { scaleFactor, 0.0, 0.0, (1.0 - scaleFactor) * focusPoint_World[0],
+                    0.0, scaleFactor, 0.0, (1.0 - scaleFactor) * focusPoint_World[1],
+                    0.0, 0.0, scaleFactor, (1.0 - scaleFactor) * focusPoint_World[2],
+                    0.0, 0.0, 0.0, 1.0 } } * physicalToWorld;
+}
+
+//----------------------------------------------------------------------------
+/// Incremental transform of a grabbed object between two controller poses.
+/// Orientations are (angle in degrees, axis) as returned by vtkRenderWindowInteractor3D.
+/// The object is rotated around the current controller position, then translated by the
+/// controller displacement.
+inline Matrix4 GrabInteractionTransform(const double worldPosition[3], const double lastWorldPosition[3],
+  const double worldOrientation[4], const double lastWorldOrientation[4])
+{
+  Quaternion lastRotation = Quaternion::FromAngleAxis(vtkMath::RadiansFromDegrees(lastWorldOrientation[0]),
+    lastWorldOrientation[1], lastWorldOrientation[2], lastWorldOrientation[3]);
+  Quaternion rotation = Quaternion::FromAngleAxis(vtkMath::RadiansFromDegrees(worldOrientation[0]),
+    worldOrientation[1], worldOrientation[2], worldOrientation[3]);
+  Matrix4 rotationMatrix = (rotation * lastRotation.Conjugate()).ToMatrix();
+
+  return Matrix4::Translation(worldPosition[0], worldPosition[1], worldPosition[2])
+    * rotationMatrix
+    * Matrix4::Translation(-worldPosition[0], -worldPosition[1], -worldPosition[2])
+    * Matrix4::Translation(worldPosition[0] - lastWorldPosition[0],
+                           worldPosition[1] - lastWorldPosition[1],
+                           worldPosition[2] - lastWorldPosition[2]);
+}
+
+} // namespace vtkVirtualRealityMath
+
+#endif
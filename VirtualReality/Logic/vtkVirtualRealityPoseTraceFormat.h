@@ -0,0 +1,78 @@
+/*==============================================================================
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#ifndef vtkVirtualRealityPoseTraceFormat_h
+#define vtkVirtualRealityPoseTraceFormat_h
+
+// VTK includes
+#include <vtkType.h>
+
+/// \file
+/// Binary layout of the pose trace files written by vtkVirtualRealityPoseTraceWriter
+/// and read by vtkVirtualRealityPoseTraceReader.
+///
+/// A trace file is a vtkVirtualRealityPoseTraceFileHeader followed by fixed-size
+/// vtkVirtualRealityPoseTraceRecord entries, in native byte order. Since all records have
+/// the same size and alignment, the file may be memory-mapped and indexed directly.
+///
+/// Each frame starts with a FrameRecordType record, followed by the records of that frame:
+/// input events received while processing the frame, then device poses and the
+/// physical-to-world matrix at the end of the frame.
+
+/// Identifies pose trace files.
+#define vtkVirtualRealityPoseTraceMagic "SVRPOSE"
+
+/// Version of the layout, increment when changing the structures below.
+#define vtkVirtualRealityPoseTraceVersion 1
+
+/// Used to detect files written on a platform with a different byte order.
+#define vtkVirtualRealityPoseTraceByteOrderMark 0x01020304u
+
+struct vtkVirtualRealityPoseTraceFileHeader
+{
+  char Magic[8];
+  vtkTypeUInt32 Version;
+  vtkTypeUInt32 RecordSize;
+  vtkTypeUInt32 ByteOrderMark;
+  vtkTypeUInt32 Reserved;
+};
+
+struct vtkVirtualRealityPoseTraceRecord
+{
+  enum RecordTypes
+  {
+    FrameRecordType = 0,      ///< Start of a frame, Time is set
+    DevicePoseRecordType,     ///< DeviceHandle, Device and Values (device-to-physical matrix) are set
+    PhysicalToWorldRecordType,///< Values (physical-to-world matrix) are set
+    EventRecordType,          ///< EventId, Device, Input, Action and Values (track pad position) are set
+    RecordType_Last           // must be last
+  };
+
+  vtkTypeUInt32 Type;
+  vtkTypeUInt32 DeviceHandle;
+  vtkTypeInt32 Device;
+  vtkTypeInt32 Input;
+  vtkTypeInt32 Action;
+  vtkTypeUInt32 EventId;
+  double Time;
+  /// First three rows of a 4x4 affine matrix in row-major order, or the
+  /// track pad position in the first two values for events.
+  double Values[12];
+};
+
+static_assert(sizeof(vtkVirtualRealityPoseTraceFileHeader) == 24, "Unexpected pose trace file header size");
+static_assert(sizeof(vtkVirtualRealityPoseTraceRecord) == 128, "Unexpected pose trace record size");
+
+#endif
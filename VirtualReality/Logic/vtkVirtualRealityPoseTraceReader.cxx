@@ -0,0 +1,173 @@
+/*==============================================================================
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// VR Logic includes
+#include "vtkVirtualRealityPoseTraceReader.h"
+
+// VTK includes
+#include <vtkMatrix4x4.h>
+#include <vtkObjectFactory.h>
+
+// STD includes
+#include <cstdio>
+#include <cstring>
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkVirtualRealityPoseTraceReader);
+
+//----------------------------------------------------------------------------
+vtkVirtualRealityPoseTraceReader::vtkVirtualRealityPoseTraceReader() = default;
+
+//----------------------------------------------------------------------------
+vtkVirtualRealityPoseTraceReader::~vtkVirtualRealityPoseTraceReader() = default;
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityPoseTraceReader::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfRecords: " << this->Records.size() << "\n";
+  os << indent << "NumberOfFrames: " << this->GetNumberOfFrames() << "\n";
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityPoseTraceReader::Clear()
+{
+  this->Records.clear();
+  this->FrameRecordIndices.clear();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+bool vtkVirtualRealityPoseTraceReader::Read(const char* fileName)
+{
+  this->Clear();
+  if (fileName == nullptr)
+  {
+    vtkErrorMacro("Read failed: invalid file name");
+    return false;
+  }
+  std::FILE* file = std::fopen(fileName, "rb");
+  if (file == nullptr)
+  {
+    vtkErrorMacro("Read failed: unable to open file " << fileName);
+    return false;
+  }
+
+  vtkVirtualRealityPoseTraceFileHeader header;
+  if (std::fread(&header, sizeof(header), 1, file) != 1
+      || std::strncmp(header.Magic, vtkVirtualRealityPoseTraceMagic, sizeof(header.Magic)) != 0)
+  {
+    vtkErrorMacro("Read failed: " << fileName << " is not a pose trace file");
+    std::fclose(file);
+    return false;
+  }
+  if (header.ByteOrderMark != vtkVirtualRealityPoseTraceByteOrderMark
+      || header.Version != vtkVirtualRealityPoseTraceVersion
+      || header.RecordSize != sizeof(vtkVirtualRealityPoseTraceRecord))
+  {
+    vtkErrorMacro("Read failed: unsupported pose trace version " << header.Version
+                  << " or byte order in file " << fileName);
+    std::fclose(file);
+    return false;
+  }
+
+  // Records are read by chunks until the end of file, a truncated last record is ignored
+  const size_t chunkSize = 4096;
+  size_t numberOfRecords = 0;
+  size_t numberOfReadRecords = 0;
+  do
+  {
+    this->Records.resize(numberOfRecords + chunkSize);
+    numberOfReadRecords = std::fread(&this->Records[numberOfRecords], sizeof(vtkVirtualRealityPoseTraceRecord),
+                                     chunkSize, file);
+    numberOfRecords += numberOfReadRecords;
+  }
+  while (numberOfReadRecords == chunkSize);
+  this->Records.resize(numberOfRecords);
+  std::fclose(file);
+
+  for (size_t recordIndex = 0; recordIndex < this->Records.size(); ++recordIndex)
+  {
+    const vtkVirtualRealityPoseTraceRecord& record = this->Records[recordIndex];
+    if (record.Type >= vtkVirtualRealityPoseTraceRecord::RecordType_Last)
+    {
+      vtkErrorMacro("Read failed: invalid record type " << record.Type << " in file " << fileName);
+      this->Clear();
+      return false;
+    }
+    if (record.Type == vtkVirtualRealityPoseTraceRecord::FrameRecordType)
+    {
+      this->FrameRecordIndices.push_back(static_cast<int>(recordIndex));
+    }
+  }
+  this->Modified();
+  return true;
+}
+
+//----------------------------------------------------------------------------
+int vtkVirtualRealityPoseTraceReader::GetNumberOfFrames() const
+{
+  return static_cast<int>(this->FrameRecordIndices.size());
+}
+
+//----------------------------------------------------------------------------
+double vtkVirtualRealityPoseTraceReader::GetFrameTime(int frameIndex) const
+{
+  if (frameIndex < 0 || frameIndex >= this->GetNumberOfFrames())
+  {
+    vtkErrorMacro("GetFrameTime failed: invalid frame index " << frameIndex);
+    return 0.0;
+  }
+  return this->Records[this->FrameRecordIndices[frameIndex]].Time;
+}
+
+//----------------------------------------------------------------------------
+int vtkVirtualRealityPoseTraceReader::GetNumberOfFrameRecords(int frameIndex) const
+{
+  if (frameIndex < 0 || frameIndex >= this->GetNumberOfFrames())
+  {
+    vtkErrorMacro("GetNumberOfFrameRecords failed: invalid frame index " << frameIndex);
+    return 0;
+  }
+  int nextFrameRecordIndex = (frameIndex + 1 < this->GetNumberOfFrames())
+    ? this->FrameRecordIndices[frameIndex + 1] : static_cast<int>(this->Records.size());
+  return nextFrameRecordIndex - this->FrameRecordIndices[frameIndex] - 1;
+}
+
+//----------------------------------------------------------------------------
+const vtkVirtualRealityPoseTraceRecord* vtkVirtualRealityPoseTraceReader::GetFrameRecord(int frameIndex, int recordIndex) const
+{
+  if (recordIndex < 0 || recordIndex >= this->GetNumberOfFrameRecords(frameIndex))
+  {
+    return nullptr;
+  }
+  return &this->Records[this->FrameRecordIndices[frameIndex] + 1 + recordIndex];
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityPoseTraceReader::GetRecordMatrix(const vtkVirtualRealityPoseTraceRecord* record, vtkMatrix4x4* matrix)
+{
+  if (record == nullptr || matrix == nullptr)
+  {
+    return;
+  }
+  double* elements = matrix->GetData();
+  std::memcpy(elements, record->Values, sizeof(record->Values));
+  elements[12] = 0.0;
+  elements[13] = 0.0;
+  elements[14] = 0.0;
+  elements[15] = 1.0;
+  matrix->Modified();
+}
@@ -0,0 +1,78 @@
+/*==============================================================================
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#ifndef vtkVirtualRealityPoseTraceReader_h
+#define vtkVirtualRealityPoseTraceReader_h
+
+// VR Logic includes
+#include "vtkSlicerVirtualRealityModuleLogicExport.h"
+#include "vtkVirtualRealityPoseTraceFormat.h"
+
+// VTK includes
+#include <vtkObject.h>
+
+// STD includes
+#include <vector>
+
+class vtkMatrix4x4;
+
+/// \brief Read a binary trace file written by vtkVirtualRealityPoseTraceWriter.
+///
+/// The whole file is loaded in memory and indexed by frame.
+///
+/// \sa vtkVirtualRealityPoseTraceFormat.h
+class VTK_SLICER_VIRTUALREALITY_MODULE_LOGIC_EXPORT vtkVirtualRealityPoseTraceReader : public vtkObject
+{
+public:
+  static vtkVirtualRealityPoseTraceReader* New();
+  vtkTypeMacro(vtkVirtualRealityPoseTraceReader, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /// Load a trace file. Returns false if the file cannot be read or is not a valid trace.
+  bool Read(const char* fileName);
+
+  /// Remove all loaded records.
+  void Clear();
+
+  /// Number of frames in the loaded trace.
+  int GetNumberOfFrames() const;
+
+  /// Time at which the frame was recorded, in seconds.
+  double GetFrameTime(int frameIndex) const;
+
+  /// Number of records of a frame, not including the frame record itself.
+  int GetNumberOfFrameRecords(int frameIndex) const;
+
+  /// Get the n-th record of a frame (not including the frame record itself).
+  /// Returns nullptr if indices are out of range.
+  const vtkVirtualRealityPoseTraceRecord* GetFrameRecord(int frameIndex, int recordIndex) const;
+
+  /// Set the matrix stored in a device pose or physical-to-world record.
+  static void GetRecordMatrix(const vtkVirtualRealityPoseTraceRecord* record, vtkMatrix4x4* matrix);
+
+protected:
+  vtkVirtualRealityPoseTraceReader();
+  ~vtkVirtualRealityPoseTraceReader() override;
+
+  std::vector<vtkVirtualRealityPoseTraceRecord> Records;
+  /// Index of the frame record of each frame in Records
+  std::vector<int> FrameRecordIndices;
+
+private:
+  vtkVirtualRealityPoseTraceReader(const vtkVirtualRealityPoseTraceReader&) = delete;
+  void operator=(const vtkVirtualRealityPoseTraceReader&) = delete;
+};
+
+#endif
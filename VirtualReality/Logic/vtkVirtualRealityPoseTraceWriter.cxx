@@ -0,0 +1,292 @@
+/*==============================================================================
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// VR Logic includes
+#include "vtkVirtualRealityPoseTraceWriter.h"
+
+// VTK includes
+#include <vtkMatrix4x4.h>
+#include <vtkObjectFactory.h>
+
+// STD includes
+#include <cstring>
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkVirtualRealityPoseTraceWriter);
+
+//----------------------------------------------------------------------------
+vtkVirtualRealityPoseTraceWriter::vtkVirtualRealityPoseTraceWriter() = default;
+
+//----------------------------------------------------------------------------
+vtkVirtualRealityPoseTraceWriter::~vtkVirtualRealityPoseTraceWriter()
+{
+  this->Close();
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityPoseTraceWriter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "BufferSize: " << this->BufferSize << "\n";
+  os << indent << "Open: " << this->IsOpen() << "\n";
+  os << indent << "NumberOfFrames: " << this->NumberOfFrames << "\n";
+}
+
+//----------------------------------------------------------------------------
+bool vtkVirtualRealityPoseTraceWriter::Open(const char* fileName)
+{
+  this->Close();
+  if (fileName == nullptr)
+  {
+    vtkErrorMacro("Open failed: invalid file name");
+    return false;
+  }
+  this->File = std::fopen(fileName, "wb");
+  if (this->File == nullptr)
+  {
+    vtkErrorMacro("Open failed: unable to create file " << fileName);
+    return false;
+  }
+
+  vtkVirtualRealityPoseTraceFileHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::strncpy(header.Magic, vtkVirtualRealityPoseTraceMagic, sizeof(header.Magic));
+  header.Version = vtkVirtualRealityPoseTraceVersion;
+  header.RecordSize = sizeof(vtkVirtualRealityPoseTraceRecord);
+  header.ByteOrderMark = vtkVirtualRealityPoseTraceByteOrderMark;
+  if (std::fwrite(&header, sizeof(header), 1, this->File) != 1)
+  {
+    vtkErrorMacro("Open failed: unable to write header to file " << fileName);
+    std::fclose(this->File);
+    this->File = nullptr;
+    return false;
+  }
+
+  this->Buffer.resize(this->BufferSize);
+  this->WriteBuffer.resize(this->BufferSize);
+  this->NumberOfBufferedRecords = 0;
+  this->NumberOfRecordsToWrite = 0;
+  this->NumberOfFrames = 0;
+  this->WriteRequested = false;
+  this->WriteFailed = false;
+  this->StopWriting = false;
+  this->WritingThread = std::thread(&vtkVirtualRealityPoseTraceWriter::WriteRecords, this);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityPoseTraceWriter::Close()
+{
+  if (this->File == nullptr)
+  {
+    return;
+  }
+  this->Flush();
+  if (this->File != nullptr)
+  {
+    this->CloseFile();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityPoseTraceWriter::CloseFile()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->WriteMutex);
+    this->StopWriting = true;
+  }
+  this->WriteCondition.notify_all();
+  if (this->WritingThread.joinable())
+  {
+    this->WritingThread.join();
+  }
+  std::fclose(this->File);
+  this->File = nullptr;
+  this->NumberOfBufferedRecords = 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityPoseTraceWriter::WriteRecords()
+{
+  std::unique_lock<std::mutex> lock(this->WriteMutex);
+  while (true)
+  {
+    this->WriteCondition.wait(lock, [this]() { return this->WriteRequested || this->StopWriting; });
+    if (!this->WriteRequested)
+    {
+      // Stopped, all submitted records are written
+      return;
+    }
+    // Buffer is not accessed by the main thread until the write is completed
+    lock.unlock();
+    size_t written = std::fwrite(this->WriteBuffer.data(), sizeof(vtkVirtualRealityPoseTraceRecord),
+                                 this->NumberOfRecordsToWrite, this->File);
+    lock.lock();
+    if (written != this->NumberOfRecordsToWrite)
+    {
+      this->WriteFailed = true;
+    }
+    this->WriteRequested = false;
+    this->WriteCondition.notify_all();
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkVirtualRealityPoseTraceWriter::WaitForWrite()
+{
+  std::unique_lock<std::mutex> lock(this->WriteMutex);
+  this->WriteCondition.wait(lock, [this]() { return !this->WriteRequested; });
+  return !this->WriteFailed;
+}
+
+//----------------------------------------------------------------------------
+bool vtkVirtualRealityPoseTraceWriter::SubmitBuffer()
+{
+  // Previous records must be written before the buffers are swapped, this only waits
+  // if the file is written more slowly than records are recorded
+  if (!this->WaitForWrite())
+  {
+    vtkErrorMacro("SubmitBuffer failed: unable to write records, recording is stopped");
+    this->CloseFile();
+    return false;
+  }
+  if (this->NumberOfBufferedRecords == 0)
+  {
+    return true;
+  }
+  {
+    std::lock_guard<std::mutex> lock(this->WriteMutex);
+    this->Buffer.swap(this->WriteBuffer);
+    this->NumberOfRecordsToWrite = this->NumberOfBufferedRecords;
+    this->WriteRequested = true;
+  }
+  this->WriteCondition.notify_all();
+  this->NumberOfBufferedRecords = 0;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkVirtualRealityPoseTraceWriter::IsOpen() const
+{
+  return this->File != nullptr;
+}
+
+//----------------------------------------------------------------------------
+bool vtkVirtualRealityPoseTraceWriter::Flush()
+{
+  if (this->File == nullptr)
+  {
+    return false;
+  }
+  if (!this->SubmitBuffer())
+  {
+    return false;
+  }
+  if (!this->WaitForWrite())
+  {
+    vtkErrorMacro("Flush failed: unable to write records, recording is stopped");
+    this->CloseFile();
+    return false;
+  }
+  return std::fflush(this->File) == 0;
+}
+
+//----------------------------------------------------------------------------
+vtkVirtualRealityPoseTraceRecord* vtkVirtualRealityPoseTraceWriter::AppendRecord(vtkTypeUInt32 type)
+{
+  if (this->File == nullptr)
+  {
+    return nullptr;
+  }
+  if (this->NumberOfBufferedRecords == this->Buffer.size() && !this->SubmitBuffer())
+  {
+    return nullptr;
+  }
+  vtkVirtualRealityPoseTraceRecord* record = &this->Buffer[this->NumberOfBufferedRecords++];
+  std::memset(record, 0, sizeof(vtkVirtualRealityPoseTraceRecord));
+  record->Type = type;
+  return record;
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityPoseTraceWriter::SetRecordMatrix(vtkVirtualRealityPoseTraceRecord* record, vtkMatrix4x4* matrix)
+{
+  // Last row of affine matrices is (0, 0, 0, 1), it is not stored
+  std::memcpy(record->Values, matrix->GetData(), sizeof(record->Values));
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityPoseTraceWriter::WriteFrame(double time)
+{
+  vtkVirtualRealityPoseTraceRecord* record = this->AppendRecord(vtkVirtualRealityPoseTraceRecord::FrameRecordType);
+  if (record == nullptr)
+  {
+    return;
+  }
+  record->Time = time;
+  this->NumberOfFrames++;
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityPoseTraceWriter::WriteDevicePose(
+  vtkTypeUInt32 deviceHandle, vtkEventDataDevice device, vtkMatrix4x4* deviceToPhysicalMatrix)
+{
+  if (deviceToPhysicalMatrix == nullptr)
+  {
+    return;
+  }
+  vtkVirtualRealityPoseTraceRecord* record = this->AppendRecord(vtkVirtualRealityPoseTraceRecord::DevicePoseRecordType);
+  if (record == nullptr)
+  {
+    return;
+  }
+  record->DeviceHandle = deviceHandle;
+  record->Device = static_cast<vtkTypeInt32>(device);
+  vtkVirtualRealityPoseTraceWriter::SetRecordMatrix(record, deviceToPhysicalMatrix);
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityPoseTraceWriter::WritePhysicalToWorldMatrix(vtkMatrix4x4* physicalToWorldMatrix)
+{
+  if (physicalToWorldMatrix == nullptr)
+  {
+    return;
+  }
+  vtkVirtualRealityPoseTraceRecord* record = this->AppendRecord(vtkVirtualRealityPoseTraceRecord::PhysicalToWorldRecordType);
+  if (record == nullptr)
+  {
+    return;
+  }
+  vtkVirtualRealityPoseTraceWriter::SetRecordMatrix(record, physicalToWorldMatrix);
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityPoseTraceWriter::WriteEvent(unsigned long eventId, vtkEventDataDevice3D* eventData)
+{
+  if (eventData == nullptr)
+  {
+    return;
+  }
+  vtkVirtualRealityPoseTraceRecord* record = this->AppendRecord(vtkVirtualRealityPoseTraceRecord::EventRecordType);
+  if (record == nullptr)
+  {
+    return;
+  }
+  record->EventId = static_cast<vtkTypeUInt32>(eventId);
+  record->Device = static_cast<vtkTypeInt32>(eventData->GetDevice());
+  record->Input = static_cast<vtkTypeInt32>(eventData->GetInput());
+  record->Action = static_cast<vtkTypeInt32>(eventData->GetAction());
+  eventData->GetTrackPadPosition(record->Values);
+}
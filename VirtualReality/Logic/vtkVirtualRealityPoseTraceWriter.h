@@ -0,0 +1,127 @@
+/*==============================================================================
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#ifndef vtkVirtualRealityPoseTraceWriter_h
+#define vtkVirtualRealityPoseTraceWriter_h
+
+// VR Logic includes
+#include "vtkSlicerVirtualRealityModuleLogicExport.h"
+#include "vtkVirtualRealityPoseTraceFormat.h"
+
+// VTK includes
+#include <vtkEventData.h>
+#include <vtkObject.h>
+
+// STD includes
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class vtkMatrix4x4;
+
+/// \brief Record device poses and input events of a virtual reality session to a binary trace file.
+///
+/// Records are accumulated in a buffer allocated when the file is opened, recording a frame
+/// does not allocate. When the buffer is full, it is swapped with a second buffer of the same
+/// size and its records are written to the file by a background thread, so that the render
+/// loop is not blocked by file writes. Recording only waits for the thread if the previous
+/// buffer is not written yet when the current one gets full.
+///
+/// \sa vtkVirtualRealityPoseTraceFormat.h, vtkVirtualRealityPoseTraceReader
+class VTK_SLICER_VIRTUALREALITY_MODULE_LOGIC_EXPORT vtkVirtualRealityPoseTraceWriter : public vtkObject
+{
+public:
+  static vtkVirtualRealityPoseTraceWriter* New();
+  vtkTypeMacro(vtkVirtualRealityPoseTraceWriter, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /// Number of records kept in memory before being written to the file.
+  /// Takes effect when the file is opened. Default is 4096 (512 KiB).
+  vtkSetClampMacro(BufferSize, int, 1, 1 << 20);
+  vtkGetMacro(BufferSize, int);
+  ///}@
+
+  /// Create the trace file and write its header.
+  /// Returns false if the file cannot be created.
+  bool Open(const char* fileName);
+
+  /// Write buffered records and close the file.
+  void Close();
+
+  /// Return true if a file is open for recording.
+  bool IsOpen() const;
+
+  ///@{
+  /// Append records to the trace. Ignored if no file is open.
+  void WriteFrame(double time);
+  void WriteDevicePose(vtkTypeUInt32 deviceHandle, vtkEventDataDevice device, vtkMatrix4x4* deviceToPhysicalMatrix);
+  void WritePhysicalToWorldMatrix(vtkMatrix4x4* physicalToWorldMatrix);
+  void WriteEvent(unsigned long eventId, vtkEventDataDevice3D* eventData);
+  ///@}
+
+  /// Write buffered records to the file, waiting for them to be written.
+  /// Returns false if writing failed, in which case the file is closed.
+  bool Flush();
+
+  /// Number of frames recorded since the file was opened.
+  vtkGetMacro(NumberOfFrames, vtkTypeInt64);
+
+protected:
+  vtkVirtualRealityPoseTraceWriter();
+  ~vtkVirtualRealityPoseTraceWriter() override;
+
+  /// Return the next free record of the buffer, submitting it for writing if it is full.
+  vtkVirtualRealityPoseTraceRecord* AppendRecord(vtkTypeUInt32 type);
+
+  /// Swap the buffers and let the writing thread write the buffered records.
+  /// Returns false if writing failed, in which case the file is closed.
+  bool SubmitBuffer();
+  /// Wait until the submitted records are written. Returns false if writing failed.
+  bool WaitForWrite();
+  /// Stop the writing thread and close the file.
+  void CloseFile();
+  /// Body of the writing thread.
+  void WriteRecords();
+
+  static void SetRecordMatrix(vtkVirtualRealityPoseTraceRecord* record, vtkMatrix4x4* matrix);
+
+  int BufferSize{4096};
+  std::vector<vtkVirtualRealityPoseTraceRecord> Buffer;
+  size_t NumberOfBufferedRecords{0};
+  std::FILE* File{nullptr};
+
+  ///@{
+  /// Records written by the writing thread, and its state guarded by WriteMutex
+  std::vector<vtkVirtualRealityPoseTraceRecord> WriteBuffer;
+  size_t NumberOfRecordsToWrite{0};
+  std::thread WritingThread;
+  std::mutex WriteMutex;
+  std::condition_variable WriteCondition;
+  bool WriteRequested{false};
+  bool WriteFailed{false};
+  bool StopWriting{false};
+  ///@}
+
+  vtkTypeInt64 NumberOfFrames{0};
+
+private:
+  vtkVirtualRealityPoseTraceWriter(const vtkVirtualRealityPoseTraceWriter&) = delete;
+  void operator=(const vtkVirtualRealityPoseTraceWriter&) = delete;
+};
+
+#endif
@@ -23,7 +23,10 @@ Version:   $Revision: 1.3 $
 #include <vtkObjectFactory.h>
 
 // STD includes
-#include <sstream>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <string>
 
 const char* vtkMRMLVirtualRealityViewNode::ReferenceViewNodeReferenceRole = "ReferenceViewNodeRef";
 const char* vtkMRMLVirtualRealityViewNode::LeftControllerTransformRole = "LeftController";
@@ -76,11 +79,21 @@ void vtkMRMLVirtualRealityViewNode::WriteXML(ostream& of, int nIndent)
   vtkMRMLWriteXMLBooleanMacro(twoSidedLighting, TwoSidedLighting);
   vtkMRMLWriteXMLBooleanMacro(backLights, BackLights);
   vtkMRMLWriteXMLFloatMacro(desiredUpdateRate, DesiredUpdateRate);
+  vtkMRMLWriteXMLBooleanMacro(adaptiveQuality, AdaptiveQuality);
+  vtkMRMLWriteXMLFloatMacro(adaptiveQualityMinimum, AdaptiveQualityMinimum);
+  vtkMRMLWriteXMLFloatMacro(adaptiveQualityMaximum, AdaptiveQualityMaximum);
+  vtkMRMLWriteXMLBooleanMacro(dynamicRenderScale, DynamicRenderScale);
+  vtkMRMLWriteXMLFloatMacro(minimumRenderScale, MinimumRenderScale);
+  vtkMRMLWriteXMLFloatMacro(maximumRenderScale, MaximumRenderScale);
+  vtkMRMLWriteXMLBooleanMacro(warmStandby, WarmStandby);
+  vtkMRMLWriteXMLBooleanMacro(sharedGraphicsResources, SharedGraphicsResources);
+  vtkMRMLWriteXMLBooleanMacro(keepAliveSubmission, KeepAliveSubmission);
   vtkMRMLWriteXMLFloatMacro(magnification, Magnification);
   vtkMRMLWriteXMLFloatMacro(motionSpeed, MotionSpeed);
   vtkMRMLWriteXMLFloatMacro(motionSensitivity, MotionSensitivity);
   vtkMRMLWriteXMLBooleanMacro(controllerTransformsUpdate, ControllerTransformsUpdate);
   vtkMRMLWriteXMLBooleanMacro(hmdTransformUpdate, HMDTransformUpdate);
+  vtkMRMLWriteXMLFloatMacro(poseUpdateTolerance, PoseUpdateTolerance);
   vtkMRMLWriteXMLBooleanMacro(controllerModelsVisible, ControllerModelsVisible);
   vtkMRMLWriteXMLBooleanMacro(lighthouseModelsVisible, LighthouseModelsVisible);
   // OpenXRRemoting
@@ -101,11 +114,21 @@ void vtkMRMLVirtualRealityViewNode::ReadXMLAttributes(const char** atts)
   vtkMRMLReadXMLBooleanMacro(twoSidedLighting, TwoSidedLighting);
   vtkMRMLReadXMLBooleanMacro(backLights, BackLights);
   vtkMRMLReadXMLFloatMacro(desiredUpdateRate, DesiredUpdateRate);
+  vtkMRMLReadXMLBooleanMacro(adaptiveQuality, AdaptiveQuality);
+  vtkMRMLReadXMLFloatMacro(adaptiveQualityMinimum, AdaptiveQualityMinimum);
+  vtkMRMLReadXMLFloatMacro(adaptiveQualityMaximum, AdaptiveQualityMaximum);
+  vtkMRMLReadXMLBooleanMacro(dynamicRenderScale, DynamicRenderScale);
+  vtkMRMLReadXMLFloatMacro(minimumRenderScale, MinimumRenderScale);
+  vtkMRMLReadXMLFloatMacro(maximumRenderScale, MaximumRenderScale);
+  vtkMRMLReadXMLBooleanMacro(warmStandby, WarmStandby);
+  vtkMRMLReadXMLBooleanMacro(sharedGraphicsResources, SharedGraphicsResources);
+  vtkMRMLReadXMLBooleanMacro(keepAliveSubmission, KeepAliveSubmission);
   vtkMRMLReadXMLFloatMacro(magnification, Magnification);
   vtkMRMLReadXMLFloatMacro(motionSpeed, MotionSpeed);
   vtkMRMLReadXMLFloatMacro(motionSensitivity, MotionSensitivity);
   vtkMRMLReadXMLBooleanMacro(controllerTransformsUpdate, ControllerTransformsUpdate);
   vtkMRMLReadXMLBooleanMacro(hmdTransformUpdate, HMDTransformUpdate);
+  vtkMRMLReadXMLFloatMacro(poseUpdateTolerance, PoseUpdateTolerance);
   vtkMRMLReadXMLBooleanMacro(controllerModelsVisible, ControllerModelsVisible);
   vtkMRMLReadXMLBooleanMacro(lighthouseModelsVisible, LighthouseModelsVisible);
   // OpenXRRemoting
@@ -113,6 +136,8 @@ void vtkMRMLVirtualRealityViewNode::ReadXMLAttributes(const char** atts)
   vtkMRMLReadXMLStdStringMacro(playerIPAddress, PlayerIPAddress);
   vtkMRMLReadXMLEndMacro();
 
+  this->UpdateTrackerTransformIndex();
+
   this->EndModify(disabledModify);
 }
 
@@ -130,11 +155,21 @@ void vtkMRMLVirtualRealityViewNode::Copy(vtkMRMLNode* anode)
   vtkMRMLCopyBooleanMacro(TwoSidedLighting);
   vtkMRMLCopyBooleanMacro(BackLights);
   vtkMRMLCopyFloatMacro(DesiredUpdateRate);
+  vtkMRMLCopyBooleanMacro(AdaptiveQuality);
+  vtkMRMLCopyFloatMacro(AdaptiveQualityMinimum);
+  vtkMRMLCopyFloatMacro(AdaptiveQualityMaximum);
+  vtkMRMLCopyBooleanMacro(DynamicRenderScale);
+  vtkMRMLCopyFloatMacro(MinimumRenderScale);
+  vtkMRMLCopyFloatMacro(MaximumRenderScale);
+  vtkMRMLCopyBooleanMacro(WarmStandby);
+  vtkMRMLCopyBooleanMacro(SharedGraphicsResources);
+  vtkMRMLCopyBooleanMacro(KeepAliveSubmission);
   vtkMRMLCopyFloatMacro(Magnification);
   vtkMRMLCopyFloatMacro(MotionSpeed);
   vtkMRMLCopyFloatMacro(MotionSensitivity);
   vtkMRMLCopyBooleanMacro(ControllerTransformsUpdate);
   vtkMRMLCopyBooleanMacro(HMDTransformUpdate);
+  vtkMRMLCopyFloatMacro(PoseUpdateTolerance);
   vtkMRMLCopyBooleanMacro(ControllerModelsVisible);
   vtkMRMLCopyBooleanMacro(LighthouseModelsVisible);
   // OpenXRRemoting
@@ -142,6 +177,8 @@ void vtkMRMLVirtualRealityViewNode::Copy(vtkMRMLNode* anode)
   vtkMRMLCopyStringMacro(PlayerIPAddress);
   vtkMRMLCopyEndMacro();
 
+  this->UpdateTrackerTransformIndex();
+
   this->EndModify(disabledModify);
 }
 
@@ -155,17 +192,42 @@ void vtkMRMLVirtualRealityViewNode::PrintSelf(ostream& os, vtkIndent indent)
   vtkMRMLPrintBooleanMacro(TwoSidedLighting);
   vtkMRMLPrintBooleanMacro(BackLights);
   vtkMRMLPrintFloatMacro(DesiredUpdateRate);
+  vtkMRMLPrintBooleanMacro(AdaptiveQuality);
+  vtkMRMLPrintFloatMacro(AdaptiveQualityMinimum);
+  vtkMRMLPrintFloatMacro(AdaptiveQualityMaximum);
+  vtkMRMLPrintBooleanMacro(DynamicRenderScale);
+  vtkMRMLPrintFloatMacro(MinimumRenderScale);
+  vtkMRMLPrintFloatMacro(MaximumRenderScale);
+  vtkMRMLPrintBooleanMacro(WarmStandby);
+  vtkMRMLPrintBooleanMacro(SharedGraphicsResources);
+  vtkMRMLPrintBooleanMacro(KeepAliveSubmission);
   vtkMRMLPrintFloatMacro(Magnification);
   vtkMRMLPrintFloatMacro(MotionSpeed);
   vtkMRMLPrintFloatMacro(MotionSensitivity);
   vtkMRMLPrintBooleanMacro(ControllerTransformsUpdate);
   vtkMRMLPrintBooleanMacro(HMDTransformUpdate);
+  vtkMRMLPrintFloatMacro(PoseUpdateTolerance);
   vtkMRMLPrintBooleanMacro(ControllerModelsVisible);
   vtkMRMLPrintBooleanMacro(LighthouseModelsVisible);
   // OpenXRRemoting
   vtkMRMLPrintBooleanMacro(Remoting);
   vtkMRMLPrintStdStringMacro(PlayerIPAddress);
   vtkMRMLPrintEndMacro();
+
+  os << indent << "ConnectionState: " << vtkMRMLVirtualRealityViewNode::GetConnectionStateAsString(this->ConnectionState) << "\n";
+  os << indent << "ConnectionAttempt: " << this->ConnectionAttempt << "\n";
+
+  os << indent << "DeviceStatuses:\n";
+  for (const auto& keyAndStatus : this->DeviceStatuses)
+  {
+    const DeviceStatus& status = keyAndStatus.second;
+    os << indent.GetNextIndent() << "Device " << static_cast<int>(keyAndStatus.first.first)
+       << " (handle " << keyAndStatus.first.second << "): "
+       << vtkMRMLVirtualRealityViewNode::GetTrackingResultAsString(status.TrackingResult)
+       << ", Connected: " << (status.Connected ? "true" : "false")
+       << ", PoseValid: " << (status.PoseValid ? "true" : "false")
+       << ", LastUpdateTime: " << status.LastUpdateTime << "\n";
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -353,17 +415,128 @@ bool vtkMRMLVirtualRealityViewNode::SetAndObserveHMDTransformNode(vtkMRMLLinearT
 }
 
 //----------------------------------------------------------------------------
-std::vector<vtkMRMLLinearTransformNode*> vtkMRMLVirtualRealityViewNode::GetTrackerTransformNodes()
+bool vtkMRMLVirtualRealityViewNode::GetTrackerDeviceHandleFromRole(const char* role, uint32_t& deviceHandle)
 {
-  std::vector<vtkMRMLLinearTransformNode*> nodes;
+  if (role == nullptr)
+  {
+    return false;
+  }
+  // Tracker roles are "<deviceHandle>.GenericTracker"
+  char* roleSuffix = nullptr;
+  unsigned long value = strtoul(role, &roleSuffix, 10);
+  if (roleSuffix == role || *roleSuffix != '.'
+      || strcmp(roleSuffix + 1, vtkMRMLVirtualRealityViewNode::TrackerTransformRole) != 0)
+  {
+    return false;
+  }
+  deviceHandle = static_cast<uint32_t>(value);
+  return true;
+}
 
+//----------------------------------------------------------------------------
+void vtkMRMLVirtualRealityViewNode::UpdateTrackerTransformIndex()
+{
+  this->TrackerTransformIndex.clear();
   std::vector<std::string> roles;
   this->GetNodeReferenceRoles(roles);
   for (const std::string& role : roles)
   {
-    if (role.find(this->TrackerTransformRole) != std::string::npos)
+    uint32_t deviceHandle = 0;
+    if (!vtkMRMLVirtualRealityViewNode::GetTrackerDeviceHandleFromRole(role.c_str(), deviceHandle)
+        || this->GetNodeReferenceID(role.c_str()) == nullptr)
+    {
+      continue;
+    }
+    TrackerTransformReference& trackerReference = this->TrackerTransformIndex[deviceHandle];
+    trackerReference.Role = role;
+    trackerReference.Node = vtkMRMLLinearTransformNode::SafeDownCast(this->GetNodeReference(role.c_str()));
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkMRMLVirtualRealityViewNode::TrackerTransformReference* vtkMRMLVirtualRealityViewNode::GetTrackerTransformReference(uint32_t deviceHandle)
+{
+  std::unordered_map<uint32_t, TrackerTransformReference>::iterator trackerIt = this->TrackerTransformIndex.find(deviceHandle);
+  if (trackerIt == this->TrackerTransformIndex.end())
+  {
+    return nullptr;
+  }
+  TrackerTransformReference& trackerReference = trackerIt->second;
+  if (trackerReference.Node == nullptr)
+  {
+    // Referenced node is not resolved yet (e.g., scene is being loaded) or the reference was removed
+    trackerReference.Node = vtkMRMLLinearTransformNode::SafeDownCast(this->GetNodeReference(trackerReference.Role.c_str()));
+    if (trackerReference.Node == nullptr && this->GetNodeReferenceID(trackerReference.Role.c_str()) == nullptr)
+    {
+      this->TrackerTransformIndex.erase(trackerIt);
+      return nullptr;
+    }
+  }
+  return &trackerReference;
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLVirtualRealityViewNode::OnNodeReferenceAdded(vtkMRMLNodeReference* reference)
+{
+  this->Superclass::OnNodeReferenceAdded(reference);
+  uint32_t deviceHandle = 0;
+  if (!vtkMRMLVirtualRealityViewNode::GetTrackerDeviceHandleFromRole(reference->GetReferenceRole(), deviceHandle))
+  {
+    return;
+  }
+  TrackerTransformReference& trackerReference = this->TrackerTransformIndex[deviceHandle];
+  trackerReference.Role = reference->GetReferenceRole();
+  trackerReference.Node = vtkMRMLLinearTransformNode::SafeDownCast(reference->GetReferencedNode());
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLVirtualRealityViewNode::OnNodeReferenceModified(vtkMRMLNodeReference* reference)
+{
+  this->Superclass::OnNodeReferenceModified(reference);
+  uint32_t deviceHandle = 0;
+  if (!vtkMRMLVirtualRealityViewNode::GetTrackerDeviceHandleFromRole(reference->GetReferenceRole(), deviceHandle))
+  {
+    return;
+  }
+  TrackerTransformReference& trackerReference = this->TrackerTransformIndex[deviceHandle];
+  trackerReference.Role = reference->GetReferenceRole();
+  trackerReference.Node = vtkMRMLLinearTransformNode::SafeDownCast(reference->GetReferencedNode());
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLVirtualRealityViewNode::OnNodeReferenceRemoved(vtkMRMLNodeReference* reference)
+{
+  this->Superclass::OnNodeReferenceRemoved(reference);
+  uint32_t deviceHandle = 0;
+  if (!vtkMRMLVirtualRealityViewNode::GetTrackerDeviceHandleFromRole(reference->GetReferenceRole(), deviceHandle))
+  {
+    return;
+  }
+  std::unordered_map<uint32_t, TrackerTransformReference>::iterator trackerIt = this->TrackerTransformIndex.find(deviceHandle);
+  if (trackerIt != this->TrackerTransformIndex.end())
+  {
+    // Entry is removed from the index at next lookup if the reference is not replaced
+    trackerIt->second.Node = nullptr;
+  }
+}
+
+//----------------------------------------------------------------------------
+std::vector<vtkMRMLLinearTransformNode*> vtkMRMLVirtualRealityViewNode::GetTrackerTransformNodes()
+{
+  std::vector<uint32_t> deviceHandles;
+  for (const auto& trackerIt : this->TrackerTransformIndex)
+  {
+    deviceHandles.push_back(trackerIt.first);
+  }
+  std::sort(deviceHandles.begin(), deviceHandles.end());
+
+  std::vector<vtkMRMLLinearTransformNode*> nodes;
+  for (uint32_t deviceHandle : deviceHandles)
+  {
+    TrackerTransformReference* trackerReference = this->GetTrackerTransformReference(deviceHandle);
+    if (trackerReference != nullptr && trackerReference->Node != nullptr)
     {
-      nodes.push_back(vtkMRMLLinearTransformNode::SafeDownCast(this->GetNthNodeReference(role.c_str(), 0)));
+      nodes.push_back(trackerReference->Node);
     }
   }
 
@@ -377,10 +550,8 @@ vtkMRMLLinearTransformNode* vtkMRMLVirtualRealityViewNode::GetTrackerTransformNo
   {
     return nullptr;
   }
-  std::stringstream ss;
-  ss << deviceHandle << "." << this->TrackerTransformRole;
-  return vtkMRMLLinearTransformNode::SafeDownCast(
-           this->GetNthNodeReference(ss.str().c_str(), 0));
+  TrackerTransformReference* trackerReference = this->GetTrackerTransformReference(deviceHandle);
+  return trackerReference ? trackerReference->Node.GetPointer() : nullptr;
 }
 
 //----------------------------------------------------------------------------
@@ -390,37 +561,54 @@ const char* vtkMRMLVirtualRealityViewNode::GetTrackerTransformNodeID(uint32_t de
   {
     return nullptr;
   }
-  std::stringstream ss;
-  ss << deviceHandle << "." << this->TrackerTransformRole;
-  return this->GetNthNodeReferenceID(ss.str().c_str(), 0);
+  TrackerTransformReference* trackerReference = this->GetTrackerTransformReference(deviceHandle);
+  return trackerReference ? this->GetNthNodeReferenceID(trackerReference->Role.c_str(), 0) : nullptr;
 }
 
 //----------------------------------------------------------------------------
-vtkMRMLLinearTransformNode* vtkMRMLVirtualRealityViewNode::SetAndObserveTrackerTransformNodeID(const char* nodeId, uint32_t deviceHandle)
+uint32_t vtkMRMLVirtualRealityViewNode::GetTrackerTransformNodeDeviceHandle(vtkMRMLNode* node)
 {
-  if (deviceHandle == UINT32_MAX /* InvalidDeviceIndex or vr::k_unTrackedDeviceIndexInvalid */)
+  if (node == nullptr)
   {
-    return nullptr;
+    return UINT32_MAX;
   }
-  std::stringstream ss;
-  ss << deviceHandle << "." << this->TrackerTransformRole;
-  return vtkMRMLLinearTransformNode::SafeDownCast(this->SetAndObserveNthNodeReferenceID(ss.str().c_str(), 0, nodeId));
+  for (const auto& trackerIt : this->TrackerTransformIndex)
+  {
+    if (trackerIt.second.Node == node)
+    {
+      return trackerIt.first;
+    }
+  }
+  return UINT32_MAX;
 }
 
 //----------------------------------------------------------------------------
-vtkMRMLLinearTransformNode* vtkMRMLVirtualRealityViewNode::SetAndObserveTrackerTransformNode(vtkMRMLLinearTransformNode* node, uint32_t deviceHandle)
+vtkMRMLLinearTransformNode* vtkMRMLVirtualRealityViewNode::SetAndObserveTrackerTransformNodeID(const char* nodeId, uint32_t deviceHandle)
 {
   if (deviceHandle == UINT32_MAX /* InvalidDeviceIndex or vr::k_unTrackedDeviceIndexInvalid */)
   {
     return nullptr;
   }
-  std::stringstream ss;
-  ss << deviceHandle << "." << this->TrackerTransformRole;
-  if (node == nullptr)
+  if (nodeId == nullptr)
+  {
+    this->RemoveTrackerTransformNode(deviceHandle);
+    return nullptr;
+  }
+  TrackerTransformReference& trackerReference = this->TrackerTransformIndex[deviceHandle];
+  if (trackerReference.Role.empty())
   {
-    return vtkMRMLLinearTransformNode::SafeDownCast(this->SetAndObserveNthNodeReferenceID(ss.str().c_str(), 0, nullptr));
+    // Role string is only built the first time a node is set for the device
+    trackerReference.Role = std::to_string(deviceHandle) + "." + this->TrackerTransformRole;
   }
-  return vtkMRMLLinearTransformNode::SafeDownCast(this->SetAndObserveNthNodeReferenceID(ss.str().c_str(), 0, node->GetID()));
+  trackerReference.Node = vtkMRMLLinearTransformNode::SafeDownCast(
+    this->SetAndObserveNthNodeReferenceID(trackerReference.Role.c_str(), 0, nodeId));
+  return trackerReference.Node;
+}
+
+//----------------------------------------------------------------------------
+vtkMRMLLinearTransformNode* vtkMRMLVirtualRealityViewNode::SetAndObserveTrackerTransformNode(vtkMRMLLinearTransformNode* node, uint32_t deviceHandle)
+{
+  return this->SetAndObserveTrackerTransformNodeID(node ? node->GetID() : nullptr, deviceHandle);
 }
 
 //----------------------------------------------------------------------------
@@ -430,22 +618,28 @@ void vtkMRMLVirtualRealityViewNode::RemoveTrackerTransformNode(uint32_t deviceHa
   {
     return;
   }
-  std::stringstream ss;
-  ss << deviceHandle << "." << this->TrackerTransformRole;
-  this->RemoveNthNodeReferenceID(ss.str().c_str(), 0);
+  std::unordered_map<uint32_t, TrackerTransformReference>::iterator trackerIt = this->TrackerTransformIndex.find(deviceHandle);
+  if (trackerIt == this->TrackerTransformIndex.end())
+  {
+    return;
+  }
+  std::string role = trackerIt->second.Role;
+  this->TrackerTransformIndex.erase(trackerIt);
+  this->RemoveNthNodeReferenceID(role.c_str(), 0);
 }
 
 //----------------------------------------------------------------------------
 void vtkMRMLVirtualRealityViewNode::RemoveAllTrackerTransformNodes()
 {
   std::vector<std::string> roles;
-  this->GetNodeReferenceRoles(roles);
-  for (std::vector<std::string>::iterator it = roles.begin(); it != roles.end(); ++it)
+  for (const auto& trackerIt : this->TrackerTransformIndex)
   {
-    if (it->find(this->TrackerTransformRole) != std::string::npos)
-    {
-      this->RemoveNodeReferenceIDs(it->c_str());
-    }
+    roles.push_back(trackerIt.second.Role);
+  }
+  this->TrackerTransformIndex.clear();
+  for (const std::string& role : roles)
+  {
+    this->RemoveNodeReferenceIDs(role.c_str());
   }
 }
 
@@ -519,20 +713,23 @@ vtkMRMLLinearTransformNode* vtkMRMLVirtualRealityViewNode::CreateDefaultTrackerT
   {
     return nullptr;
   }
-  vtkSmartPointer<vtkMRMLLinearTransformNode> linearTransformNode = this->GetTrackerTransformNode(deviceHandle);
-  if (linearTransformNode == nullptr)
+  vtkMRMLLinearTransformNode* existingNode = this->GetTrackerTransformNode(deviceHandle);
+  if (existingNode != nullptr)
   {
-    // Node wasn't found for this device, let's create one
-    linearTransformNode = vtkSmartPointer<vtkMRMLLinearTransformNode>::Take(
-                            vtkMRMLLinearTransformNode::SafeDownCast(this->GetScene()->CreateNodeByClass("vtkMRMLLinearTransformNode")));
+    return existingNode;
+  }
+  if (!this->GetScene())
+  {
+    return nullptr;
+  }
 
-    std::stringstream ss;
-    ss << deviceHandle;
-    std::string deviceHandleAsStr = ss.str();
+  // Node wasn't found for this device, let's create one
+  vtkSmartPointer<vtkMRMLLinearTransformNode> linearTransformNode = vtkSmartPointer<vtkMRMLLinearTransformNode>::Take(
+    vtkMRMLLinearTransformNode::SafeDownCast(this->GetScene()->CreateNodeByClass("vtkMRMLLinearTransformNode")));
+  linearTransformNode->SetAttribute("VirtualReality.VRDeviceID", std::to_string(deviceHandle).c_str());
+  linearTransformNode->SetName("VirtualReality.GenericTracker");
+  this->GetScene()->AddNode(linearTransformNode);
 
-    linearTransformNode->SetAttribute("VirtualReality.VRDeviceID", deviceHandleAsStr.c_str());
-    linearTransformNode->SetName("VirtualReality.GenericTracker");
-  }
   this->SetAndObserveTrackerTransformNode(linearTransformNode, deviceHandle);
   return linearTransformNode;
 }
@@ -562,6 +759,9 @@ void vtkMRMLVirtualRealityViewNode::SetControllerTransformsUpdate(bool enable)
       transformNode->SetAttribute("VirtualReality.ControllerActive", "0");
       transformNode->SetAttribute("VirtualReality.ControllerConnected", "0");
     }
+    // Make sure attributes are set again when update is re-enabled
+    this->RemoveDeviceStatuses(vtkEventDataDevice::LeftController);
+    this->RemoveDeviceStatuses(vtkEventDataDevice::RightController);
   }
 
   this->Modified();
@@ -585,6 +785,8 @@ void vtkMRMLVirtualRealityViewNode::SetHMDTransformUpdate(bool enable)
     {
       transformNode->SetAttribute("VirtualReality.HMDActive", "0");
     }
+    // Make sure attributes are set again when update is re-enabled
+    this->RemoveDeviceStatuses(vtkEventDataDevice::HeadMountedDisplay);
   }
 
   this->Modified();
@@ -603,17 +805,12 @@ void vtkMRMLVirtualRealityViewNode::SetTrackerTransformUpdate(bool enable)
 
   if (!enable)
   {
-    for (NodeReferencesType::iterator roleIt = this->NodeReferences.begin(); roleIt != this->NodeReferences.end(); roleIt++)
+    for (vtkMRMLLinearTransformNode* node : this->GetTrackerTransformNodes())
     {
-      if (roleIt->first.find(this->TrackerTransformRole) != std::string::npos)
-      {
-        vtkMRMLNode* node = this->GetNodeReference(roleIt->first.c_str());
-        if (node)
-        {
-          node->SetAttribute("VirtualReality.TrackerActive", "0");
-        }
-      }
+      node->SetAttribute("VirtualReality.TrackerActive", "0");
     }
+    // Make sure attributes are set again when update is re-enabled
+    this->RemoveDeviceStatuses(vtkEventDataDevice::GenericTracker);
   }
   this->Modified();
 }
@@ -632,6 +829,7 @@ const char* vtkMRMLVirtualRealityViewNode::GetXRBackendAsString(int id)
     case UndefinedXRBackend: return "undefined";
     case OpenVR: return "OpenVR";
     case OpenXR: return "OpenXR";
+    case Simulated: return "Simulated";
     default:
       // invalid id
       return "";
@@ -658,6 +856,200 @@ int vtkMRMLVirtualRealityViewNode::GetXRBackendFromString(const char* name)
   return -1;
 }
 
+//-----------------------------------------------------------
+const char* vtkMRMLVirtualRealityViewNode::GetConnectionStateAsString(int id)
+{
+  switch (id)
+  {
+    case ConnectionStateDisconnected: return "Disconnected";
+    case ConnectionStateConnecting: return "Connecting";
+    case ConnectionStateRetrying: return "Retrying";
+    case ConnectionStateConnected: return "Connected";
+    case ConnectionStateFailed: return "Failed";
+    case ConnectionStateStandby: return "Standby";
+    case ConnectionStateCreatingSession: return "CreatingSession";
+    default:
+      // invalid id
+      return "";
+  }
+}
+
+//-----------------------------------------------------------
+int vtkMRMLVirtualRealityViewNode::GetConnectionStateFromString(const char* name)
+{
+  if (name == nullptr)
+  {
+    // invalid name
+    return -1;
+  }
+  for (int ii = 0; ii < ConnectionState_Last; ii++)
+  {
+    if (strcmp(name, vtkMRMLVirtualRealityViewNode::GetConnectionStateAsString(ii)) == 0)
+    {
+      // found a matching name
+      return ii;
+    }
+  }
+  // unknown name
+  return -1;
+}
+
+//-----------------------------------------------------------
+const char* vtkMRMLVirtualRealityViewNode::GetTrackingResultAsString(int id)
+{
+  switch (id)
+  {
+    case TrackingResultUninitialized: return "Uninitialized";
+    case TrackingResultCalibratingInProgress: return "CalibratingInProgress";
+    case TrackingResultCalibratingOutOfRange: return "CalibratingOutOfRange";
+    case TrackingResultRunningOK: return "RunningOk";
+    case TrackingResultRunningOutOfRange: return "RunningOutOfRange";
+    default:
+      // invalid id
+      return "";
+  }
+}
+
+//-----------------------------------------------------------
+int vtkMRMLVirtualRealityViewNode::GetTrackingResultFromString(const char* name)
+{
+  if (name == nullptr)
+  {
+    // invalid name
+    return -1;
+  }
+  for (int ii = 0; ii < TrackingResult_Last; ii++)
+  {
+    if (strcmp(name, vtkMRMLVirtualRealityViewNode::GetTrackingResultAsString(ii)) == 0)
+    {
+      // found a matching name
+      return ii;
+    }
+  }
+  // unknown name
+  return -1;
+}
+
+//----------------------------------------------------------------------------
+vtkMRMLVirtualRealityViewNode::DeviceStatusKeyType vtkMRMLVirtualRealityViewNode::GetDeviceStatusKey(
+  vtkEventDataDevice device, uint32_t deviceHandle)
+{
+  // There is only one HMD and one controller per hand, handle only matters for trackers
+  return DeviceStatusKeyType(device, device == vtkEventDataDevice::GenericTracker ? deviceHandle : 0);
+}
+
+//----------------------------------------------------------------------------
+bool vtkMRMLVirtualRealityViewNode::SetDeviceStatus(vtkEventDataDevice device, uint32_t deviceHandle,
+  int trackingResult, bool connected, bool poseValid, double updateTime)
+{
+  DeviceStatusKeyType key = vtkMRMLVirtualRealityViewNode::GetDeviceStatusKey(device, deviceHandle);
+  std::map<DeviceStatusKeyType, DeviceStatus>::iterator statusIt = this->DeviceStatuses.find(key);
+  bool changed = false;
+  if (statusIt == this->DeviceStatuses.end())
+  {
+    statusIt = this->DeviceStatuses.insert(std::make_pair(key, DeviceStatus())).first;
+    changed = true;
+  }
+  DeviceStatus& status = statusIt->second;
+  changed = changed
+    || status.TrackingResult != trackingResult
+    || status.Connected != connected
+    || status.PoseValid != poseValid;
+
+  status.TrackingResult = trackingResult;
+  status.Connected = connected;
+  status.PoseValid = poseValid;
+  status.LastUpdateTime = updateTime;
+
+  if (changed)
+  {
+    this->InvokeEvent(vtkMRMLVirtualRealityViewNode::DeviceStatusModifiedEvent);
+  }
+  return changed;
+}
+
+//----------------------------------------------------------------------------
+const vtkMRMLVirtualRealityViewNode::DeviceStatus* vtkMRMLVirtualRealityViewNode::GetDeviceStatus(
+  vtkEventDataDevice device, uint32_t deviceHandle) const
+{
+  std::map<DeviceStatusKeyType, DeviceStatus>::const_iterator statusIt =
+    this->DeviceStatuses.find(vtkMRMLVirtualRealityViewNode::GetDeviceStatusKey(device, deviceHandle));
+  if (statusIt == this->DeviceStatuses.end())
+  {
+    return nullptr;
+  }
+  return &statusIt->second;
+}
+
+//----------------------------------------------------------------------------
+bool vtkMRMLVirtualRealityViewNode::HasDeviceStatus(vtkEventDataDevice device, uint32_t deviceHandle)
+{
+  return this->GetDeviceStatus(device, deviceHandle) != nullptr;
+}
+
+//----------------------------------------------------------------------------
+int vtkMRMLVirtualRealityViewNode::GetDeviceTrackingResult(vtkEventDataDevice device, uint32_t deviceHandle)
+{
+  const DeviceStatus* status = this->GetDeviceStatus(device, deviceHandle);
+  return status ? status->TrackingResult : TrackingResultUninitialized;
+}
+
+//----------------------------------------------------------------------------
+bool vtkMRMLVirtualRealityViewNode::GetDeviceConnected(vtkEventDataDevice device, uint32_t deviceHandle)
+{
+  const DeviceStatus* status = this->GetDeviceStatus(device, deviceHandle);
+  return status ? status->Connected : false;
+}
+
+//----------------------------------------------------------------------------
+bool vtkMRMLVirtualRealityViewNode::GetDevicePoseValid(vtkEventDataDevice device, uint32_t deviceHandle)
+{
+  const DeviceStatus* status = this->GetDeviceStatus(device, deviceHandle);
+  return status ? status->PoseValid : false;
+}
+
+//----------------------------------------------------------------------------
+double vtkMRMLVirtualRealityViewNode::GetDeviceLastUpdateTime(vtkEventDataDevice device, uint32_t deviceHandle)
+{
+  const DeviceStatus* status = this->GetDeviceStatus(device, deviceHandle);
+  return status ? status->LastUpdateTime : 0.0;
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLVirtualRealityViewNode::RemoveDeviceStatuses(vtkEventDataDevice device)
+{
+  bool removed = false;
+  for (std::map<DeviceStatusKeyType, DeviceStatus>::iterator statusIt = this->DeviceStatuses.begin();
+       statusIt != this->DeviceStatuses.end();)
+  {
+    if (statusIt->first.first == device)
+    {
+      statusIt = this->DeviceStatuses.erase(statusIt);
+      removed = true;
+    }
+    else
+    {
+      ++statusIt;
+    }
+  }
+  if (removed)
+  {
+    this->InvokeEvent(vtkMRMLVirtualRealityViewNode::DeviceStatusModifiedEvent);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkMRMLVirtualRealityViewNode::RemoveAllDeviceStatuses()
+{
+  if (this->DeviceStatuses.empty())
+  {
+    // no change
+    return;
+  }
+  this->DeviceStatuses.clear();
+  this->InvokeEvent(vtkMRMLVirtualRealityViewNode::DeviceStatusModifiedEvent);
+}
+
 //----------------------------------------------------------------------------
 bool vtkMRMLVirtualRealityViewNode::HasError()
 {
@@ -21,6 +21,11 @@
 
 // VTK includes
 #include <vtkEventData.h>
+#include <vtkWeakPointer.h>
+
+// STD includes
+#include <map>
+#include <unordered_map>
 
 // VR MRML includes
 #include "vtkSlicerVirtualRealityModuleMRMLExport.h"
@@ -43,9 +48,54 @@ public:
     UndefinedXRBackend,
     OpenVR,
     OpenXR,
+    Simulated, ///< No XR runtime, device poses and events are set programmatically
     XRBackend_Last // must be last
     };
 
+  /// Tracking state of a device, values match \c vr::ETrackingResult states of OpenVR.
+  enum TrackingResultType : int
+    {
+    TrackingResultUninitialized,
+    TrackingResultCalibratingInProgress,
+    TrackingResultCalibratingOutOfRange,
+    TrackingResultRunningOK,
+    TrackingResultRunningOutOfRange,
+    TrackingResult_Last // must be last
+    };
+
+  /// State of the connection to the XR runtime, reported by the virtual reality view.
+  ///
+  /// Only the start of the OpenVR runtime (ConnectionStateConnecting with the OpenVR backend) runs
+  /// in the background. Creating the session (ConnectionStateCreatingSession) blocks the application
+  /// until the XR runtime responds, for all backends.
+  enum ConnectionStateType : int
+    {
+    ConnectionStateDisconnected,
+    ConnectionStateConnecting, ///< Initialization attempt in progress
+    ConnectionStateRetrying, ///< Initialization attempt failed, another attempt is scheduled
+    ConnectionStateConnected,
+    ConnectionStateFailed, ///< All initialization attempts failed, see GetError()
+    ConnectionStateStandby, ///< Disconnected, the XR backend is kept initialized. \sa GetWarmStandby()
+    ConnectionStateCreatingSession, ///< Initialization attempt in progress, the XR session is being created
+    ConnectionState_Last // must be last
+    };
+
+  enum
+    {
+    /// Invoked when the status of a device changes.
+    DeviceStatusModifiedEvent = 22050
+    };
+
+  /// Last reported status of a tracked device.
+  struct DeviceStatus
+  {
+    int TrackingResult{TrackingResultUninitialized};
+    bool Connected{false};
+    bool PoseValid{false};
+    /// Time of the last report, in seconds. Virtual reality view reports vtkVirtualRealityFramePacer::GetTime().
+    double LastUpdateTime{0.0};
+  };
+
   //--------------------------------------------------------------------------
   /// MRMLNode methods
   //--------------------------------------------------------------------------
@@ -167,6 +217,91 @@ public:
   vtkSetMacro(DesiredUpdateRate, double);
   ///}@
 
+  ///@{
+  /// If enabled then rendering quality is continuously adjusted to hold the headset frame rate:
+  /// quality increases while rendering takes less time than the frame period, and decreases
+  /// when it takes longer. Quality is applied through the desired update rate of the render
+  /// window, ranging from DesiredUpdateRate (lowest quality) to the update rate used for static
+  /// views (highest quality).
+  /// If disabled then the highest quality is used while the view is not moving (see MotionSensitivity)
+  /// and DesiredUpdateRate is used otherwise, which causes visible quality changes when the view
+  /// starts or stops moving.
+  /// Default is enabled.
+  vtkGetMacro(AdaptiveQuality, bool);
+  vtkSetMacro(AdaptiveQuality, bool);
+  vtkBooleanMacro(AdaptiveQuality, bool);
+  ///}@
+
+  ///@{
+  /// Range of the quality level [0.0, 1.0] when AdaptiveQuality is enabled.
+  /// Defaults are 0.0 and 1.0.
+  vtkGetMacro(AdaptiveQualityMinimum, double);
+  vtkSetClampMacro(AdaptiveQualityMinimum, double, 0.0, 1.0);
+  vtkGetMacro(AdaptiveQualityMaximum, double);
+  vtkSetClampMacro(AdaptiveQualityMaximum, double, 0.0, 1.0);
+  ///}@
+
+  ///@{
+  /// If enabled then the resolution of the eye render targets is continuously adjusted
+  /// between MinimumRenderScale and MaximumRenderScale: it is reduced when rendering takes
+  /// longer than the frame period, and increased when there is headroom.
+  /// If AdaptiveQuality is also enabled, resolution is only reduced once the quality level is at
+  /// AdaptiveQualityMinimum, and quality is only increased once resolution is at MaximumRenderScale.
+  /// Supported by the OpenVR and Simulated XR backends.
+  /// Default is disabled.
+  vtkGetMacro(DynamicRenderScale, bool);
+  vtkSetMacro(DynamicRenderScale, bool);
+  vtkBooleanMacro(DynamicRenderScale, bool);
+  ///}@
+
+  ///@{
+  /// Range of the fraction of the recommended eye render size used for rendering, along
+  /// each axis [0.1, 1.0]. Defaults are 0.5 and 1.0.
+  vtkGetMacro(MinimumRenderScale, double);
+  vtkSetClampMacro(MinimumRenderScale, double, 0.1, 1.0);
+  vtkGetMacro(MaximumRenderScale, double);
+  vtkSetClampMacro(MaximumRenderScale, double, 0.1, 1.0);
+  ///}@
+
+  ///@{
+  /// If enabled then the render window, the displayable managers and their graphics
+  /// resources are kept when the view is disconnected (visibility turned off). Only
+  /// rendering, and therefore frame submission to the XR runtime, is stopped, so that
+  /// reconnecting is almost immediate. The XR runtime session is kept open meanwhile.
+  /// Disabling it while disconnected releases the resources.
+  /// Default is disabled.
+  vtkGetMacro(WarmStandby, bool);
+  vtkSetMacro(WarmStandby, bool);
+  vtkBooleanMacro(WarmStandby, bool);
+  ///}@
+
+  ///@{
+  /// If enabled then the render window is created with an OpenGL context shared with the
+  /// render window of the reference view, so that vertex buffers of data arrays displayed
+  /// in both views are uploaded to the GPU only once. Textures, including 3D textures used
+  /// for volume rendering, are not shared and are still uploaded for each view.
+  /// Sharing is only possible if the XR backend and the graphics driver support it. It is
+  /// verified once the render window is initialized, if the contexts are not actually shared
+  /// then the render window is created again with its own context.
+  /// Applied when the render window is created.
+  /// Default is disabled.
+  /// \sa GetReferenceViewNode()
+  vtkGetMacro(SharedGraphicsResources, bool);
+  vtkSetMacro(SharedGraphicsResources, bool);
+  vtkBooleanMacro(SharedGraphicsResources, bool);
+  ///}@
+
+  ///@{
+  /// If enabled then the last rendered frame is submitted again to the XR runtime from a
+  /// separate thread while the render loop is stalled, for example by a long operation
+  /// in the application, so that the headset keeps displaying the scene.
+  /// Only supported by the OpenVR backend. Ignored if the view is not active.
+  /// Default is disabled.
+  vtkGetMacro(KeepAliveSubmission, bool);
+  vtkSetMacro(KeepAliveSubmission, bool);
+  vtkBooleanMacro(KeepAliveSubmission, bool);
+  ///}@
+
   ///@{
   /// Magnification of world [0.01, 100].
   /// Value greater than 1 means that objects appear larger in VR than their real world size.
@@ -208,6 +343,48 @@ public:
   vtkBooleanMacro(TrackerTransformUpdate, bool);
   ///}@
 
+  ///@{
+  /// Set the status of a tracked device.
+  /// Device handle identifies the tracker of GenericTracker devices and is ignored for other devices.
+  /// DeviceStatusModifiedEvent is invoked if tracking result, connected or pose valid state changed.
+  /// Return true if the status changed.
+  bool SetDeviceStatus(vtkEventDataDevice device, uint32_t deviceHandle,
+    int trackingResult, bool connected, bool poseValid, double updateTime);
+  /// Return true if a status has been reported for the device.
+  bool HasDeviceStatus(vtkEventDataDevice device, uint32_t deviceHandle = 0);
+  /// Return tracking result of the device. TrackingResultUninitialized is returned if no status is available.
+  int GetDeviceTrackingResult(vtkEventDataDevice device, uint32_t deviceHandle = 0);
+  bool GetDeviceConnected(vtkEventDataDevice device, uint32_t deviceHandle = 0);
+  bool GetDevicePoseValid(vtkEventDataDevice device, uint32_t deviceHandle = 0);
+  double GetDeviceLastUpdateTime(vtkEventDataDevice device, uint32_t deviceHandle = 0);
+  /// Remove status of all devices, typically when the connection to the headset is closed.
+  void RemoveAllDeviceStatuses();
+  ///@}
+
+#ifndef __WRAP__
+  /// Get status of a device. Return nullptr if no status is available.
+  const DeviceStatus* GetDeviceStatus(vtkEventDataDevice device, uint32_t deviceHandle = 0) const;
+#endif
+
+  /// Get device handle of the tracker associated with the transform node.
+  /// Return UINT32_MAX if the node is not a tracker transform node.
+  uint32_t GetTrackerTransformNodeDeviceHandle(vtkMRMLNode* node);
+
+  ///@{
+  /// Convert between tracking result identifier and name.
+  /// Names are those used in the "VirtualReality.PoseStatus" transform node attribute.
+  static const char* GetTrackingResultAsString(int id);
+  static int GetTrackingResultFromString(const char* name);
+  ///@}
+
+  ///@{
+  /// Largest change of any element of a device pose matrix that is ignored when
+  /// updating controller, HMD and tracker transforms. Translation is in millimeters.
+  /// Default is 0.001.
+  vtkGetMacro(PoseUpdateTolerance, double);
+  vtkSetMacro(PoseUpdateTolerance, double);
+  ///}@
+
   ///@{
   /// If set to true then controllers are visible in virtual reality view.
   vtkGetMacro(ControllerModelsVisible, bool);
@@ -255,6 +432,26 @@ public:
   vtkGetMacro(PlayerIPAddress, std::string);
   ///@}
 
+  ///@{
+  /// State of the connection to the XR runtime.
+  /// Set by the virtual reality view, it is not saved in the scene.
+  vtkGetMacro(ConnectionState, int);
+  vtkSetMacro(ConnectionState, int);
+  ///@}
+
+  ///@{
+  /// Number of the current (or last) initialization attempt, starting at 1.
+  /// Set by the virtual reality view, it is not saved in the scene.
+  vtkGetMacro(ConnectionAttempt, int);
+  vtkSetMacro(ConnectionAttempt, int);
+  ///@}
+
+  ///@{
+  /// Convert between connection state identifier and name
+  static const char* GetConnectionStateAsString(int id);
+  static int GetConnectionStateFromString(const char* name);
+  ///@}
+
   /// Return true if an error has occurred.
   /// "Connected" member requests connection but this method can tell if the
   /// hardware connection has been actually successfully established.
@@ -275,6 +472,15 @@ protected:
   bool TwoSidedLighting;
   bool BackLights;
   double DesiredUpdateRate;
+  bool AdaptiveQuality{true};
+  double AdaptiveQualityMinimum{0.0};
+  double AdaptiveQualityMaximum{1.0};
+  bool DynamicRenderScale{false};
+  double MinimumRenderScale{0.5};
+  double MaximumRenderScale{1.0};
+  bool WarmStandby{false};
+  bool SharedGraphicsResources{false};
+  bool KeepAliveSubmission{false};
   double Magnification;
   double MotionSpeed;
   double MotionSensitivity;
@@ -283,8 +489,46 @@ protected:
   bool ControllerModelsVisible;
   bool LighthouseModelsVisible;
   bool TrackerTransformUpdate;
+  double PoseUpdateTolerance{0.001};
 
   std::string LastErrorMessage;
+  int ConnectionState{ConnectionStateDisconnected};
+  int ConnectionAttempt{0};
+
+  ///@{
+  /// Keep tracker transform index consistent with the node references.
+  void OnNodeReferenceAdded(vtkMRMLNodeReference* reference) override;
+  void OnNodeReferenceRemoved(vtkMRMLNodeReference* reference) override;
+  void OnNodeReferenceModified(vtkMRMLNodeReference* reference) override;
+  ///@}
+
+  /// Rebuild the tracker transform index from the node references.
+  void UpdateTrackerTransformIndex();
+
+  /// Get device handle from a tracker transform node reference role ("<deviceHandle>.GenericTracker").
+  /// Return false if the role is not a tracker transform role.
+  static bool GetTrackerDeviceHandleFromRole(const char* role, uint32_t& deviceHandle);
+
+  /// Tracker transform node references indexed by device handle, to avoid building role
+  /// strings and scanning all node references when looking up trackers at each frame.
+  struct TrackerTransformReference
+  {
+    std::string Role;
+    vtkWeakPointer<vtkMRMLLinearTransformNode> Node;
+  };
+  std::unordered_map<uint32_t, TrackerTransformReference> TrackerTransformIndex;
+
+  /// Get index entry of the tracker, with the referenced node resolved.
+  /// Return nullptr if no tracker transform node is referenced for this device handle.
+  TrackerTransformReference* GetTrackerTransformReference(uint32_t deviceHandle);
+
+  /// Remove status of all devices of the given type.
+  void RemoveDeviceStatuses(vtkEventDataDevice device);
+
+  /// Device statuses indexed by device and tracker device handle.
+  typedef std::pair<vtkEventDataDevice, uint32_t> DeviceStatusKeyType;
+  std::map<DeviceStatusKeyType, DeviceStatus> DeviceStatuses;
+  static DeviceStatusKeyType GetDeviceStatusKey(vtkEventDataDevice device, uint32_t deviceHandle);
 
   // OpenXRRemoting
   bool Remoting{false};
@@ -0,0 +1,185 @@
+/*==============================================================================
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// VR Logic includes
+#include "vtkVirtualRealityPoseTraceReader.h"
+
+// VR MRMLDM includes
+#include "vtkVirtualRealityPoseTracePlayer.h"
+#include "vtkVirtualRealitySimulatedRenderWindow.h"
+#include "vtkVirtualRealityViewSimulatedInteractor.h"
+
+// VTK includes
+#include <vtkCallbackCommand.h>
+#include <vtkMatrix4x4.h>
+#include <vtkObjectFactory.h>
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkVirtualRealityPoseTracePlayer);
+
+//----------------------------------------------------------------------------
+vtkVirtualRealityPoseTracePlayer::vtkVirtualRealityPoseTracePlayer()
+{
+  this->CallbackCommand->SetClientData(this);
+  this->CallbackCommand->SetCallback(vtkVirtualRealityPoseTracePlayer::ProcessEvents);
+}
+
+//----------------------------------------------------------------------------
+vtkVirtualRealityPoseTracePlayer::~vtkVirtualRealityPoseTracePlayer()
+{
+  this->SetInteractor(nullptr);
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityPoseTracePlayer::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfFrames: " << this->Reader->GetNumberOfFrames() << "\n";
+  os << indent << "Loop: " << this->Loop << "\n";
+  os << indent << "Playing: " << this->Playing << "\n";
+  os << indent << "CurrentFrame: " << this->CurrentFrame << "\n";
+}
+
+//----------------------------------------------------------------------------
+bool vtkVirtualRealityPoseTracePlayer::Load(const char* fileName)
+{
+  this->Stop();
+  this->CurrentFrame = 0;
+  return this->Reader->Read(fileName);
+}
+
+//----------------------------------------------------------------------------
+vtkVirtualRealityPoseTraceReader* vtkVirtualRealityPoseTracePlayer::GetReader()
+{
+  return this->Reader;
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityPoseTracePlayer::SetInteractor(vtkVirtualRealityViewSimulatedInteractor* interactor)
+{
+  if (this->Interactor == interactor)
+  {
+    return;
+  }
+  if (this->Interactor != nullptr)
+  {
+    this->Interactor->RemoveObserver(this->CallbackCommand);
+  }
+  this->Interactor = interactor;
+  if (this->Interactor != nullptr)
+  {
+    this->Interactor->AddObserver(vtkVirtualRealityViewSimulatedInteractor::UpdateDevicesEvent, this->CallbackCommand);
+  }
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+vtkVirtualRealityViewSimulatedInteractor* vtkVirtualRealityPoseTracePlayer::GetInteractor()
+{
+  return this->Interactor;
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityPoseTracePlayer::Play()
+{
+  this->CurrentFrame = 0;
+  this->Playing = (this->Reader->GetNumberOfFrames() > 0);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityPoseTracePlayer::Stop()
+{
+  if (!this->Playing)
+  {
+    return;
+  }
+  this->Playing = false;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+bool vtkVirtualRealityPoseTracePlayer::ApplyFrame(int frameIndex)
+{
+  if (frameIndex < 0 || frameIndex >= this->Reader->GetNumberOfFrames())
+  {
+    vtkErrorMacro("ApplyFrame failed: invalid frame index " << frameIndex);
+    return false;
+  }
+  vtkVirtualRealitySimulatedRenderWindow* renderWindow = this->Interactor != nullptr
+    ? vtkVirtualRealitySimulatedRenderWindow::SafeDownCast(this->Interactor->GetRenderWindow()) : nullptr;
+  if (renderWindow == nullptr)
+  {
+    vtkErrorMacro("ApplyFrame failed: interactor is not associated with a simulated render window");
+    return false;
+  }
+
+  int numberOfRecords = this->Reader->GetNumberOfFrameRecords(frameIndex);
+  for (int recordIndex = 0; recordIndex < numberOfRecords; ++recordIndex)
+  {
+    const vtkVirtualRealityPoseTraceRecord* record = this->Reader->GetFrameRecord(frameIndex, recordIndex);
+    switch (record->Type)
+    {
+      case vtkVirtualRealityPoseTraceRecord::DevicePoseRecordType:
+        vtkVirtualRealityPoseTraceReader::GetRecordMatrix(record, this->Matrix);
+        renderWindow->SetDeviceToPhysicalMatrix(
+          record->DeviceHandle, static_cast<vtkEventDataDevice>(record->Device), this->Matrix);
+        break;
+      case vtkVirtualRealityPoseTraceRecord::PhysicalToWorldRecordType:
+        vtkVirtualRealityPoseTraceReader::GetRecordMatrix(record, this->Matrix);
+        renderWindow->SetPhysicalToWorldMatrix(this->Matrix);
+        break;
+      case vtkVirtualRealityPoseTraceRecord::EventRecordType:
+        this->Interactor->QueueDevice3DEvent(record->EventId,
+          static_cast<vtkEventDataDevice>(record->Device),
+          static_cast<vtkEventDataDeviceInput>(record->Input),
+          static_cast<vtkEventDataAction>(record->Action),
+          record->Values[0], record->Values[1]);
+        break;
+      default:
+        break;
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityPoseTracePlayer::ProcessEvents(vtkObject* vtkNotUsed(caller),
+  unsigned long vtkNotUsed(event), void* clientData, void* vtkNotUsed(callData))
+{
+  vtkVirtualRealityPoseTracePlayer* self = reinterpret_cast<vtkVirtualRealityPoseTracePlayer*>(clientData);
+  if (!self->Playing)
+  {
+    return;
+  }
+  if (!self->ApplyFrame(self->CurrentFrame))
+  {
+    self->Stop();
+    return;
+  }
+  self->CurrentFrame++;
+  if (self->CurrentFrame >= self->Reader->GetNumberOfFrames())
+  {
+    if (self->Loop)
+    {
+      self->CurrentFrame = 0;
+    }
+    else
+    {
+      self->Stop();
+      self->InvokeEvent(vtkCommand::EndEvent);
+    }
+  }
+}
@@ -0,0 +1,102 @@
+/*==============================================================================
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#ifndef vtkVirtualRealityPoseTracePlayer_h
+#define vtkVirtualRealityPoseTracePlayer_h
+
+// VR MRMLDM includes
+#include "vtkSlicerVirtualRealityModuleMRMLDisplayableManagerExport.h"
+
+// VTK includes
+#include <vtkNew.h>
+#include <vtkObject.h>
+#include <vtkWeakPointer.h>
+
+class vtkCallbackCommand;
+class vtkMatrix4x4;
+class vtkVirtualRealityPoseTraceReader;
+class vtkVirtualRealityViewSimulatedInteractor;
+
+/// \brief Replay a pose trace through the interactor of the simulated XR backend.
+///
+/// While playing, one recorded frame is applied each time the interactor processes
+/// a frame (see vtkVirtualRealityViewSimulatedInteractor::UpdateDevicesEvent): device poses and
+/// physical-to-world matrix are set on the render window and recorded events are queued.
+/// Replay is therefore deterministic and does not depend on the recorded timestamps.
+///
+/// vtkCommand::EndEvent is invoked when the last frame has been applied.
+///
+/// \sa vtkVirtualRealityPoseTraceWriter
+class VTK_SLICER_VIRTUALREALITY_MODULE_MRMLDISPLAYABLEMANAGER_EXPORT vtkVirtualRealityPoseTracePlayer : public vtkObject
+{
+public:
+  static vtkVirtualRealityPoseTracePlayer* New();
+  vtkTypeMacro(vtkVirtualRealityPoseTracePlayer, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /// Load a trace file. Returns false if the file cannot be read.
+  bool Load(const char* fileName);
+
+  /// Reader holding the loaded trace.
+  vtkVirtualRealityPoseTraceReader* GetReader();
+
+  ///@{
+  /// Interactor the trace is replayed through.
+  void SetInteractor(vtkVirtualRealityViewSimulatedInteractor* interactor);
+  vtkVirtualRealityViewSimulatedInteractor* GetInteractor();
+  ///}@
+
+  ///@{
+  /// Restart from the first frame after the last one. Default is off.
+  vtkSetMacro(Loop, bool);
+  vtkGetMacro(Loop, bool);
+  vtkBooleanMacro(Loop, bool);
+  ///}@
+
+  ///@{
+  /// Start or stop applying frames. Play starts from the first frame.
+  void Play();
+  void Stop();
+  vtkGetMacro(Playing, bool);
+  ///}@
+
+  /// Index of the next frame to be applied.
+  vtkGetMacro(CurrentFrame, int);
+
+  /// Apply a recorded frame to the render window and interactor.
+  /// Returns false if the frame index is invalid or no simulated render window is available.
+  bool ApplyFrame(int frameIndex);
+
+protected:
+  vtkVirtualRealityPoseTracePlayer();
+  ~vtkVirtualRealityPoseTracePlayer() override;
+
+  static void ProcessEvents(vtkObject* caller, unsigned long event, void* clientData, void* callData);
+
+  vtkNew<vtkVirtualRealityPoseTraceReader> Reader;
+  vtkWeakPointer<vtkVirtualRealityViewSimulatedInteractor> Interactor;
+  vtkNew<vtkCallbackCommand> CallbackCommand;
+  vtkNew<vtkMatrix4x4> Matrix;
+
+  bool Loop{false};
+  bool Playing{false};
+  int CurrentFrame{0};
+
+private:
+  vtkVirtualRealityPoseTracePlayer(const vtkVirtualRealityPoseTracePlayer&) = delete;
+  void operator=(const vtkVirtualRealityPoseTracePlayer&) = delete;
+};
+
+#endif
@@ -0,0 +1,85 @@
+/*==============================================================================
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// VR MRMLDM includes
+#include "vtkVirtualRealitySimulatedCamera.h"
+
+// VTK Rendering/VR includes
+#include <vtkVRRenderWindow.h>
+
+// VTK includes
+#include <vtkMatrix3x3.h>
+#include <vtkMatrix4x4.h>
+#include <vtkObjectFactory.h>
+#include <vtkRenderer.h>
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkVirtualRealitySimulatedCamera);
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealitySimulatedCamera::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealitySimulatedCamera::GetKeyMatrices(vtkRenderer* ren, vtkMatrix4x4*& wcvc,
+  vtkMatrix3x3*& normMat, vtkMatrix4x4*& vcdc, vtkMatrix4x4*& wcdc)
+{
+  this->vtkOpenGLCamera::GetKeyMatrices(ren, wcvc, normMat, vcdc, wcdc);
+  // Key matrices are recomputed when the camera or the renderer are modified
+  if (this->EyeMatricesTime < this->KeyMatrixTime)
+  {
+    this->UpdateWorldToEyeMatrices(ren);
+    this->UpdateEyeToProjectionMatrices(ren);
+    this->EyeMatricesTime.Modified();
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealitySimulatedCamera::Render(vtkRenderer* ren)
+{
+  this->vtkOpenGLCamera::Render(ren);
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealitySimulatedCamera::UpdateWorldToEyeMatrices(vtkRenderer* ren)
+{
+  this->WorldToLeftEyeMatrix->DeepCopy(this->GetModelViewTransformMatrix());
+
+  vtkVRRenderWindow* renderWindow = vtkVRRenderWindow::SafeDownCast(ren->GetRenderWindow());
+  if (renderWindow != nullptr)
+  {
+    renderWindow->GetPhysicalToWorldMatrix(this->PhysicalToWorldMatrix);
+  }
+  else
+  {
+    this->PhysicalToWorldMatrix->Identity();
+  }
+  vtkMatrix4x4::Multiply4x4(this->WorldToLeftEyeMatrix, this->PhysicalToWorldMatrix, this->PhysicalToLeftEyeMatrix);
+
+  this->WorldToLeftEyeMatrix->Transpose();
+  this->PhysicalToLeftEyeMatrix->Transpose();
+  this->WorldToRightEyeMatrix->DeepCopy(this->WorldToLeftEyeMatrix);
+  this->PhysicalToRightEyeMatrix->DeepCopy(this->PhysicalToLeftEyeMatrix);
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealitySimulatedCamera::UpdateEyeToProjectionMatrices(vtkRenderer* ren)
+{
+  this->LeftEyeToProjectionMatrix->DeepCopy(this->GetProjectionTransformMatrix(ren->GetTiledAspectRatio(), -1, 1));
+  this->LeftEyeToProjectionMatrix->Transpose();
+  this->RightEyeToProjectionMatrix->DeepCopy(this->LeftEyeToProjectionMatrix);
+}
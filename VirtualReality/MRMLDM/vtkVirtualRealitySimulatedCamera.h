@@ -0,0 +1,72 @@
+/*==============================================================================
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#ifndef vtkVirtualRealitySimulatedCamera_h
+#define vtkVirtualRealitySimulatedCamera_h
+
+// VR MRMLDM includes
+#include "vtkSlicerVirtualRealityModuleMRMLDisplayableManagerExport.h"
+
+// VTK Rendering/VR includes
+#include <vtkVRCamera.h>
+
+// VTK includes
+#include <vtkNew.h>
+#include <vtkTimeStamp.h>
+
+class vtkMatrix3x3;
+class vtkMatrix4x4;
+
+/// \brief VR camera of the simulated XR backend.
+///
+/// Rendering is monoscopic, the camera uses the regular OpenGL camera matrices and renders
+/// into the viewport of the renderer. Both eye matrices are set from these matrices, so that
+/// GetPhysicalToProjectionMatrix() is consistent with the rendered image.
+/// Its position and orientation are set from the simulated HMD pose by
+/// vtkVirtualRealitySimulatedRenderWindow::UpdateCameraFromHMDPose().
+class VTK_SLICER_VIRTUALREALITY_MODULE_MRMLDISPLAYABLEMANAGER_EXPORT vtkVirtualRealitySimulatedCamera
+  : public vtkVRCamera
+{
+public:
+  static vtkVirtualRealitySimulatedCamera* New();
+  vtkTypeMacro(vtkVirtualRealitySimulatedCamera, vtkVRCamera);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /// Get the regular camera matrices, and update the eye matrices if they changed.
+  void GetKeyMatrices(vtkRenderer* ren, vtkMatrix4x4*& wcvc, vtkMatrix3x3*& normMat,
+    vtkMatrix4x4*& vcdc, vtkMatrix4x4*& wcdc) override;
+
+  /// Render into the viewport of the renderer, as a regular camera.
+  void Render(vtkRenderer* ren) override;
+
+protected:
+  vtkVirtualRealitySimulatedCamera() = default;
+  ~vtkVirtualRealitySimulatedCamera() override = default;
+
+  ///@{
+  /// Both eyes are at the camera position. Matrices are stored transposed, as in vtkOpenGLCamera.
+  void UpdateWorldToEyeMatrices(vtkRenderer* ren) override;
+  void UpdateEyeToProjectionMatrices(vtkRenderer* ren) override;
+  ///@}
+
+  vtkNew<vtkMatrix4x4> PhysicalToWorldMatrix;
+  vtkTimeStamp EyeMatricesTime;
+
+private:
+  vtkVirtualRealitySimulatedCamera(const vtkVirtualRealitySimulatedCamera&) = delete;
+  void operator=(const vtkVirtualRealitySimulatedCamera&) = delete;
+};
+
+#endif
@@ -0,0 +1,239 @@
+/*==============================================================================
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// VR MRMLDM includes
+#include "vtkVirtualRealitySimulatedRenderWindow.h"
+#include "vtkVirtualRealityViewSimulatedInteractor.h"
+
+// VTK includes
+#include <vtkCamera.h>
+#include <vtkMath.h>
+#include <vtkObjectFactory.h>
+#include <vtkOpenGLState.h>
+#include <vtkRenderer.h>
+#include <vtkRendererCollection.h>
+#if __has_include(<vtk_glad.h>)
+#include <vtk_glad.h>
+#else
+#include <vtk_glew.h>
+#endif
+
+// STD includes
+#include <algorithm>
+#include <atomic>
+
+namespace
+{
+  std::atomic<int> NumberOfFailingInitializations{0};
+}
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkVirtualRealitySimulatedRenderWindow);
+
+//----------------------------------------------------------------------------
+vtkVirtualRealitySimulatedRenderWindow::vtkVirtualRealitySimulatedRenderWindow()
+{
+  // Monoscopic rendering into a single eye framebuffer, see CreateFramebuffers()
+  this->StereoRender = 0;
+}
+
+//----------------------------------------------------------------------------
+vtkVirtualRealitySimulatedRenderWindow::~vtkVirtualRealitySimulatedRenderWindow() = default;
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealitySimulatedRenderWindow::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "EyeRenderSize: " << this->EyeRenderSize[0] << " " << this->EyeRenderSize[1] << "\n";
+  os << indent << "RenderScale: " << this->RenderScale << "\n";
+}
+
+//----------------------------------------------------------------------------
+vtkRenderWindowInteractor* vtkVirtualRealitySimulatedRenderWindow::MakeRenderWindowInteractor()
+{
+  this->Interactor = vtkVirtualRealityViewSimulatedInteractor::New();
+  this->Interactor->SetRenderWindow(this);
+  return this->Interactor;
+}
+
+//----------------------------------------------------------------------------
+bool vtkVirtualRealitySimulatedRenderWindow::GetSizeFromAPI()
+{
+  this->Size[0] = this->EyeRenderSize[0];
+  this->Size[1] = this->EyeRenderSize[1];
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool vtkVirtualRealitySimulatedRenderWindow::CreateFramebuffers(uint32_t vtkNotUsed(viewCount))
+{
+  this->EyeFramebuffer->SetContext(this);
+  if (!this->EyeFramebuffer->PopulateFramebuffer(this->EyeRenderSize[0], this->EyeRenderSize[1],
+    /* useTextures */ true, /* numberOfColorAttachments */ 1, VTK_UNSIGNED_CHAR,
+    /* wantDepthAttachment */ false, /* depthBitplanes */ 0, /* multisamples */ 0))
+  {
+    vtkErrorMacro("CreateFramebuffers failed: unable to create the eye framebuffer");
+    return false;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+vtkOpenGLFramebufferObject* vtkVirtualRealitySimulatedRenderWindow::GetEyeFramebuffer()
+{
+  return this->EyeFramebuffer;
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealitySimulatedRenderWindow::Frame()
+{
+  if (this->VRInitialized && this->EyeFramebuffer->GetFBOIndex() != 0)
+  {
+    // Copy the rendered frame, as other backends do before submitting it to the headset
+    vtkOpenGLState* state = this->GetState();
+    state->PushFramebufferBindings();
+    if (this->GetRenderFramebuffer() != nullptr)
+    {
+      this->GetRenderFramebuffer()->Bind(GL_READ_FRAMEBUFFER);
+    }
+    this->EyeFramebuffer->Bind(GL_DRAW_FRAMEBUFFER);
+    state->vtkglBlitFramebuffer(0, 0, this->EyeRenderSize[0], this->EyeRenderSize[1],
+      0, 0, this->EyeRenderSize[0], this->EyeRenderSize[1], GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    state->PopFramebufferBindings();
+  }
+  this->Superclass::Frame();
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealitySimulatedRenderWindow::ReleaseGraphicsResources(vtkWindow* renWin)
+{
+  this->EyeFramebuffer->ReleaseGraphicsResources(renWin);
+  this->Superclass::ReleaseGraphicsResources(renWin);
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealitySimulatedRenderWindow::SetNumberOfFailingInitializations(int count)
+{
+  NumberOfFailingInitializations = std::max(count, 0);
+}
+
+//----------------------------------------------------------------------------
+int vtkVirtualRealitySimulatedRenderWindow::GetNumberOfFailingInitializations()
+{
+  return NumberOfFailingInitializations;
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealitySimulatedRenderWindow::Initialize()
+{
+  if (this->VRInitialized)
+  {
+    return;
+  }
+  if (NumberOfFailingInitializations > 0)
+  {
+    // Simulated runtime is not ready, VRInitialized is left unset
+    NumberOfFailingInitializations--;
+    return;
+  }
+  if (this->HelperWindow != nullptr)
+  {
+    // There is no headset to present to, the helper window only provides the OpenGL context
+    this->HelperWindow->SetShowWindow(false);
+    this->HelperWindow->SetOffScreenRendering(1);
+  }
+  this->StereoRender = 0;
+  this->Superclass::Initialize();
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealitySimulatedRenderWindow::Render()
+{
+  // Only render into the scaled part of the window
+  vtkRenderer* renderer = nullptr;
+  vtkCollectionSimpleIterator it;
+  for (this->Renderers->InitTraversal(it); (renderer = this->Renderers->GetNextRenderer(it));)
+  {
+    double* viewport = renderer->GetViewport();
+    if (viewport[2] != this->RenderScale || viewport[3] != this->RenderScale)
+    {
+      renderer->SetViewport(0.0, 0.0, this->RenderScale, this->RenderScale);
+    }
+  }
+  this->UpdateCameraFromHMDPose();
+  this->Superclass::Render();
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealitySimulatedRenderWindow::SetDeviceToPhysicalMatrix(
+  uint32_t deviceHandle, vtkEventDataDevice device, vtkMatrix4x4* deviceToPhysicalMatrix)
+{
+  if (deviceToPhysicalMatrix == nullptr)
+  {
+    vtkErrorMacro("SetDeviceToPhysicalMatrix failed: invalid matrix");
+    return;
+  }
+  vtkMatrix4x4* pose = this->GetDeviceToPhysicalMatrixForDeviceHandle(deviceHandle);
+  if (pose == nullptr)
+  {
+    this->AddDeviceHandle(deviceHandle, device);
+    pose = this->GetDeviceToPhysicalMatrixForDeviceHandle(deviceHandle);
+  }
+  if (pose == nullptr)
+  {
+    vtkErrorMacro("SetDeviceToPhysicalMatrix failed: unable to register device handle " << deviceHandle);
+    return;
+  }
+  pose->DeepCopy(deviceToPhysicalMatrix);
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealitySimulatedRenderWindow::UpdateCameraFromHMDPose()
+{
+  vtkMatrix4x4* hmdToPhysicalMatrix = this->GetDeviceToPhysicalMatrixForDeviceHandle(HMDDeviceHandle);
+  vtkRenderer* renderer = vtkRenderer::SafeDownCast(this->GetRenderers()->GetItemAsObject(0));
+  if (hmdToPhysicalMatrix == nullptr || renderer == nullptr)
+  {
+    return;
+  }
+  vtkCamera* camera = renderer->GetActiveCamera();
+
+  this->GetPhysicalToWorldMatrix(this->PhysicalToWorldMatrix);
+  vtkMatrix4x4::Multiply4x4(this->PhysicalToWorldMatrix, hmdToPhysicalMatrix, this->HMDToWorldMatrix);
+
+  // HMD looks along its -Z axis, with +Y axis up
+  double position[3] = { 0.0, 0.0, 0.0 };
+  double direction[3] = { 0.0, 0.0, 0.0 };
+  double viewUp[3] = { 0.0, 0.0, 0.0 };
+  for (int i = 0; i < 3; ++i)
+  {
+    position[i] = this->HMDToWorldMatrix->GetElement(i, 3);
+    direction[i] = -this->HMDToWorldMatrix->GetElement(i, 2);
+    viewUp[i] = this->HMDToWorldMatrix->GetElement(i, 1);
+  }
+  vtkMath::Normalize(direction);
+  vtkMath::Normalize(viewUp);
+
+  // Keep focal point at 1 m (in physical space) in front of the HMD
+  double focalDistance = this->GetPhysicalScale();
+  camera->SetPosition(position);
+  camera->SetFocalPoint(
+    position[0] + focalDistance * direction[0],
+    position[1] + focalDistance * direction[1],
+    position[2] + focalDistance * direction[2]);
+  camera->SetViewUp(viewUp);
+
+  renderer->ResetCameraClippingRange();
+}
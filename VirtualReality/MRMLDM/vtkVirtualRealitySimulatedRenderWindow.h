@@ -0,0 +1,125 @@
+/*==============================================================================
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#ifndef vtkVirtualRealitySimulatedRenderWindow_h
+#define vtkVirtualRealitySimulatedRenderWindow_h
+
+// VR MRMLDM includes
+#include "vtkSlicerVirtualRealityModuleMRMLDisplayableManagerExport.h"
+
+// VTK Rendering/VR includes
+#include <vtkVRRenderWindow.h>
+
+// VTK includes
+#include <vtkEventData.h>
+#include <vtkMatrix4x4.h>
+#include <vtkNew.h>
+#include <vtkOpenGLFramebufferObject.h>
+
+/// \brief VR render window of the simulated XR backend.
+///
+/// The simulated backend does not require any XR runtime or headset. Scene is
+/// rendered offscreen (monoscopic) from the point of view of the simulated HMD, and
+/// the device poses are set programmatically, typically by the simulated interactor
+/// from a scripted or recorded source.
+///
+/// As other XR backends copy each frame into the framebuffers submitted to the headset,
+/// each rendered frame is copied into the eye framebuffer, see GetEyeFramebuffer().
+///
+/// Rendering uses whatever OpenGL implementation VTK is configured with. On machines without
+/// GPU, a software implementation may be selected (e.g `LIBGL_ALWAYS_SOFTWARE=1` with Mesa).
+///
+/// \sa vtkVirtualRealityViewSimulatedInteractor
+class VTK_SLICER_VIRTUALREALITY_MODULE_MRMLDISPLAYABLEMANAGER_EXPORT vtkVirtualRealitySimulatedRenderWindow
+  : public vtkVRRenderWindow
+{
+public:
+  static vtkVirtualRealitySimulatedRenderWindow* New();
+  vtkTypeMacro(vtkVirtualRealitySimulatedRenderWindow, vtkVRRenderWindow);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  /// Device handles associated with the simulated devices.
+  /// Generic trackers use handles starting at FirstTrackerDeviceHandle.
+  enum DeviceHandles
+  {
+    HMDDeviceHandle = 0,
+    LeftControllerDeviceHandle = 1,
+    RightControllerDeviceHandle = 2,
+    FirstTrackerDeviceHandle = 3
+  };
+
+  ///@{
+  /// Size of the image rendered for the simulated headset. Default is 512x512.
+  /// Must be set before the window is initialized.
+  vtkSetVector2Macro(EyeRenderSize, int);
+  vtkGetVector2Macro(EyeRenderSize, int);
+  ///}@
+
+  ///@{
+  /// Fraction of EyeRenderSize used for rendering, along each axis.
+  /// The scene is rendered into the lower-left part of the window. Default is 1.0.
+  vtkSetClampMacro(RenderScale, double, 0.1, 1.0);
+  vtkGetMacro(RenderScale, double);
+  ///}@
+
+  ///@{
+  /// Number of next initializations of simulated render windows that fail, as if the XR
+  /// runtime was not ready. Used for testing connection error handling. Default is 0.
+  static void SetNumberOfFailingInitializations(int count);
+  static int GetNumberOfFailingInitializations();
+  ///}@
+
+  /// Set the pose of a simulated device.
+  /// The device handle is registered the first time its pose is set.
+  void SetDeviceToPhysicalMatrix(uint32_t deviceHandle, vtkEventDataDevice device, vtkMatrix4x4* deviceToPhysicalMatrix);
+
+  /// Update position and orientation of the active camera from the simulated HMD pose.
+  void UpdateCameraFromHMDPose();
+
+  /// Framebuffer holding the last rendered frame, with a single color texture of EyeRenderSize.
+  /// It is created when the window is initialized.
+  vtkOpenGLFramebufferObject* GetEyeFramebuffer();
+
+  void Initialize() override;
+  void Render() override;
+  void Frame() override;
+  void ReleaseGraphicsResources(vtkWindow* renWin) override;
+  vtkRenderWindowInteractor* MakeRenderWindowInteractor() override;
+
+  /// Simulated devices do not have models.
+  void RenderModels() override {}
+
+protected:
+  vtkVirtualRealitySimulatedRenderWindow();
+  ~vtkVirtualRealitySimulatedRenderWindow() override;
+
+  bool GetSizeFromAPI() override;
+
+  /// Rendering is monoscopic, a single eye framebuffer is created whatever the view count.
+  bool CreateFramebuffers(uint32_t viewCount = 2) override;
+
+  int EyeRenderSize[2]{512, 512};
+  double RenderScale{1.0};
+
+  vtkNew<vtkMatrix4x4> PhysicalToWorldMatrix;
+  vtkNew<vtkMatrix4x4> HMDToWorldMatrix;
+  vtkNew<vtkOpenGLFramebufferObject> EyeFramebuffer;
+
+private:
+  vtkVirtualRealitySimulatedRenderWindow(const vtkVirtualRealitySimulatedRenderWindow&) = delete;
+  void operator=(const vtkVirtualRealitySimulatedRenderWindow&) = delete;
+};
+
+#endif
@@ -0,0 +1,32 @@
+/*==============================================================================
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// VR MRMLDM includes
+#include "vtkVirtualRealitySimulatedCamera.h"
+#include "vtkVirtualRealitySimulatedRenderer.h"
+
+// VTK includes
+#include <vtkObjectFactory.h>
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkVirtualRealitySimulatedRenderer);
+
+//----------------------------------------------------------------------------
+vtkCamera* vtkVirtualRealitySimulatedRenderer::MakeCamera()
+{
+  vtkCamera* camera = vtkVirtualRealitySimulatedCamera::New();
+  this->InvokeEvent(vtkCommand::CreateCameraEvent, camera);
+  return camera;
+}
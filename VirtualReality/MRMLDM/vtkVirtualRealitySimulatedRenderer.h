@@ -0,0 +1,47 @@
+/*==============================================================================
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#ifndef vtkVirtualRealitySimulatedRenderer_h
+#define vtkVirtualRealitySimulatedRenderer_h
+
+// VR MRMLDM includes
+#include "vtkSlicerVirtualRealityModuleMRMLDisplayableManagerExport.h"
+
+// VTK Rendering/VR includes
+#include <vtkVRRenderer.h>
+
+/// \brief VR renderer of the simulated XR backend.
+///
+/// \sa vtkVirtualRealitySimulatedCamera
+class VTK_SLICER_VIRTUALREALITY_MODULE_MRMLDISPLAYABLEMANAGER_EXPORT vtkVirtualRealitySimulatedRenderer
+  : public vtkVRRenderer
+{
+public:
+  static vtkVirtualRealitySimulatedRenderer* New();
+  vtkTypeMacro(vtkVirtualRealitySimulatedRenderer, vtkVRRenderer);
+
+  /// Create a vtkVirtualRealitySimulatedCamera.
+  vtkCamera* MakeCamera() override;
+
+protected:
+  vtkVirtualRealitySimulatedRenderer() = default;
+  ~vtkVirtualRealitySimulatedRenderer() override = default;
+
+private:
+  vtkVirtualRealitySimulatedRenderer(const vtkVirtualRealitySimulatedRenderer&) = delete;
+  void operator=(const vtkVirtualRealitySimulatedRenderer&) = delete;
+};
+
+#endif
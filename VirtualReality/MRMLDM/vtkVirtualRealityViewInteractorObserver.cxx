@@ -36,6 +36,10 @@
 #include <vtkMRML.h> // For MRML_APPLICATION_VERSION and MRML_VERSION_CHECK
 #include <vtkMRMLInteractionEventData.h>
 
+// MRMLDisplayableManager includes
+#include <vtkMRMLAbstractDisplayableManager.h>
+#include <vtkMRMLDisplayableManagerGroup.h>
+
 // VTK Rendering/VR includes
 #include <vtkVRRenderWindowInteractor.h>
 
@@ -43,9 +47,13 @@
 #include <vtkCallbackCommand.h>
 #include <vtkEventData.h>
 #include <vtkInteractorStyle.h>
+#include <vtkRenderWindow.h>
 #include <vtkRenderWindowInteractor.h>
 #include <vtkObjectFactory.h>
 
+// STD includes
+#include <algorithm>
+
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkVirtualRealityViewInteractorObserver);
 
@@ -56,17 +64,49 @@ vtkStandardNewMacro(vtkVirtualRealityViewInteractorObserver);
 vtkVirtualRealityViewInteractorObserver::vtkVirtualRealityViewInteractorObserver()
 {
   this->EventCallbackCommand->SetCallback(vtkVirtualRealityViewInteractorObserver::CustomProcessEvents);
+
+  this->RenderWindowCallbackCommand->SetClientData(this);
+  this->RenderWindowCallbackCommand->SetCallback(vtkVirtualRealityViewInteractorObserver::ProcessRenderWindowEvents);
+
+  for (int deviceIndex = 0; deviceIndex < vtkEventDataNumberOfDevices; ++deviceIndex)
+    {
+    this->PendingMove3DEvents[deviceIndex] = vtkSmartPointer<vtkEventDataDevice3D>::New();
+    this->PendingMove3DEventExists[deviceIndex] = false;
+    this->LastMove3DEventDelegated[deviceIndex] = false;
+    this->PendingMove3DEventAborted[deviceIndex] = false;
+    }
+
+  // Displayable managers that only display nodes do not process interaction events
+  this->RemoveAllDisplayableManagerSubscriptions("vtkMRMLModelDisplayableManager");
+  this->RemoveAllDisplayableManagerSubscriptions("vtkMRMLSegmentationsDisplayableManager3D");
+  this->RemoveAllDisplayableManagerSubscriptions("vtkMRMLVolumeRenderingDisplayableManager");
 }
 
 //----------------------------------------------------------------------------
 vtkVirtualRealityViewInteractorObserver::~vtkVirtualRealityViewInteractorObserver()
 {
+  if (this->ObservedRenderWindow)
+    {
+    this->ObservedRenderWindow->RemoveObserver(this->RenderWindowCallbackCommand);
+    }
 }
 
 //----------------------------------------------------------------------------
 void vtkVirtualRealityViewInteractorObserver::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os,indent);
+  os << indent << "Move3DEventCoalescing: " << this->Move3DEventCoalescing << "\n";
+  os << indent << "NumberOfCoalescedMove3DEvents: " << this->NumberOfCoalescedMove3DEvents << "\n";
+  os << indent << "DisplayableManagerSubscriptions:\n";
+  for (const auto& classSubscriptions : this->DisplayableManagerSubscriptions)
+    {
+    os << indent.GetNextIndent() << classSubscriptions.first << ":";
+    for (const std::pair<unsigned long, int>& subscription : classSubscriptions.second)
+      {
+      os << " " << vtkCommand::GetStringFromEventId(subscription.first) << "(" << subscription.second << ")";
+      }
+    os << "\n";
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -107,13 +147,205 @@ void vtkVirtualRealityViewInteractorObserver::CustomProcessEvents(vtkObject* obj
   vtkVirtualRealityViewInteractorObserver* self
     = reinterpret_cast<vtkVirtualRealityViewInteractorObserver *>(clientdata);
 
-  if (!self->DelegateInteractionEventToDisplayableManagers(event, calldata))
+  if (event == vtkCommand::Move3DEvent)
+    {
+    int deviceIndex = self->DeferMove3DEvent(static_cast<vtkEventData*>(calldata));
+    if (deviceIndex >= 0)
+      {
+      // See ProcessPendingMove3DEvents() if the move is finally not processed by displayable managers
+      self->PendingMove3DEventAborted[deviceIndex] = self->LastMove3DEventDelegated[deviceIndex];
+      if (self->LastMove3DEventDelegated[deviceIndex])
+        {
+        self->EventCallbackCommand->SetAbortFlag(1);
+        }
+      else
+        {
+        vtkVirtualRealityViewInteractorObserver::ProcessEvents(object, event, clientdata, calldata);
+        }
+      return;
+      }
+    }
+
+  // Displayable managers must receive the pending moves before any other event
+  self->ProcessPendingMove3DEvents();
+
+  bool delegated = self->DelegateInteractionEventToDisplayableManagers(event, calldata);
+  if (event == vtkCommand::Move3DEvent)
+    {
+    vtkEventDataDevice3D* edd = static_cast<vtkEventData*>(calldata)->GetAsEventDataDevice3D();
+    int deviceIndex = edd ? static_cast<int>(edd->GetDevice()) : -1;
+    if (deviceIndex >= 0 && deviceIndex < vtkEventDataNumberOfDevices)
+      {
+      self->LastMove3DEventDelegated[deviceIndex] = delegated;
+      }
+    }
+  if (!delegated)
     {
     // Displayable managers did not process it
     vtkVirtualRealityViewInteractorObserver::ProcessEvents(object, event, clientdata, calldata);
     }
 }
 
+//----------------------------------------------------------------------------
+// Move3D event coalescing
+//----------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityViewInteractorObserver::AddFullRateMove3DEventRequester(vtkObject* requester, int device/*=-1*/)
+{
+  if (requester == nullptr)
+    {
+    return;
+    }
+  for (const std::pair<vtkWeakPointer<vtkObject>, int>& existingRequest : this->FullRateMove3DEventRequesters)
+    {
+    if (existingRequest.first == requester && existingRequest.second == device)
+      {
+      return;
+      }
+    }
+  this->FullRateMove3DEventRequesters.emplace_back(requester, device);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityViewInteractorObserver::RemoveFullRateMove3DEventRequester(vtkObject* requester)
+{
+  size_t numberOfRequests = this->FullRateMove3DEventRequesters.size();
+  // Requests of requesters that were deleted are removed as well
+  this->FullRateMove3DEventRequesters.erase(
+    std::remove_if(this->FullRateMove3DEventRequesters.begin(), this->FullRateMove3DEventRequesters.end(),
+      [requester](const std::pair<vtkWeakPointer<vtkObject>, int>& request)
+      {
+        return request.first == nullptr || request.first == requester;
+      }),
+    this->FullRateMove3DEventRequesters.end());
+  if (this->FullRateMove3DEventRequesters.size() != numberOfRequests)
+    {
+    this->Modified();
+    }
+}
+
+//----------------------------------------------------------------------------
+bool vtkVirtualRealityViewInteractorObserver::HasFullRateMove3DEventRequester(int device)
+{
+  // Requesters that were deleted are ignored
+  for (const std::pair<vtkWeakPointer<vtkObject>, int>& request : this->FullRateMove3DEventRequesters)
+    {
+    if (request.first != nullptr && (request.second == -1 || request.second == device))
+      {
+      return true;
+      }
+    }
+  return false;
+}
+
+//----------------------------------------------------------------------------
+int vtkVirtualRealityViewInteractorObserver::DeferMove3DEvent(vtkEventData* eventData)
+{
+  if (!this->Move3DEventCoalescing)
+    {
+    return -1;
+    }
+  vtkEventDataDevice3D* edd = eventData ? eventData->GetAsEventDataDevice3D() : nullptr;
+  if (edd == nullptr)
+    {
+    return -1;
+    }
+  int deviceIndex = static_cast<int>(edd->GetDevice());
+  if (deviceIndex < 0 || deviceIndex >= vtkEventDataNumberOfDevices
+    || this->HasFullRateMove3DEventRequester(deviceIndex))
+    {
+    return -1;
+    }
+  // Pending moves are delegated before rendering, they cannot be deferred without a render window
+  if (!this->ObserveRenderWindow())
+    {
+    return -1;
+    }
+
+  if (this->PendingMove3DEventExists[deviceIndex])
+    {
+    ++this->NumberOfCoalescedMove3DEvents;
+    }
+  this->PendingMove3DEventExists[deviceIndex] = true;
+
+  // The event data is owned by the interactor, keep a copy
+  vtkEventDataDevice3D* pendingEvent = this->PendingMove3DEvents[deviceIndex];
+  pendingEvent->SetType(edd->GetType());
+  pendingEvent->SetDevice(edd->GetDevice());
+  pendingEvent->SetInput(edd->GetInput());
+  pendingEvent->SetAction(edd->GetAction());
+  double values[4] = { 0.0, 0.0, 0.0, 0.0 };
+  edd->GetWorldPosition(values);
+  pendingEvent->SetWorldPosition(values);
+  edd->GetWorldOrientation(values);
+  pendingEvent->SetWorldOrientation(values);
+  edd->GetWorldDirection(values);
+  pendingEvent->SetWorldDirection(values);
+  edd->GetTrackPadPosition(values);
+  pendingEvent->SetTrackPadPosition(values[0], values[1]);
+
+  return deviceIndex;
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityViewInteractorObserver::ProcessPendingMove3DEvents()
+{
+  // Displayable managers may render while processing the moves
+  if (this->ProcessingPendingMove3DEvents)
+    {
+    return;
+    }
+  this->ProcessingPendingMove3DEvents = true;
+  for (int deviceIndex = 0; deviceIndex < vtkEventDataNumberOfDevices; ++deviceIndex)
+    {
+    if (!this->PendingMove3DEventExists[deviceIndex])
+      {
+      continue;
+      }
+    this->PendingMove3DEventExists[deviceIndex] = false;
+    vtkEventDataDevice3D* pendingEvent = this->PendingMove3DEvents[deviceIndex];
+    bool delegated = this->DelegateInteractionEventToDisplayableManagers(pendingEvent);
+    this->LastMove3DEventDelegated[deviceIndex] = delegated;
+    if (!delegated && this->PendingMove3DEventAborted[deviceIndex] && this->GetInteractor())
+      {
+      // Interactor style did not process the move, assuming that displayable managers would
+      vtkVirtualRealityViewInteractorObserver::ProcessEvents(
+        this->GetInteractor(), vtkCommand::Move3DEvent, this, pendingEvent);
+      }
+    this->PendingMove3DEventAborted[deviceIndex] = false;
+    }
+  this->ProcessingPendingMove3DEvents = false;
+}
+
+//----------------------------------------------------------------------------
+bool vtkVirtualRealityViewInteractorObserver::ObserveRenderWindow()
+{
+  vtkRenderWindow* renderWindow = this->GetInteractor() ? this->GetInteractor()->GetRenderWindow() : nullptr;
+  if (renderWindow != this->ObservedRenderWindow)
+    {
+    if (this->ObservedRenderWindow)
+      {
+      this->ObservedRenderWindow->RemoveObserver(this->RenderWindowCallbackCommand);
+      }
+    this->ObservedRenderWindow = renderWindow;
+    if (this->ObservedRenderWindow)
+      {
+      this->ObservedRenderWindow->AddObserver(vtkCommand::StartEvent, this->RenderWindowCallbackCommand);
+      }
+    }
+  return this->ObservedRenderWindow != nullptr;
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityViewInteractorObserver::ProcessRenderWindowEvents(
+  vtkObject* vtkNotUsed(caller), unsigned long vtkNotUsed(event), void* clientData, void* vtkNotUsed(callData))
+{
+  vtkVirtualRealityViewInteractorObserver* self = reinterpret_cast<vtkVirtualRealityViewInteractorObserver*>(clientData);
+  self->ProcessPendingMove3DEvents();
+}
+
 //----------------------------------------------------------------------------
 void vtkVirtualRealityViewInteractorObserver::ProcessEvents(
   vtkObject* object, unsigned long event, void* clientdata, void* calldata)
@@ -257,7 +489,180 @@ bool vtkVirtualRealityViewInteractorObserver::DelegateInteractionEventDataToDisp
     }
   ed->SetInteractionContextName(interactionContextName);
 
-  return this->Superclass::DelegateInteractionEventDataToDisplayableManagers(ed);
+  return this->DelegateInteractionEventDataToSubscribedDisplayableManagers(ed);
+}
+
+//----------------------------------------------------------------------------
+// Displayable manager subscriptions
+//----------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityViewInteractorObserver::AddDisplayableManagerSubscription(
+  const char* className, unsigned long eventId, int device/*=-1*/)
+{
+  if (className == nullptr)
+    {
+    vtkErrorMacro("AddDisplayableManagerSubscription failed: invalid class name");
+    return;
+    }
+  this->DisplayableManagerSubscriptions[className].insert(std::make_pair(eventId, device));
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityViewInteractorObserver::RemoveAllDisplayableManagerSubscriptions(const char* className)
+{
+  if (className == nullptr)
+    {
+    vtkErrorMacro("RemoveAllDisplayableManagerSubscriptions failed: invalid class name");
+    return;
+    }
+  this->DisplayableManagerSubscriptions[className].clear();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityViewInteractorObserver::SetDisplayableManagerSubscribedToAllEvents(const char* className)
+{
+  if (className == nullptr)
+    {
+    vtkErrorMacro("SetDisplayableManagerSubscribedToAllEvents failed: invalid class name");
+    return;
+    }
+  this->DisplayableManagerSubscriptions.erase(className);
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+bool vtkVirtualRealityViewInteractorObserver::IsDisplayableManagerSubscribed(
+  const char* className, unsigned long eventId, int device)
+{
+  if (className == nullptr)
+    {
+    return false;
+    }
+  auto classSubscriptionsIt = this->DisplayableManagerSubscriptions.find(className);
+  if (classSubscriptionsIt == this->DisplayableManagerSubscriptions.end())
+    {
+    return true;
+    }
+  const std::set<std::pair<unsigned long, int>>& subscriptions = classSubscriptionsIt->second;
+  return subscriptions.count(std::make_pair(eventId, device)) > 0
+    || subscriptions.count(std::make_pair(eventId, static_cast<int>(vtkEventDataDevice::Any))) > 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityViewInteractorObserver::UpdateDisplayableManagerSubscriptionTable()
+{
+  this->SubscriptionTable.clear();
+  this->SubscriptionTableDisplayableManagers.clear();
+  this->SubscriptionTableGroup = this->GetDisplayableManagers();
+  if (!this->SubscriptionTableGroup)
+    {
+    return;
+    }
+  int numberOfDisplayableManagers = this->SubscriptionTableGroup->GetDisplayableManagerCount();
+  for (int index = 0; index < numberOfDisplayableManagers; ++index)
+    {
+    this->SubscriptionTableDisplayableManagers.emplace_back(
+      vtkMRMLAbstractDisplayableManager::SafeDownCast(this->SubscriptionTableGroup->GetNthDisplayableManager(index)));
+    }
+}
+
+//----------------------------------------------------------------------------
+const std::vector<vtkWeakPointer<vtkMRMLAbstractDisplayableManager>>&
+vtkVirtualRealityViewInteractorObserver::GetSubscribedDisplayableManagers(unsigned long eventId, int device)
+{
+  std::pair<unsigned long, int> key(eventId, device);
+  auto subscribedIt = this->SubscriptionTable.find(key);
+  if (subscribedIt != this->SubscriptionTable.end())
+    {
+    return subscribedIt->second;
+    }
+  // Subscribed displayable managers are listed in the order of the group
+  std::vector<vtkWeakPointer<vtkMRMLAbstractDisplayableManager>>& subscribed = this->SubscriptionTable[key];
+  for (const vtkWeakPointer<vtkMRMLAbstractDisplayableManager>& displayableManager : this->SubscriptionTableDisplayableManagers)
+    {
+    if (displayableManager && this->IsDisplayableManagerSubscribed(displayableManager->GetClassName(), eventId, device))
+      {
+      subscribed.push_back(displayableManager);
+      }
+    }
+  return subscribed;
+}
+
+//----------------------------------------------------------------------------
+int vtkVirtualRealityViewInteractorObserver::GetNumberOfSubscribedDisplayableManagers(unsigned long eventId, int device)
+{
+  int numberOfDisplayableManagers = 0;
+  for (const vtkWeakPointer<vtkMRMLAbstractDisplayableManager>& displayableManager :
+    this->GetSubscribedDisplayableManagers(eventId, device))
+    {
+    if (displayableManager)
+      {
+      ++numberOfDisplayableManagers;
+      }
+    }
+  return numberOfDisplayableManagers;
+}
+
+//----------------------------------------------------------------------------
+bool vtkVirtualRealityViewInteractorObserver::DelegateInteractionEventDataToSubscribedDisplayableManagers(
+  vtkMRMLInteractionEventData* eventData)
+{
+  vtkMRMLDisplayableManagerGroup* displayableManagers = this->GetDisplayableManagers();
+  if (!displayableManagers
+    || displayableManagers != this->SubscriptionTableGroup
+    || displayableManagers->GetDisplayableManagerCount() != static_cast<int>(this->SubscriptionTableDisplayableManagers.size()))
+    {
+    // Table is not up-to-date, offer the event to all displayable managers
+    return this->Superclass::DelegateInteractionEventDataToDisplayableManagers(eventData);
+    }
+
+  // The focused displayable manager keeps receiving events while it grabs the focus
+  vtkMRMLAbstractDisplayableManager* focusedDisplayableManager = this->FocusedDisplayableManager;
+  if (focusedDisplayableManager && focusedDisplayableManager->GetGrabFocus())
+    {
+    return focusedDisplayableManager->ProcessInteractionEvent(eventData);
+    }
+
+  // Find the closest subscribed displayable manager that can process the event
+  vtkMRMLAbstractDisplayableManager* closestDisplayableManager = nullptr;
+  double closestDistance2 = VTK_DOUBLE_MAX;
+  for (const vtkWeakPointer<vtkMRMLAbstractDisplayableManager>& displayableManager :
+    this->GetSubscribedDisplayableManagers(eventData->GetType(), static_cast<int>(eventData->GetDevice())))
+    {
+    double distance2 = VTK_DOUBLE_MAX;
+    if (displayableManager && displayableManager->CanProcessInteractionEvent(eventData, distance2)
+      && (!closestDisplayableManager || distance2 < closestDistance2))
+      {
+      closestDisplayableManager = displayableManager;
+      closestDistance2 = distance2;
+      }
+    }
+  if (!closestDisplayableManager)
+    {
+    // None of the displayable managers can process the event, the focused one loses the focus
+    if (focusedDisplayableManager)
+      {
+      focusedDisplayableManager->SetHasFocus(false, eventData);
+      this->FocusedDisplayableManager = nullptr;
+      }
+    return false;
+    }
+
+  // Notify displayable managers about focus change
+  if (focusedDisplayableManager != closestDisplayableManager)
+    {
+    if (focusedDisplayableManager)
+      {
+      focusedDisplayableManager->SetHasFocus(false, eventData);
+      }
+    this->FocusedDisplayableManager = closestDisplayableManager;
+    closestDisplayableManager->SetHasFocus(true, eventData);
+    }
+
+  return closestDisplayableManager->ProcessInteractionEvent(eventData);
 }
 
 //----------------------------------------------------------------------------
@@ -26,6 +26,23 @@ class vtkVirtualRealityViewInteractorStyleDelegate;
 // MRML includes
 #include <vtkMRMLViewInteractorStyle.h>
 
+// VTK includes
+#include <vtkCallbackCommand.h>
+#include <vtkEventData.h>
+#include <vtkNew.h>
+#include <vtkSmartPointer.h>
+#include <vtkWeakPointer.h>
+class vtkMRMLAbstractDisplayableManager;
+class vtkMRMLDisplayableManagerGroup;
+class vtkRenderWindow;
+
+// STD includes
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
 class VTK_SLICER_VIRTUALREALITY_MODULE_MRMLDISPLAYABLEMANAGER_EXPORT vtkVirtualRealityViewInteractorObserver
   : public vtkMRMLViewInteractorStyle
 {
@@ -81,10 +98,114 @@ public:
 
   vtkVirtualRealityViewInteractorStyleDelegate* GetInteractorStyleDelegate();
 
+  ///@{
+  /// Coalesce Move3D events before delegating them to displayable managers.
+  ///
+  /// Controllers may report several moves per frame. When enabled, only the latest Move3D event
+  /// of each device is delegated to displayable managers, when the render window starts rendering
+  /// or before any other event is delegated.
+  ///
+  /// Whether the interactor style processes a move is only known once the move is delegated. Until
+  /// then, it is assumed that displayable managers process the moves of a device if they processed
+  /// the last delegated one:
+  /// - if they did not, moves are processed by the interactor style without delay. If displayable
+  ///   managers then process the pending move, the style has processed moves it would not have seen
+  ///   without coalescing (e.g the first moves of a controller entering a widget).
+  /// - if they did, moves are not processed by the interactor style. If displayable managers then do
+  ///   not process the pending move, it is processed by the interactor style when it is delegated, so
+  ///   that the style is not one frame late (e.g the first move of a controller leaving a widget).
+  ///
+  /// Default is on.
+  vtkSetMacro(Move3DEventCoalescing, bool);
+  vtkGetMacro(Move3DEventCoalescing, bool);
+  vtkBooleanMacro(Move3DEventCoalescing, bool);
+  ///@}
+
+  ///@{
+  /// Objects (typically displayable managers) that need every Move3D event of a device may request
+  /// full-rate delegation. Move3D events of the device are not coalesced while a requester is registered.
+  /// Device is a vtkEventDataDevice value, vtkEventDataDevice::Any (-1) requests all devices.
+  /// Removing a requester removes its requests for all devices. Requesters are not kept alive.
+  void AddFullRateMove3DEventRequester(vtkObject* requester, int device = -1);
+  void RemoveFullRateMove3DEventRequester(vtkObject* requester);
+  bool HasFullRateMove3DEventRequester(int device);
+  ///@}
+
+  /// Delegate the pending Move3D events to displayable managers.
+  void ProcessPendingMove3DEvents();
+
+  /// Number of Move3D events replaced by a later move of the same device before being delegated.
+  vtkGetMacro(NumberOfCoalescedMove3DEvents, vtkTypeInt64);
+
+  ///@{
+  /// Event subscriptions of displayable managers, by displayable manager class name.
+  ///
+  /// Events are only offered to the displayable managers subscribed to the event type and device.
+  /// Displayable managers of a class without subscription are offered all the events.
+  /// By default, displayable managers that only render (models, segmentations, volume rendering...)
+  /// are not subscribed to any event.
+  ///
+  /// Device is a vtkEventDataDevice value, vtkEventDataDevice::Any (-1) subscribes to all devices.
+  /// Call UpdateDisplayableManagerSubscriptionTable() after changing subscriptions.
+  void AddDisplayableManagerSubscription(const char* className, unsigned long eventId, int device = -1);
+  void RemoveAllDisplayableManagerSubscriptions(const char* className);
+  void SetDisplayableManagerSubscribedToAllEvents(const char* className);
+  bool IsDisplayableManagerSubscribed(const char* className, unsigned long eventId, int device);
+  ///@}
+
+  /// Resolve the subscriptions of the displayable managers of the group.
+  /// Must be called after the displayable managers are set, and again if displayable managers
+  /// are added to the group or subscriptions are changed. Until then, events are offered to all
+  /// displayable managers.
+  void UpdateDisplayableManagerSubscriptionTable();
+
+  /// Number of displayable managers the event is offered to.
+  int GetNumberOfSubscribedDisplayableManagers(unsigned long eventId, int device);
+
 protected:
   vtkVirtualRealityViewInteractorObserver();
   ~vtkVirtualRealityViewInteractorObserver() override;
 
+  /// Keep the event as the pending move of its device. Return the device index,
+  /// or -1 if the event is not deferred.
+  int DeferMove3DEvent(vtkEventData* eventData);
+
+  /// Observe the render window of the interactor, to delegate pending moves before rendering.
+  /// Return false if the interactor has no render window.
+  bool ObserveRenderWindow();
+
+  static void ProcessRenderWindowEvents(vtkObject* caller, unsigned long event, void* clientData, void* callData);
+
+  bool Move3DEventCoalescing{true};
+  std::vector<std::pair<vtkWeakPointer<vtkObject>, int>> FullRateMove3DEventRequesters;
+
+  vtkSmartPointer<vtkEventDataDevice3D> PendingMove3DEvents[vtkEventDataNumberOfDevices];
+  bool PendingMove3DEventExists[vtkEventDataNumberOfDevices];
+  bool LastMove3DEventDelegated[vtkEventDataNumberOfDevices];
+  bool PendingMove3DEventAborted[vtkEventDataNumberOfDevices];
+  bool ProcessingPendingMove3DEvents{false};
+  vtkTypeInt64 NumberOfCoalescedMove3DEvents{0};
+
+  vtkWeakPointer<vtkRenderWindow> ObservedRenderWindow;
+  vtkNew<vtkCallbackCommand> RenderWindowCallbackCommand;
+
+  /// Offer the event only to the displayable managers subscribed to it.
+  /// Same selection and focus rules as vtkMRMLViewInteractorStyle.
+  bool DelegateInteractionEventDataToSubscribedDisplayableManagers(vtkMRMLInteractionEventData* eventData);
+
+  /// Get displayable managers subscribed to an event, computed on first use for each event and device
+  const std::vector<vtkWeakPointer<vtkMRMLAbstractDisplayableManager>>& GetSubscribedDisplayableManagers(
+    unsigned long eventId, int device);
+
+  /// Subscribed (event, device) pairs by class name. Classes not in the map are subscribed to all events.
+  std::map<std::string, std::set<std::pair<unsigned long, int>>> DisplayableManagerSubscriptions;
+
+  /// Displayable managers subscribed to each (event, device) pair
+  std::map<std::pair<unsigned long, int>, std::vector<vtkWeakPointer<vtkMRMLAbstractDisplayableManager>>> SubscriptionTable;
+  /// Displayable managers of the group, the table is only used while it matches the group
+  std::vector<vtkWeakPointer<vtkMRMLAbstractDisplayableManager>> SubscriptionTableDisplayableManagers;
+  vtkWeakPointer<vtkMRMLDisplayableManagerGroup> SubscriptionTableGroup;
+
 private:
   vtkVirtualRealityViewInteractorObserver(const vtkVirtualRealityViewInteractorObserver&) = delete;
   void operator=(const vtkVirtualRealityViewInteractorObserver&) = delete;
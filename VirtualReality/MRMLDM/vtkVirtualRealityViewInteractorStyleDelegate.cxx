@@ -17,7 +17,7 @@
 ==============================================================================*/
 
 // VR Logic includes
-#include "vtkSlicerVirtualRealityLogic.h"
+#include "vtkVirtualRealityMath.h"
 
 // VR MRML includes
 #include "vtkMRMLVirtualRealityViewNode.h"
@@ -26,6 +26,7 @@
 #include "vtkVirtualRealityViewInteractorStyleDelegate.h"
 
 // MRML includes
+#include <vtkMRMLAbstractViewNode.h>
 #include <vtkMRMLDisplayableNode.h>
 #include <vtkMRMLDisplayNode.h>
 #include <vtkMRMLLinearTransformNode.h>
@@ -42,11 +43,58 @@
 #include <vtkInteractorStyle.h>
 #include <vtkMatrix4x4.h>
 #include <vtkObjectFactory.h>
-#include <vtkQuaternion.h>
 #include <vtkRenderer.h>
 #include <vtkRenderWindowInteractor3D.h>
 #include <vtkTransform.h>
 
+// STD includes
+#include <algorithm>
+
+namespace
+{
+/// Distance (in meters) from the controller within which the bounds of a node must be for
+/// the node to be picked by the displayable managers. It is larger than the displayable
+/// manager pick tolerances so that the candidate test does not reject actual hits.
+const double GrabCandidateTolerance_Physical = 0.05;
+
+/// Class of the displayable nodes picked by displayable managers. Displayable managers
+/// that are not listed are queried whatever the class of the candidate nodes.
+const struct
+{
+  const char* DisplayableManagerClassName;
+  const char* DisplayableNodeClassName;
+} PickedNodeClasses[] = {
+  {"vtkMRMLModelDisplayableManager", "vtkMRMLModelNode"},
+  {"vtkMRMLSegmentationsDisplayableManager3D", "vtkMRMLSegmentationNode"},
+  {"vtkMRMLVolumeRenderingDisplayableManager", "vtkMRMLVolumeNode"},
+  {"vtkMRMLMarkupsDisplayableManager", "vtkMRMLMarkupsNode"},
+  {"vtkMRMLLinearTransformsDisplayableManager", "vtkMRMLTransformNode"},
+};
+
+//----------------------------------------------------------------------------
+/// Return true if the displayable manager may pick one of the candidate nodes
+bool CanPickCandidateNode(vtkMRMLAbstractDisplayableManager* displayableManager,
+  const std::vector<vtkMRMLDisplayableNode*>& candidateNodes)
+{
+  for (const auto& pickedNodeClass : PickedNodeClasses)
+  {
+    if (!displayableManager->IsA(pickedNodeClass.DisplayableManagerClassName))
+    {
+      continue;
+    }
+    for (vtkMRMLDisplayableNode* candidateNode : candidateNodes)
+    {
+      if (candidateNode->IsA(pickedNodeClass.DisplayableNodeClassName))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+  return true;
+}
+}
+
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkVirtualRealityViewInteractorStyleDelegate);
 
@@ -82,6 +130,35 @@ vtkMRMLScene* vtkVirtualRealityViewInteractorStyleDelegate::GetMRMLScene() const
   return this->DisplayableManagers->GetNthDisplayableManager(0)->GetMRMLScene();
 }
 
+//----------------------------------------------------------------------------
+vtkVirtualRealityVisiblePropBoundsCache* vtkVirtualRealityViewInteractorStyleDelegate::GetVisiblePropBoundsCache()
+{
+  // Follow the view node of the displayable managers
+  if (this->DisplayableManagers != nullptr)
+  {
+    this->VisiblePropBoundsCache->SetViewNode(
+      vtkMRMLAbstractViewNode::SafeDownCast(this->DisplayableManagers->GetMRMLDisplayableNode()));
+  }
+  return this->VisiblePropBoundsCache;
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityViewInteractorStyleDelegate::GetVisiblePropBounds(vtkRenderer* renderer, double bounds[6])
+{
+  if (!this->GetVisiblePropBoundsCache()->GetBounds(bounds))
+  {
+    renderer->ComputeVisiblePropBounds(bounds);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityViewInteractorStyleDelegate::ResetCameraClippingRange(vtkRenderer* renderer)
+{
+  double bounds[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+  this->GetVisiblePropBounds(renderer, bounds);
+  renderer->ResetCameraClippingRange(bounds);
+}
+
 //----------------------------------------------------------------------------
 void vtkVirtualRealityViewInteractorStyleDelegate::OnPan()
 {
@@ -147,14 +224,23 @@ void vtkVirtualRealityViewInteractorStyleDelegate::OnPinch3D()
       rw->GetDeviceToPhysicalMatrixForDevice(vtkEventDataDevice::RightController);
 
   // Get combined current controller pose
-  vtkNew<vtkMatrix4x4> combinedCurrentControllerPose;
-  if ( !vtkSlicerVirtualRealityLogic::CalculateCombinedControllerPose(
-    currentController0Pose_Physical, currentController1Pose_Physical, combinedCurrentControllerPose ) )
+  vtkVirtualRealityMath::Matrix4 combinedCurrentControllerPose = vtkVirtualRealityMath::Matrix4::Identity();
+  if (currentController0Pose_Physical != nullptr && currentController1Pose_Physical != nullptr
+    && vtkVirtualRealityMath::CombinedControllerPose(
+      vtkVirtualRealityMath::Matrix4::FromVTK(currentController0Pose_Physical),
+      vtkVirtualRealityMath::Matrix4::FromVTK(currentController1Pose_Physical),
+      combinedCurrentControllerPose))
+  {
+    // Save current as last valid pose
+    this->LastValidCombinedControllerPose = combinedCurrentControllerPose;
+    this->LastValidCombinedControllerPoseExists = true;
+  }
+  else
   {
     // If combined pose is invalid, then use the last valid pose if it exists
     if (this->LastValidCombinedControllerPoseExists)
     {
-      combinedCurrentControllerPose->DeepCopy(this->LastValidCombinedControllerPose);
+      combinedCurrentControllerPose = this->LastValidCombinedControllerPose;
     }
     else
     {
@@ -162,32 +248,18 @@ void vtkVirtualRealityViewInteractorStyleDelegate::OnPinch3D()
       return;
     }
   }
-  else
-  {
-    // Save current as last valid pose
-    this->LastValidCombinedControllerPose->DeepCopy(combinedCurrentControllerPose);
-  }
-
-  // Calculate modifier matrix
-  vtkNew<vtkMatrix4x4> inverseCombinedCurrentControllerPose;
-  vtkMatrix4x4::Invert(combinedCurrentControllerPose, inverseCombinedCurrentControllerPose);
-
-  vtkNew<vtkMatrix4x4> modifyPhysicalToWorldMatrix;
-  vtkMatrix4x4::Multiply4x4(
-    this->CombinedStartingControllerPose, inverseCombinedCurrentControllerPose, modifyPhysicalToWorldMatrix);
 
   // Calculate new physical to world matrix
-  vtkNew<vtkMatrix4x4> startingPhysicalToWorldMatrix;
-  rwi->GetStartingPhysicalToWorldMatrix(startingPhysicalToWorldMatrix);
-  vtkNew<vtkMatrix4x4> newPhysicalToWorldMatrix;
-  vtkMatrix4x4::Multiply4x4(
-    startingPhysicalToWorldMatrix, modifyPhysicalToWorldMatrix, newPhysicalToWorldMatrix);
+  rwi->GetStartingPhysicalToWorldMatrix(this->PhysicalToWorldMatrix);
+  vtkVirtualRealityMath::Pinch3DPhysicalToWorld(
+    vtkVirtualRealityMath::Matrix4::FromVTK(this->PhysicalToWorldMatrix),
+    this->CombinedStartingControllerPose, combinedCurrentControllerPose).ToVTK(this->PhysicalToWorldMatrix);
 
   // Set new physical to world matrix
-  rw->SetPhysicalToWorldMatrix(newPhysicalToWorldMatrix);
+  rw->SetPhysicalToWorldMatrix(this->PhysicalToWorldMatrix);
   if (istyle->GetAutoAdjustCameraClippingRange())
   {
-    istyle->GetCurrentRenderer()->ResetCameraClippingRange();
+    this->ResetCameraClippingRange(istyle->GetCurrentRenderer());
   }
   if (rwi->GetLightFollowCamera())
   {
@@ -213,8 +285,11 @@ void vtkVirtualRealityViewInteractorStyleDelegate::StartGesture()
   vtkMatrix4x4* startingController1Pose_Physical =
       rw->GetDeviceToPhysicalMatrixForDevice(vtkEventDataDevice::RightController);
 
-  if ( vtkSlicerVirtualRealityLogic::CalculateCombinedControllerPose(
-    startingController0Pose_Physical, startingController1Pose_Physical, this->CombinedStartingControllerPose) )
+  if (startingController0Pose_Physical != nullptr && startingController1Pose_Physical != nullptr
+    && vtkVirtualRealityMath::CombinedControllerPose(
+      vtkVirtualRealityMath::Matrix4::FromVTK(startingController0Pose_Physical),
+      vtkVirtualRealityMath::Matrix4::FromVTK(startingController1Pose_Physical),
+      this->CombinedStartingControllerPose))
   {
     this->StartingControllerPoseValid = true;
   }
@@ -278,28 +353,8 @@ void vtkVirtualRealityViewInteractorStyleDelegate::PositionProp(
   double* lastWorldOrientation = rwi->GetLastWorldEventOrientation(rwi->GetPointerIndex());
 
   // Calculate transform
-  vtkNew<vtkTransform> interactionTransform;
-  interactionTransform->PreMultiply();
-
-  double translation[3] = {0.0};
-  for (int i = 0; i < 3; i++)
-  {
-    translation[i] = worldPos[i] - lastWorldPos[i];
-  }
-  vtkQuaternion<double> q1;
-  q1.SetRotationAngleAndAxis(vtkMath::RadiansFromDegrees(
-    lastWorldOrientation[0]), lastWorldOrientation[1], lastWorldOrientation[2], lastWorldOrientation[3]);
-  vtkQuaternion<double> q2;
-  q2.SetRotationAngleAndAxis(vtkMath::RadiansFromDegrees(
-    worldOrientation[0]), worldOrientation[1], worldOrientation[2], worldOrientation[3]);
-  q1.Conjugate();
-  q2 = q2*q1;
-  double axis[4] = {0.0};
-  axis[0] = vtkMath::DegreesFromRadians(q2.GetRotationAngleAndAxis(axis+1));
-  interactionTransform->Translate(worldPos[0], worldPos[1], worldPos[2]);
-  interactionTransform->RotateWXYZ(axis[0], axis[1], axis[2], axis[3]);
-  interactionTransform->Translate(-worldPos[0], -worldPos[1], -worldPos[2]);
-  interactionTransform->Translate(translation[0], translation[1], translation[2]);
+  vtkVirtualRealityMath::Matrix4 interactionTransform = vtkVirtualRealityMath::GrabInteractionTransform(
+    worldPos, lastWorldPos, worldOrientation, lastWorldOrientation);
 
   // Make sure that the topmost parent transform is the VR interaction transform
   vtkMRMLTransformNode* topTransformNode = pickedNode->GetParentTransformNode();
@@ -348,17 +403,20 @@ void vtkVirtualRealityViewInteractorStyleDelegate::PositionProp(
   // of potentially thousands of transforms
   if (lastVrInteractionTransform)
   {
-    interactionTransform->Concatenate(lastVrInteractionTransform->GetMatrix());
-    lastVrInteractionTransform->DeepCopy(interactionTransform);
+    vtkVirtualRealityMath::Matrix4 vrInteractionMatrix =
+      interactionTransform * vtkVirtualRealityMath::Matrix4::FromVTK(lastVrInteractionTransform->GetMatrix());
+    lastVrInteractionTransform->SetMatrix(vrInteractionMatrix.Elements);
   }
   else
   {
-    vrTransformNode->SetAndObserveTransformToParent(interactionTransform);
+    vtkNew<vtkTransform> newVrInteractionTransform;
+    newVrInteractionTransform->SetMatrix(interactionTransform.Elements);
+    vrTransformNode->SetAndObserveTransformToParent(newVrInteractionTransform);
   }
 
   if (istyle->GetAutoAdjustCameraClippingRange())
   {
-    istyle->GetCurrentRenderer()->ResetCameraClippingRange();
+    this->ResetCameraClippingRange(istyle->GetCurrentRenderer());
   }
 }
 
@@ -394,12 +452,28 @@ void vtkVirtualRealityViewInteractorStyleDelegate::StartPositionProp(vtkEventDat
   double pos[3] = {0.0};
   edata->GetWorldPosition(pos);
 
+  // Find candidate nodes from their bounds first, so that displayable managers
+  // only need to be queried if the controller is near a selectable node.
+  bool useCandidateNodes = (this->GetVisiblePropBoundsCache()->GetViewNode() != nullptr);
+  if (useCandidateNodes)
+  {
+    vtkVRRenderWindow* rw = vtkVRRenderWindow::SafeDownCast(istyle->GetInteractor()->GetRenderWindow());
+    double tolerance = GrabCandidateTolerance_Physical * (rw ? rw->GetPhysicalScale() : 1.0);
+    this->VisiblePropBoundsCache->FindSelectableNodesAtPoint(pos, tolerance, this->GrabCandidateNodes);
+  }
+  int displayableManagerCount = this->DisplayableManagers->GetDisplayableManagerCount();
+  if (!this->GrabEnabled || (useCandidateNodes && this->GrabCandidateNodes.empty()))
+  {
+    displayableManagerCount = 0;
+  }
+
   // Get MRML node to move
-  for (int i=0; i<this->DisplayableManagers->GetDisplayableManagerCount(); ++i)
+  for (int i=0; i<displayableManagerCount; ++i)
   {
     vtkMRMLAbstractThreeDViewDisplayableManager* currentDisplayableManager =
       vtkMRMLAbstractThreeDViewDisplayableManager::SafeDownCast(this->DisplayableManagers->GetNthDisplayableManager(i));
-    if (currentDisplayableManager == nullptr)
+    if (currentDisplayableManager == nullptr
+      || (useCandidateNodes && !CanPickCandidateNode(currentDisplayableManager, this->GrabCandidateNodes)))
     {
       continue;
     }
@@ -412,6 +486,11 @@ void vtkVirtualRealityViewInteractorStyleDelegate::StartPositionProp(vtkEventDat
     }
     //TODO: Only the first selectable picked node in the last displayable manager will be picked
     vtkMRMLDisplayableNode* pickedNode = displayNode->GetDisplayableNode();
+    if (useCandidateNodes && std::find(this->GrabCandidateNodes.begin(), this->GrabCandidateNodes.end(), pickedNode)
+      == this->GrabCandidateNodes.end())
+    {
+      continue;
+    }
     if (pickedNode != nullptr && pickedNode->GetSelectable() && this->GrabEnabled)
     {
       this->PickedNode[static_cast<int>(device)] = pickedNode;
@@ -471,54 +550,23 @@ void vtkVirtualRealityViewInteractorStyleDelegate::SetMagnification(double magni
   }
 
   // Get Physical to World_Origin matrix
-  vtkNew<vtkMatrix4x4> physicalToWorldOriginMatrix;
-  rw->GetPhysicalToWorldMatrix(physicalToWorldOriginMatrix);
+  rw->GetPhysicalToWorldMatrix(this->PhysicalToWorldMatrix);
 
-  // Calculate World_Origin to World_FocusPoint matrix
+  // Scale the world around the center of the visible props
   double bounds[6] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
-  istyle->GetCurrentRenderer()->ComputeVisiblePropBounds(bounds);
+  this->GetVisiblePropBounds(istyle->GetCurrentRenderer(), bounds);
   double focusPoint_World[3] = { (bounds[1] + bounds[0]) / 2.0,
                                  (bounds[3] + bounds[2]) / 2.0,
                                  (bounds[5] + bounds[4]) / 2.0 };
-  vtkNew<vtkMatrix4x4> worldOriginToWorldFocusPointMatrix;
-  for (int i=0; i<3; ++i)
-  {
-    worldOriginToWorldFocusPointMatrix->SetElement(i,3, -focusPoint_World[i]);
-  }
-
-  // Calculate World_FocusPoint to World_ScaledFocusPoint matrix
-  vtkNew<vtkMatrix4x4> worldFocusPointToWorldScaledFocusPointMatrix;
-  for (int i=0; i<3; ++i)
-  {
-    worldFocusPointToWorldScaledFocusPointMatrix->SetElement(i,i, scaleFactor);
-  }
-
-  // Calculate World_ScaledFocusPoint to World_ScaledOrigin matrix
-  vtkNew<vtkMatrix4x4> worldScaledFocusPointToWorldScaledOriginMatrix;
-  for (int i=0; i<3; ++i)
-  {
-    worldScaledFocusPointToWorldScaledOriginMatrix->SetElement(i,3, focusPoint_World[i]);
-  }
-
-  // Calculate Physical to World_ScaledOrigin matrix
-  vtkNew<vtkMatrix4x4> worldFocusPointToWorldScaledOriginMatrix;
-  vtkMatrix4x4::Multiply4x4( worldScaledFocusPointToWorldScaledOriginMatrix, worldFocusPointToWorldScaledFocusPointMatrix,
-    worldFocusPointToWorldScaledOriginMatrix );
-
-  vtkNew<vtkMatrix4x4> worldOriginToWorldScaledOriginMatrix;
-  vtkMatrix4x4::Multiply4x4( worldFocusPointToWorldScaledOriginMatrix, worldOriginToWorldFocusPointMatrix,
-    worldOriginToWorldScaledOriginMatrix );
-
-  // Physical to World_ScaledOrigin
-  vtkNew<vtkMatrix4x4> physicalToWorldScaledOriginMatrix;
-  vtkMatrix4x4::Multiply4x4( worldOriginToWorldScaledOriginMatrix, physicalToWorldOriginMatrix,
-    physicalToWorldScaledOriginMatrix );
+  vtkVirtualRealityMath::ScaledPhysicalToWorld(
+    vtkVirtualRealityMath::Matrix4::FromVTK(this->PhysicalToWorldMatrix), focusPoint_World, scaleFactor)
+    .ToVTK(this->PhysicalToWorldMatrix);
 
-  rw->SetPhysicalToWorldMatrix(physicalToWorldScaledOriginMatrix);
+  rw->SetPhysicalToWorldMatrix(this->PhysicalToWorldMatrix);
 
   if (istyle->GetAutoAdjustCameraClippingRange())
   {
-    istyle->GetCurrentRenderer()->ResetCameraClippingRange();
+    this->ResetCameraClippingRange(istyle->GetCurrentRenderer());
   }
   if (istyle->GetInteractor()->GetLightFollowCamera())
   {
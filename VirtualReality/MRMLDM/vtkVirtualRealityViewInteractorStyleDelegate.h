@@ -21,6 +21,10 @@
 
 // VR MRMLDM includes
 #include "vtkSlicerVirtualRealityModuleMRMLDisplayableManagerExport.h"
+#include "vtkVirtualRealityVisiblePropBoundsCache.h"
+
+// VR Logic includes
+#include "vtkVirtualRealityMath.h"
 
 // MRML includes
 class vtkMRMLDisplayableNode;
@@ -39,6 +43,10 @@ class vtkMRMLScene;
 #include <vtkObject.h>
 #include <vtkSmartPointer.h>
 #include <vtkWeakPointer.h>
+class vtkRenderer;
+
+// STD includes
+#include <vector>
 
 
 class VTK_SLICER_VIRTUALREALITY_MODULE_MRMLDISPLAYABLEMANAGER_EXPORT vtkVirtualRealityViewInteractorStyleDelegate
@@ -99,17 +107,33 @@ public:
   double GetMagnification();
   ///}@
 
+  /// Bounds of the visible displayable nodes, used instead of walking all the
+  /// props of the renderer on each gesture event, and to find grab candidates
+  /// before picking in the displayable managers.
+  vtkVirtualRealityVisiblePropBoundsCache* GetVisiblePropBoundsCache();
+
 protected:
   vtkWeakPointer<vtkVRInteractorStyle> InteractorStyle;
 
   void OnPinch3D();
 
-  vtkNew<vtkMatrix4x4> CombinedStartingControllerPose;
+  /// Get bounds of the visible props from the cache, fall back to the renderer
+  /// if the cache has no visible node.
+  void GetVisiblePropBounds(vtkRenderer* renderer, double bounds[6]);
+  void ResetCameraClippingRange(vtkRenderer* renderer);
+
+  vtkVirtualRealityMath::Matrix4 CombinedStartingControllerPose{vtkVirtualRealityMath::Matrix4::Identity()};
   bool StartingControllerPoseValid{false};
 
-  vtkNew<vtkMatrix4x4> LastValidCombinedControllerPose;
+  vtkVirtualRealityMath::Matrix4 LastValidCombinedControllerPose{vtkVirtualRealityMath::Matrix4::Identity()};
   bool LastValidCombinedControllerPoseExists{false};
 
+  /// Matrix passed to and from the render window, reused to avoid allocations at controller event rate
+  vtkNew<vtkMatrix4x4> PhysicalToWorldMatrix;
+
+  vtkNew<vtkVirtualRealityVisiblePropBoundsCache> VisiblePropBoundsCache;
+  std::vector<vtkMRMLDisplayableNode*> GrabCandidateNodes;
+
   bool GrabEnabled{true};
   vtkWeakPointer<vtkMRMLDisplayableNode> PickedNode[vtkEventDataNumberOfDevices];
   vtkWeakPointer<vtkMRMLDisplayableManagerGroup> DisplayableManagers;
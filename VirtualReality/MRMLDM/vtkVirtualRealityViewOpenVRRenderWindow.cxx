@@ -0,0 +1,275 @@
+/*==============================================================================
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// VR Logic includes
+#include "vtkVirtualRealityFramePacer.h"
+
+// VR MRMLDM includes
+#include "vtkVirtualRealityViewOpenVRRenderWindow.h"
+
+// VTK includes
+#include <vtkObjectFactory.h>
+#include <vtkOpenGLRenderWindow.h>
+#include <vtkRenderer.h>
+#include <vtkRendererCollection.h>
+
+// OpenVR includes
+#include <openvr.h>
+
+// STD includes
+#include <chrono>
+
+namespace
+{
+/// Interval at which the keep-alive thread checks whether the render loop is stalled
+const std::chrono::milliseconds KeepAlivePollingInterval(5);
+}
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkVirtualRealityViewOpenVRRenderWindow);
+
+//----------------------------------------------------------------------------
+vtkVirtualRealityViewOpenVRRenderWindow::vtkVirtualRealityViewOpenVRRenderWindow() = default;
+
+//----------------------------------------------------------------------------
+vtkVirtualRealityViewOpenVRRenderWindow::~vtkVirtualRealityViewOpenVRRenderWindow()
+{
+  // Superclass destructor calls Finalize() after this class is destroyed
+  this->StopKeepAliveSubmission();
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityViewOpenVRRenderWindow::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "RenderScale: " << this->RenderScale << "\n";
+  os << indent << "KeepAliveTimeout: " << this->KeepAliveTimeout << "\n";
+  os << indent << "KeepAliveSubmissionRunning: " << this->IsKeepAliveSubmissionRunning() << "\n";
+  os << indent << "NumberOfKeepAliveFrames: " << this->GetNumberOfKeepAliveFrames() << "\n";
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityViewOpenVRRenderWindow::Render()
+{
+  // Keep-alive thread does not start a new compositor frame once the render loop waits for the lock
+  this->RenderRequested = true;
+  std::lock_guard<std::mutex> frameLock(this->FrameMutex);
+  this->RenderRequested = false;
+
+  // Only render into the scaled part of the eye framebuffers
+  vtkRenderer* renderer = nullptr;
+  vtkCollectionSimpleIterator it;
+  for (this->Renderers->InitTraversal(it); (renderer = this->Renderers->GetNextRenderer(it));)
+  {
+    double* viewport = renderer->GetViewport();
+    if (viewport[2] != this->RenderScale || viewport[3] != this->RenderScale)
+    {
+      renderer->SetViewport(0.0, 0.0, this->RenderScale, this->RenderScale);
+    }
+  }
+  this->Superclass::Render();
+  this->LastFrameTime = vtkVirtualRealityFramePacer::GetTime();
+
+  // Poses of the last WaitGetPoses() call, made by the superclass before rendering
+  vr::TrackedDevicePose_t hmdPose;
+  this->RenderedHMDPoseValid = this->HMD != nullptr
+    && vr::VRCompositor()->GetLastPoses(&hmdPose, 1, nullptr, 0) == vr::VRCompositorError_None
+    && hmdPose.bPoseIsValid;
+  if (this->RenderedHMDPoseValid)
+  {
+    this->RenderedHMDPose = hmdPose.mDeviceToAbsoluteTracking;
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityViewOpenVRRenderWindow::Frame()
+{
+  this->SubmittedRenderScale = this->RenderScale;
+  if (this->RenderScale >= 1.0 || this->HMD == nullptr)
+  {
+    this->Superclass::Frame();
+    return;
+  }
+
+  // Same as vtkOpenVRRenderWindow::Frame(), except that texture bounds are
+  // specified so that the compositor only displays the rendered part of the eye textures.
+  this->MakeCurrent();
+  this->vtkVRRenderWindow::Frame();
+  if (!this->SwapBuffers)
+  {
+    return;
+  }
+
+  vr::VRTextureBounds_t bounds;
+  bounds.uMin = 0.0f;
+  bounds.vMin = 0.0f;
+  bounds.uMax = static_cast<float>(this->RenderScale);
+  bounds.vMax = static_cast<float>(this->RenderScale);
+
+  vr::Texture_t leftEyeTexture = { (void*)(long)this->FramebufferDescs[vtkVRRenderWindow::LeftEye].ResolveColorTextureId,
+    vr::TextureType_OpenGL, vr::ColorSpace_Gamma };
+  vr::VRCompositor()->Submit(vr::Eye_Left, &leftEyeTexture, &bounds);
+  vr::Texture_t rightEyeTexture = { (void*)(long)this->FramebufferDescs[vtkVRRenderWindow::RightEye].ResolveColorTextureId,
+    vr::TextureType_OpenGL, vr::ColorSpace_Gamma };
+  vr::VRCompositor()->Submit(vr::Eye_Right, &rightEyeTexture, &bounds);
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityViewOpenVRRenderWindow::Finalize()
+{
+  this->StopKeepAliveSubmission();
+  this->Superclass::Finalize();
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityViewOpenVRRenderWindow::StartKeepAliveSubmission()
+{
+  if (this->KeepAliveThread.joinable())
+  {
+    return;
+  }
+  if (this->HMD != nullptr && this->HelperWindow != nullptr && vr::VRCompositor() != nullptr)
+  {
+    // Create the context of the thread, sharing objects with the context of the helper window
+    vtkSmartPointer<vtkRenderWindow> contextWindow = vtkSmartPointer<vtkRenderWindow>::New();
+    this->KeepAliveContextWindow = vtkOpenGLRenderWindow::SafeDownCast(contextWindow);
+    if (this->KeepAliveContextWindow == nullptr)
+    {
+      vtkErrorMacro("StartKeepAliveSubmission failed: OpenGL render window cannot be created");
+      return;
+    }
+    this->KeepAliveContextWindow->SetShowWindow(false);
+    this->KeepAliveContextWindow->SetSize(1, 1);
+    this->KeepAliveContextWindow->SetSharedRenderWindow(this->HelperWindow);
+    this->KeepAliveContextWindow->Initialize();
+    // A context can only be current in one thread
+    this->KeepAliveContextWindow->ReleaseCurrent();
+    this->MakeCurrent();
+  }
+
+  this->KeepAliveStopRequested = false;
+  this->NumberOfKeepAliveFrames = 0;
+  this->LastFrameTime = vtkVirtualRealityFramePacer::GetTime();
+  this->KeepAliveThread = std::thread(&vtkVirtualRealityViewOpenVRRenderWindow::KeepAliveSubmissionLoop,
+    this, this->KeepAliveTimeout);
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityViewOpenVRRenderWindow::StopKeepAliveSubmission()
+{
+  if (!this->KeepAliveThread.joinable())
+  {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(this->KeepAliveMutex);
+    this->KeepAliveStopRequested = true;
+  }
+  this->KeepAliveCondition.notify_all();
+  this->KeepAliveThread.join();
+
+  if (this->KeepAliveContextWindow != nullptr)
+  {
+    this->KeepAliveContextWindow->Finalize();
+    this->KeepAliveContextWindow = nullptr;
+    if (this->HelperWindow != nullptr)
+    {
+      this->MakeCurrent();
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkVirtualRealityViewOpenVRRenderWindow::IsKeepAliveSubmissionRunning() const
+{
+  return this->KeepAliveThread.joinable();
+}
+
+//----------------------------------------------------------------------------
+int vtkVirtualRealityViewOpenVRRenderWindow::GetNumberOfKeepAliveFrames() const
+{
+  return this->NumberOfKeepAliveFrames;
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityViewOpenVRRenderWindow::KeepAliveSubmissionLoop(double timeout)
+{
+  // Frames are submitted only if the render window is initialized
+  bool submitFrames = (this->KeepAliveContextWindow != nullptr);
+  if (submitFrames)
+  {
+    this->KeepAliveContextWindow->MakeCurrent();
+  }
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(this->KeepAliveMutex);
+      if (this->KeepAliveCondition.wait_for(lock, KeepAlivePollingInterval, [this] { return this->KeepAliveStopRequested; }))
+      {
+        break;
+      }
+    }
+    if (vtkVirtualRealityFramePacer::GetTime() - this->LastFrameTime < timeout)
+    {
+      continue;
+    }
+
+    // Only one thread calls the compositor at a time: waiting for poses and submitting are done
+    // while holding the frame lock. The lock is not taken if the render loop is rendering a frame
+    // or waiting to render one, and no frame is submitted if the render loop rendered one meanwhile.
+    std::unique_lock<std::mutex> frameLock(this->FrameMutex, std::try_to_lock);
+    if (!frameLock.owns_lock() || this->RenderRequested
+      || vtkVirtualRealityFramePacer::GetTime() - this->LastFrameTime < timeout)
+    {
+      continue;
+    }
+    if (!submitFrames)
+    {
+      ++this->NumberOfKeepAliveFrames;
+      continue;
+    }
+    if (!this->RenderedHMDPoseValid)
+    {
+      // Textures would be displayed in front of the head
+      continue;
+    }
+
+    // Waiting for poses paces submissions on the headset refresh rate
+    vr::VRCompositor()->WaitGetPoses(nullptr, 0, nullptr, 0);
+
+    vr::VRTextureBounds_t bounds;
+    bounds.uMin = 0.0f;
+    bounds.vMin = 0.0f;
+    bounds.uMax = static_cast<float>(this->SubmittedRenderScale);
+    bounds.vMax = static_cast<float>(this->SubmittedRenderScale);
+    vr::VRTextureWithPose_t leftEyeTexture;
+    leftEyeTexture.handle = (void*)(long)this->FramebufferDescs[vtkVRRenderWindow::LeftEye].ResolveColorTextureId;
+    leftEyeTexture.eType = vr::TextureType_OpenGL;
+    leftEyeTexture.eColorSpace = vr::ColorSpace_Gamma;
+    leftEyeTexture.mDeviceToAbsoluteTracking = this->RenderedHMDPose;
+    vr::VRCompositor()->Submit(vr::Eye_Left, &leftEyeTexture, &bounds, vr::Submit_TextureWithPose);
+    vr::VRTextureWithPose_t rightEyeTexture;
+    rightEyeTexture.handle = (void*)(long)this->FramebufferDescs[vtkVRRenderWindow::RightEye].ResolveColorTextureId;
+    rightEyeTexture.eType = vr::TextureType_OpenGL;
+    rightEyeTexture.eColorSpace = vr::ColorSpace_Gamma;
+    rightEyeTexture.mDeviceToAbsoluteTracking = this->RenderedHMDPose;
+    vr::VRCompositor()->Submit(vr::Eye_Right, &rightEyeTexture, &bounds, vr::Submit_TextureWithPose);
+    ++this->NumberOfKeepAliveFrames;
+  }
+  if (submitFrames)
+  {
+    this->KeepAliveContextWindow->ReleaseCurrent();
+  }
+}
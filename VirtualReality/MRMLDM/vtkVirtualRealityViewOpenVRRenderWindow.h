@@ -0,0 +1,126 @@
+/*==============================================================================
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#ifndef vtkVirtualRealityViewOpenVRRenderWindow_h
+#define vtkVirtualRealityViewOpenVRRenderWindow_h
+
+// VR MRMLDM includes
+#include "vtkSlicerVirtualRealityModuleMRMLDisplayableManagerExport.h"
+
+// VTK Rendering/OpenVR includes
+#include <vtkOpenVRRenderWindow.h>
+
+// VTK includes
+#include <vtkSmartPointer.h>
+
+// STD includes
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/// \brief OpenVR render window supporting dynamic render resolution.
+///
+/// When RenderScale is smaller than 1, the scene is rendered into the lower-left
+/// part of the eye framebuffers (by shrinking the viewport of the renderers) and only
+/// that part is submitted to the compositor, which scales it up to the headset display.
+/// Eye framebuffers are not reallocated, so the scale can be changed at every frame.
+///
+/// Optionally, a keep-alive thread submits the last rendered eye textures to the compositor
+/// when no frame has been rendered for KeepAliveTimeout seconds, for example while the GUI
+/// thread running the render loop is busy. The compositor then keeps reprojecting the last
+/// frame instead of fading to its loading environment. The thread renders in its own OpenGL
+/// context, sharing the eye textures with the context of the render window.
+///
+/// OpenVR compositor frame calls (WaitGetPoses and Submit) are only made by one thread at a time:
+/// both threads make them while holding FrameMutex. The keep-alive thread does not start a compositor
+/// frame while the render loop is rendering or waiting to render one. A render loop that resumes while
+/// a keep-alive frame is submitted waits for it, at most one headset refresh period.
+/// Textures are submitted with the headset pose they were rendered with, so that the compositor
+/// reprojects them at their place in the room instead of displaying them in front of the head.
+/// \sa StartKeepAliveSubmission()
+class VTK_SLICER_VIRTUALREALITY_MODULE_MRMLDISPLAYABLEMANAGER_EXPORT vtkVirtualRealityViewOpenVRRenderWindow
+  : public vtkOpenVRRenderWindow
+{
+public:
+  static vtkVirtualRealityViewOpenVRRenderWindow* New();
+  vtkTypeMacro(vtkVirtualRealityViewOpenVRRenderWindow, vtkOpenVRRenderWindow);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /// Fraction of the recommended eye render size used for rendering, along each axis.
+  /// Default is 1.0.
+  vtkSetClampMacro(RenderScale, double, 0.1, 1.0);
+  vtkGetMacro(RenderScale, double);
+  ///}@
+
+  ///@{
+  /// Duration without rendered frame, in seconds, after which the last frame is submitted again.
+  /// Applied when keep-alive submission is started.
+  /// Default is 0.1s.
+  vtkSetClampMacro(KeepAliveTimeout, double, 0.01, 10.0);
+  vtkGetMacro(KeepAliveTimeout, double);
+  ///}@
+
+  ///@{
+  /// Start or stop the keep-alive thread. Must be called from the thread rendering the window.
+  /// If the render window is not initialized, the thread runs without submitting frames.
+  void StartKeepAliveSubmission();
+  void StopKeepAliveSubmission();
+  bool IsKeepAliveSubmissionRunning() const;
+  ///}@
+
+  /// Number of frames submitted by the keep-alive thread since it was started.
+  /// If the render window is not initialized, frames that would have been submitted are counted.
+  int GetNumberOfKeepAliveFrames() const;
+
+  void Render() override;
+  void Frame() override;
+  void Finalize() override;
+
+protected:
+  vtkVirtualRealityViewOpenVRRenderWindow();
+  ~vtkVirtualRealityViewOpenVRRenderWindow() override;
+
+  double RenderScale{1.0};
+
+  void KeepAliveSubmissionLoop(double timeout);
+
+  double KeepAliveTimeout{0.1};
+  /// Context made current in the keep-alive thread
+  vtkSmartPointer<vtkOpenGLRenderWindow> KeepAliveContextWindow;
+  std::thread KeepAliveThread;
+  std::mutex KeepAliveMutex;
+  std::condition_variable KeepAliveCondition;
+  bool KeepAliveStopRequested{false};
+  /// Held while a compositor frame is started and submitted, by the render loop or by the keep-alive thread
+  std::mutex FrameMutex;
+  /// Set while the render loop waits for FrameMutex
+  std::atomic<bool> RenderRequested{false};
+  /// Render scale of the last submitted frame, guarded by FrameMutex
+  double SubmittedRenderScale{1.0};
+  /// Headset pose the last frame was rendered with, guarded by FrameMutex
+  vr::HmdMatrix34_t RenderedHMDPose{};
+  bool RenderedHMDPoseValid{false};
+  /// Time of the last frame rendered by the render loop, from vtkVirtualRealityFramePacer::GetTime()
+  std::atomic<double> LastFrameTime{0.0};
+  std::atomic<int> NumberOfKeepAliveFrames{0};
+
+private:
+  vtkVirtualRealityViewOpenVRRenderWindow(const vtkVirtualRealityViewOpenVRRenderWindow&) = delete;
+  void operator=(const vtkVirtualRealityViewOpenVRRenderWindow&) = delete;
+};
+
+#endif
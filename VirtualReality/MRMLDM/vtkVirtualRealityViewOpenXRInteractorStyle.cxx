@@ -22,7 +22,30 @@
 #include "vtkVirtualRealityViewOpenXRInteractorStyle.h"
 
 // VTK includes
+#include <vtkActor.h>
 #include <vtkObjectFactory.h>
+#include <vtkPropCollection.h>
+#include <vtkTextActor3D.h>
+#include <vtkVRControlsHelper.h>
+#include <vtkVRMenuRepresentation.h>
 
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkVirtualRealityViewOpenXRInteractorStyle);
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityViewOpenXRInteractorStyle::GetInteractorStyleProps(vtkPropCollection* props)
+{
+  props->AddItem(this->MenuRepresentation);
+  props->AddItem(this->TextActor3D);
+  props->AddItem(this->PickActor);
+  for (int device = 0; device < vtkEventDataNumberOfDevices; ++device)
+  {
+    for (int input = 0; input < vtkEventDataNumberOfInputs; ++input)
+    {
+      if (this->ControlsHelpers[device][input] != nullptr)
+      {
+        props->AddItem(this->ControlsHelpers[device][input]);
+      }
+    }
+  }
+}
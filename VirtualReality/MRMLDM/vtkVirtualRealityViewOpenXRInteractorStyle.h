@@ -36,6 +36,7 @@
 
 class vtkMRMLScene;
 class vtkMRMLDisplayableManagerGroup;
+class vtkPropCollection;
 class vtkWorldPointPicker;
 
 
@@ -59,6 +60,10 @@ public:
   vtkGetSmartPointerMacro(InteractorStyleDelegate, vtkVirtualRealityViewInteractorStyleDelegate);
   ///}@
 
+  /// Add the props that the interactor style displays in the renderer (menu, pick feedback
+  /// and controls helpers) to the collection. They are not created by displayable managers.
+  void GetInteractorStyleProps(vtkPropCollection* props);
+
   //@{
   /**
   * Interaction mode entry points.
@@ -0,0 +1,235 @@
+/*==============================================================================
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// VR MRMLDM includes
+#include "vtkVirtualRealityViewSimulatedInteractor.h"
+
+// VTK Rendering/VR includes
+#include <vtkVRInteractorStyle.h>
+#include <vtkVRRenderWindow.h>
+
+// VTK includes
+#include <vtkMatrix4x4.h>
+#include <vtkObjectFactory.h>
+
+//------------------------------------------------------------------------------
+vtkStandardNewMacro(vtkVirtualRealityViewSimulatedInteractor);
+
+//------------------------------------------------------------------------------
+vtkVirtualRealityViewSimulatedInteractor::vtkVirtualRealityViewSimulatedInteractor()
+{
+  this->ComplexGestureRecognizer->SetInteractor(this);
+}
+
+//------------------------------------------------------------------------------
+vtkVirtualRealityViewSimulatedInteractor::~vtkVirtualRealityViewSimulatedInteractor() = default;
+
+//------------------------------------------------------------------------------
+void vtkVirtualRealityViewSimulatedInteractor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfActions: " << this->ActionMap.size() << "\n";
+  os << indent << "NumberOfQueuedEvents: " << this->QueuedEvents.size() << "\n";
+}
+
+//------------------------------------------------------------------------------
+void vtkVirtualRealityViewSimulatedInteractor::Initialize()
+{
+  if (this->Initialized)
+  {
+    return;
+  }
+  this->Superclass::Initialize();
+
+  vtkVRInteractorStyle* style = vtkVRInteractorStyle::SafeDownCast(this->InteractorStyle);
+  if (style != nullptr)
+  {
+    style->SetupActions(this);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkVirtualRealityViewSimulatedInteractor::AddAction(
+  const std::string& path, const vtkCommand::EventIds& eid, bool isAnalog)
+{
+  ActionData& actionData = this->ActionMap[path];
+  actionData.EventId = eid;
+  actionData.UseFunction = false;
+  actionData.IsAnalog = isAnalog;
+}
+
+//------------------------------------------------------------------------------
+void vtkVirtualRealityViewSimulatedInteractor::AddAction(
+  const std::string& path, bool isAnalog, const std::function<void(vtkEventData*)>& func)
+{
+  ActionData& actionData = this->ActionMap[path];
+  actionData.Function = func;
+  actionData.UseFunction = true;
+  actionData.IsAnalog = isAnalog;
+}
+
+//------------------------------------------------------------------------------
+bool vtkVirtualRealityViewSimulatedInteractor::HasAction(const std::string& path) const
+{
+  return this->ActionMap.find(path) != this->ActionMap.end();
+}
+
+//------------------------------------------------------------------------------
+bool vtkVirtualRealityViewSimulatedInteractor::QueueActionEvent(const std::string& path,
+  vtkEventDataDevice device, vtkEventDataAction action, double trackPadX, double trackPadY)
+{
+  if (!this->HasAction(path))
+  {
+    vtkErrorMacro("QueueActionEvent failed: no action associated with path " << path);
+    return false;
+  }
+  QueuedEvent event;
+  event.Path = path;
+  event.Device = device;
+  event.Action = action;
+  event.TrackPadPosition[0] = trackPadX;
+  event.TrackPadPosition[1] = trackPadY;
+  this->QueuedEvents.push_back(event);
+  return true;
+}
+
+//------------------------------------------------------------------------------
+void vtkVirtualRealityViewSimulatedInteractor::QueueButton3DEvent(
+  vtkEventDataDevice device, vtkEventDataDeviceInput input, vtkEventDataAction action)
+{
+  this->QueueDevice3DEvent(vtkCommand::Button3DEvent, device, input, action);
+}
+
+//------------------------------------------------------------------------------
+void vtkVirtualRealityViewSimulatedInteractor::QueueDevice3DEvent(unsigned long eventId,
+  vtkEventDataDevice device, vtkEventDataDeviceInput input, vtkEventDataAction action,
+  double trackPadX, double trackPadY)
+{
+  QueuedEvent event;
+  event.EventId = eventId;
+  event.Device = device;
+  event.Input = input;
+  event.Action = action;
+  event.TrackPadPosition[0] = trackPadX;
+  event.TrackPadPosition[1] = trackPadY;
+  this->QueuedEvents.push_back(event);
+}
+
+//------------------------------------------------------------------------------
+int vtkVirtualRealityViewSimulatedInteractor::GetNumberOfQueuedEvents() const
+{
+  return static_cast<int>(this->QueuedEvents.size());
+}
+
+//------------------------------------------------------------------------------
+void vtkVirtualRealityViewSimulatedInteractor::UpdateEventDataFromDevicePose(
+  vtkVRRenderWindow* renWin, vtkEventDataDevice3D* ed)
+{
+  vtkMatrix4x4* pose = renWin->GetDeviceToPhysicalMatrixForDevice(ed->GetDevice());
+  if (pose == nullptr)
+  {
+    return;
+  }
+
+  double pos[3] = { 0.0, 0.0, 0.0 };
+  double ppos[3] = { 0.0, 0.0, 0.0 };
+  double wxyz[4] = { 0.0, 0.0, 0.0, 1.0 };
+  double wdir[3] = { 0.0, 0.0, 0.0 };
+  this->ConvertPoseToWorldCoordinates(pose, pos, wxyz, ppos, wdir);
+
+  ed->SetWorldPosition(pos);
+  ed->SetWorldOrientation(wxyz);
+  ed->SetWorldDirection(wdir);
+
+  int pointerIndex = static_cast<int>(ed->GetDevice());
+  this->SetPhysicalEventPose(pose, pointerIndex);
+  this->SetWorldEventPosition(pos[0], pos[1], pos[2], pointerIndex);
+  this->SetWorldEventOrientation(wxyz[0], wxyz[1], wxyz[2], wxyz[3], pointerIndex);
+  this->SetPointerIndex(pointerIndex);
+}
+
+//------------------------------------------------------------------------------
+void vtkVirtualRealityViewSimulatedInteractor::DispatchEvent(vtkVRRenderWindow* renWin, const QueuedEvent& event)
+{
+  vtkNew<vtkEventDataDevice3D> ed;
+  ed->SetDevice(event.Device);
+  ed->SetAction(event.Action);
+  this->UpdateEventDataFromDevicePose(renWin, ed);
+
+  if (event.Path.empty())
+  {
+    ed->SetInput(event.Input);
+    if (event.Input == vtkEventDataDeviceInput::TrackPad)
+    {
+      ed->SetTrackPadPosition(event.TrackPadPosition[0], event.TrackPadPosition[1]);
+    }
+    this->InvokeEvent(event.EventId, ed);
+    return;
+  }
+
+  std::map<std::string, ActionData>::iterator actionIt = this->ActionMap.find(event.Path);
+  if (actionIt == this->ActionMap.end())
+  {
+    return;
+  }
+  const ActionData& actionData = actionIt->second;
+  if (actionData.IsAnalog)
+  {
+    ed->SetInput(vtkEventDataDeviceInput::TrackPad);
+    ed->SetTrackPadPosition(event.TrackPadPosition[0], event.TrackPadPosition[1]);
+  }
+  if (actionData.UseFunction)
+  {
+    actionData.Function(ed);
+  }
+  else
+  {
+    this->InvokeEvent(actionData.EventId, ed);
+  }
+}
+
+//------------------------------------------------------------------------------
+void vtkVirtualRealityViewSimulatedInteractor::DoOneEvent(vtkVRRenderWindow* renWin, vtkRenderer* ren)
+{
+  if (renWin == nullptr || ren == nullptr)
+  {
+    return;
+  }
+
+  // Give scripted or recorded sources the opportunity to update the device poses
+  this->InvokeEvent(UpdateDevicesEvent);
+
+  for (vtkEventDataDevice device : { vtkEventDataDevice::LeftController, vtkEventDataDevice::RightController })
+  {
+    if (renWin->GetDeviceToPhysicalMatrixForDevice(device) == nullptr)
+    {
+      continue;
+    }
+    vtkNew<vtkEventDataDevice3D> ed;
+    ed->SetDevice(device);
+    this->UpdateEventDataFromDevicePose(renWin, ed);
+    this->InvokeEvent(vtkCommand::Move3DEvent, ed);
+  }
+
+  // Swap the queues so that events queued by observers are processed in the next frame
+  this->DispatchedEvents.clear();
+  this->DispatchedEvents.swap(this->QueuedEvents);
+  for (const QueuedEvent& event : this->DispatchedEvents)
+  {
+    this->DispatchEvent(renWin, event);
+  }
+
+  renWin->Render();
+}
@@ -0,0 +1,146 @@
+/*==============================================================================
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#ifndef vtkVirtualRealityViewSimulatedInteractor_h
+#define vtkVirtualRealityViewSimulatedInteractor_h
+
+// VR MRMLDM includes
+#include "vtkSlicerVirtualRealityModuleMRMLDisplayableManagerExport.h"
+#include "vtkVirtualRealityComplexGestureRecognizer.h"
+
+// VTK Rendering/VR includes
+#include <vtkVRRenderWindowInteractor.h>
+
+// VTK includes
+#include <vtkEventData.h>
+#include <vtkNew.h>
+
+// STD includes
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+/// \brief Interactor of the simulated XR backend.
+///
+/// Device poses are read from the vtkVirtualRealitySimulatedRenderWindow and input events
+/// are queued programmatically, which allows driving the virtual reality view from a script,
+/// a recorded session or a test without any XR runtime.
+///
+/// At each call to DoOneEvent(), the interactor:
+/// 1. invokes UpdateDevicesEvent, observers may update the device poses at that time,
+/// 2. invokes Move3DEvent for each controller that has a pose,
+/// 3. dispatches the queued events,
+/// 4. renders the window.
+class VTK_SLICER_VIRTUALREALITY_MODULE_MRMLDISPLAYABLEMANAGER_EXPORT vtkVirtualRealityViewSimulatedInteractor
+  : public vtkVRRenderWindowInteractor
+{
+public:
+  static vtkVirtualRealityViewSimulatedInteractor *New();
+  vtkTypeMacro(vtkVirtualRealityViewSimulatedInteractor, vtkVRRenderWindowInteractor);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  enum Events
+  {
+    /// Invoked at the beginning of each DoOneEvent() call, before device poses are processed.
+    UpdateDevicesEvent = vtkCommand::UserEvent + 5412
+  };
+
+  /// Initialize the interactor and set up the actions of the interactor style.
+  void Initialize() override;
+
+  /// Process device poses and queued events, then render.
+  void DoOneEvent(vtkVRRenderWindow* renWin, vtkRenderer* ren) override;
+
+  ///@{
+  /// Associate an action path (e.g "/actions/vtk/in/TriggerAction") with an event or a function.
+  void AddAction(const std::string& path, const vtkCommand::EventIds& eid, bool isAnalog) override;
+  void AddAction(const std::string& path, bool isAnalog, const std::function<void(vtkEventData*)>& func) override;
+  ///@}
+
+  /// Return true if an action is associated with the given path.
+  bool HasAction(const std::string& path) const;
+
+  /// Queue an action event, dispatched during the next DoOneEvent() call.
+  /// The track pad position is only used by analog actions.
+  /// Returns false if no action is associated with the given path.
+  bool QueueActionEvent(const std::string& path, vtkEventDataDevice device, vtkEventDataAction action,
+    double trackPadX = 0.0, double trackPadY = 0.0);
+
+  /// Queue a Button3DEvent, dispatched during the next DoOneEvent() call.
+  void QueueButton3DEvent(vtkEventDataDevice device, vtkEventDataDeviceInput input, vtkEventDataAction action);
+
+  /// Queue an event with vtkEventDataDevice3D call data, dispatched during the next DoOneEvent() call.
+  /// The track pad position is only set if the input is vtkEventDataDeviceInput::TrackPad.
+  void QueueDevice3DEvent(unsigned long eventId, vtkEventDataDevice device, vtkEventDataDeviceInput input,
+    vtkEventDataAction action, double trackPadX = 0.0, double trackPadY = 0.0);
+
+  /// Number of events waiting to be dispatched.
+  int GetNumberOfQueuedEvents() const;
+
+  ///@{
+  /// Define Slicer specific heuristic for handling complex gestures.
+  void HandleComplexGestureEvents(vtkEventData* ed) override
+  {
+    this->ComplexGestureRecognizer->HandleComplexGestureEvents(ed);
+  }
+  void RecognizeComplexGesture(vtkEventDataDevice3D* edata) override
+  {
+    this->ComplexGestureRecognizer->RecognizeComplexGesture(edata);
+  }
+  ///@}
+
+protected:
+  vtkVirtualRealityViewSimulatedInteractor();
+  ~vtkVirtualRealityViewSimulatedInteractor() override;
+
+  struct ActionData
+  {
+    vtkCommand::EventIds EventId{vtkCommand::NoEvent};
+    std::function<void(vtkEventData*)> Function;
+    bool UseFunction{false};
+    bool IsAnalog{false};
+  };
+
+  struct QueuedEvent
+  {
+    std::string Path; ///< If empty, EventId is invoked
+    unsigned long EventId{vtkCommand::NoEvent};
+    vtkEventDataDevice Device{vtkEventDataDevice::Unknown};
+    vtkEventDataDeviceInput Input{vtkEventDataDeviceInput::Unknown};
+    vtkEventDataAction Action{vtkEventDataAction::Unknown};
+    double TrackPadPosition[2]{0.0, 0.0};
+  };
+
+  /// Set device, world pose and pointer index of the event data from the current device pose.
+  void UpdateEventDataFromDevicePose(vtkVRRenderWindow* renWin, vtkEventDataDevice3D* ed);
+
+  void DispatchEvent(vtkVRRenderWindow* renWin, const QueuedEvent& event);
+
+  vtkNew<vtkVirtualRealityComplexGestureRecognizer> ComplexGestureRecognizer;
+
+  std::map<std::string, ActionData> ActionMap;
+
+  /// Events queued since the last DoOneEvent() call. Events queued while dispatching
+  /// are processed in the next frame.
+  std::vector<QueuedEvent> QueuedEvents;
+  std::vector<QueuedEvent> DispatchedEvents;
+
+private:
+  vtkVirtualRealityViewSimulatedInteractor(const vtkVirtualRealityViewSimulatedInteractor&) = delete;
+  void operator=(const vtkVirtualRealityViewSimulatedInteractor&) = delete;
+};
+
+#endif
@@ -0,0 +1,67 @@
+/*==============================================================================
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// VR MRMLDM includes
+#include "vtkVirtualRealityViewSimulatedInteractor.h"
+#include "vtkVirtualRealityViewSimulatedInteractorStyle.h"
+
+// VTK includes
+#include <vtkActor.h>
+#include <vtkObjectFactory.h>
+#include <vtkPropCollection.h>
+#include <vtkTextActor3D.h>
+#include <vtkVRControlsHelper.h>
+#include <vtkVRMenuRepresentation.h>
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkVirtualRealityViewSimulatedInteractorStyle);
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityViewSimulatedInteractorStyle::GetInteractorStyleProps(vtkPropCollection* props)
+{
+  props->AddItem(this->MenuRepresentation);
+  props->AddItem(this->TextActor3D);
+  props->AddItem(this->PickActor);
+  for (int device = 0; device < vtkEventDataNumberOfDevices; ++device)
+  {
+    for (int input = 0; input < vtkEventDataNumberOfInputs; ++input)
+    {
+      if (this->ControlsHelpers[device][input] != nullptr)
+      {
+        props->AddItem(this->ControlsHelpers[device][input]);
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityViewSimulatedInteractorStyle::SetupActions(vtkRenderWindowInteractor* iren)
+{
+  vtkVirtualRealityViewSimulatedInteractor* simulatedInteractor =
+    vtkVirtualRealityViewSimulatedInteractor::SafeDownCast(iren);
+  if (simulatedInteractor == nullptr)
+  {
+    return;
+  }
+  // Same bindings as vtkOpenVRInteractorStyle
+  simulatedInteractor->AddAction("/actions/vtk/in/Elevation", vtkCommand::Elevation3DEvent, true);
+  simulatedInteractor->AddAction("/actions/vtk/in/Movement", vtkCommand::ViewerMovement3DEvent, true);
+  simulatedInteractor->AddAction("/actions/vtk/in/NextCameraPose", vtkCommand::NextPose3DEvent, false);
+  simulatedInteractor->AddAction("/actions/vtk/in/PositionProp", vtkCommand::PositionProp3DEvent, false);
+  simulatedInteractor->AddAction("/actions/vtk/in/ShowMenu", vtkCommand::Menu3DEvent, false);
+  simulatedInteractor->AddAction("/actions/vtk/in/StartElevation", vtkCommand::Elevation3DEvent, false);
+  simulatedInteractor->AddAction("/actions/vtk/in/StartMovement", vtkCommand::ViewerMovement3DEvent, false);
+  simulatedInteractor->AddAction("/actions/vtk/in/TriggerAction", vtkCommand::Select3DEvent, false);
+}
@@ -0,0 +1,110 @@
+/*==============================================================================
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#ifndef vtkVirtualRealityViewSimulatedInteractorStyle_h
+#define vtkVirtualRealityViewSimulatedInteractorStyle_h
+
+// VR MRMLDM includes
+#include "vtkSlicerVirtualRealityModuleMRMLDisplayableManagerExport.h"
+#include "vtkVirtualRealityViewInteractorStyleDelegate.h"
+
+// VTK Rendering/VR includes
+#include <vtkVRInteractorStyle.h>
+
+// VTK includes
+#include <vtkObject.h>
+#include <vtkEventData.h>
+#include <vtkSmartPointer.h>
+
+class vtkPropCollection;
+
+/// \brief Interactor style of the simulated XR backend.
+///
+/// Actions are set up with the same paths and events as the default OpenVR bindings,
+/// so that the same action paths can be queued in vtkVirtualRealityViewSimulatedInteractor.
+class VTK_SLICER_VIRTUALREALITY_MODULE_MRMLDISPLAYABLEMANAGER_EXPORT vtkVirtualRealityViewSimulatedInteractorStyle
+  : public vtkVRInteractorStyle
+{
+public:
+  static vtkVirtualRealityViewSimulatedInteractorStyle *New();
+  vtkTypeMacro(vtkVirtualRealityViewSimulatedInteractorStyle,vtkVRInteractorStyle);
+
+  ///@{
+  /// Set/get delegate
+  void SetInteractorStyleDelegate(vtkVirtualRealityViewInteractorStyleDelegate* delegate)
+  {
+    vtkSetSmartPointerBodyMacro(InteractorStyleDelegate, vtkVirtualRealityViewInteractorStyleDelegate, delegate);
+    if (delegate != nullptr)
+      {
+      delegate->SetInteractorStyle(this);
+      }
+  }
+  vtkGetSmartPointerMacro(InteractorStyleDelegate, vtkVirtualRealityViewInteractorStyleDelegate);
+  ///}@
+
+  /// Add the props that the interactor style displays in the renderer (menu, pick feedback
+  /// and controls helpers) to the collection. They are not created by displayable managers.
+  void GetInteractorStyleProps(vtkPropCollection* props);
+
+  /// Set up the default actions of the simulated interactor.
+  void SetupActions(vtkRenderWindowInteractor* iren) override;
+
+  /// Simulated devices do not have models.
+  void LoadControllerModels() override {}
+
+  //@{
+  /**
+  * Interaction mode entry points.
+  */
+  void StartPositionProp(vtkEventDataDevice3D * edata) override { this->InteractorStyleDelegate->StartPositionProp(edata); }
+  void EndPositionProp(vtkEventDataDevice3D * edata) override { this->InteractorStyleDelegate->EndPositionProp(edata); }
+  //@}
+
+  //@{
+  /**
+  * Multitouch events binding.
+  */
+  void StartGesture() override { this->InteractorStyleDelegate->StartGesture(); }
+  void EndGesture() override { this->InteractorStyleDelegate->EndGesture(); }
+  void OnPan() override { this->InteractorStyleDelegate->OnPan(); }
+  void OnPinch() override { this->InteractorStyleDelegate->OnPinch(); }
+  void OnRotate() override { this->InteractorStyleDelegate->OnRotate(); }
+  //@}
+
+  //@{
+  /**
+  * Methods for interaction.
+  */
+  void PositionProp(vtkEventData* ed, double* lwpos = nullptr, double* lwori = nullptr) override
+  {
+    this->InteractorStyleDelegate->PositionProp(ed, lwpos, lwori);
+  }
+  //@}
+
+protected:
+  vtkVirtualRealityViewSimulatedInteractorStyle() = default;
+  ~vtkVirtualRealityViewSimulatedInteractorStyle() override = default;
+
+  /// Controls helpers are not displayed in the simulated view.
+  vtkVRControlsHelper* MakeControlsHelper() override { return nullptr; }
+
+  vtkSmartPointer<vtkVirtualRealityViewInteractorStyleDelegate> InteractorStyleDelegate;
+
+private:
+  vtkVirtualRealityViewSimulatedInteractorStyle(const vtkVirtualRealityViewSimulatedInteractorStyle&) = delete;
+  void operator=(const vtkVirtualRealityViewSimulatedInteractorStyle&) = delete;
+};
+
+#endif
@@ -0,0 +1,377 @@
+/*==============================================================================
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+// VR MRMLDM includes
+#include "vtkVirtualRealityVisiblePropBoundsCache.h"
+
+// MRML includes
+#include <vtkMRMLAbstractViewNode.h>
+#include <vtkMRMLDisplayableNode.h>
+#include <vtkMRMLDisplayNode.h>
+#include <vtkMRMLScene.h>
+
+// VTK includes
+#include <vtkBoundingBox.h>
+#include <vtkCallbackCommand.h>
+#include <vtkMath.h>
+#include <vtkObjectFactory.h>
+
+// STD includes
+#include <vector>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+bool ContainsBounds(const double outerBounds[6], const double innerBounds[6])
+{
+  return outerBounds[0] <= innerBounds[0] && outerBounds[1] >= innerBounds[1]
+    && outerBounds[2] <= innerBounds[2] && outerBounds[3] >= innerBounds[3]
+    && outerBounds[4] <= innerBounds[4] && outerBounds[5] >= innerBounds[5];
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkVirtualRealityVisiblePropBoundsCache);
+
+//----------------------------------------------------------------------------
+vtkVirtualRealityVisiblePropBoundsCache::vtkVirtualRealityVisiblePropBoundsCache()
+{
+  this->CallbackCommand->SetClientData(this);
+  this->CallbackCommand->SetCallback(vtkVirtualRealityVisiblePropBoundsCache::ProcessEvents);
+  vtkMath::UninitializeBounds(this->Bounds);
+}
+
+//----------------------------------------------------------------------------
+vtkVirtualRealityVisiblePropBoundsCache::~vtkVirtualRealityVisiblePropBoundsCache()
+{
+  this->SetScene(nullptr);
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityVisiblePropBoundsCache::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "ViewNode: " << (this->ViewNode ? this->ViewNode->GetID() : "(none)") << "\n";
+  os << indent << "NumberOfNodes: " << this->GetNumberOfNodes() << "\n";
+  os << indent << "NumberOfInvalidatedNodes: " << this->GetNumberOfInvalidatedNodes() << "\n";
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityVisiblePropBoundsCache::SetViewNode(vtkMRMLAbstractViewNode* viewNode)
+{
+  if (this->ViewNode == viewNode)
+  {
+    return;
+  }
+  this->ViewNode = viewNode;
+  this->SetScene(viewNode ? viewNode->GetScene() : nullptr);
+  // Visibility of the nodes depends on the view
+  this->InvalidateAll();
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+vtkMRMLAbstractViewNode* vtkVirtualRealityVisiblePropBoundsCache::GetViewNode()
+{
+  return this->ViewNode;
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityVisiblePropBoundsCache::SetScene(vtkMRMLScene* scene)
+{
+  if (this->Scene == scene)
+  {
+    return;
+  }
+  this->RemoveAllNodes();
+  if (this->Scene != nullptr)
+  {
+    this->Scene->RemoveObserver(this->CallbackCommand);
+  }
+  this->Scene = scene;
+  if (this->Scene == nullptr)
+  {
+    return;
+  }
+  this->Scene->AddObserver(vtkMRMLScene::NodeAddedEvent, this->CallbackCommand);
+  this->Scene->AddObserver(vtkMRMLScene::NodeRemovedEvent, this->CallbackCommand);
+  this->Scene->AddObserver(vtkCommand::DeleteEvent, this->CallbackCommand);
+
+  std::vector<vtkMRMLNode*> nodes;
+  this->Scene->GetNodesByClass("vtkMRMLDisplayableNode", nodes);
+  for (vtkMRMLNode* node : nodes)
+  {
+    this->AddNode(vtkMRMLDisplayableNode::SafeDownCast(node));
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityVisiblePropBoundsCache::ProcessEvents(
+  vtkObject* caller, unsigned long event, void* clientData, void* callData)
+{
+  vtkVirtualRealityVisiblePropBoundsCache* self = reinterpret_cast<vtkVirtualRealityVisiblePropBoundsCache*>(clientData);
+  if (caller == self->Scene.GetPointer())
+  {
+    switch (event)
+    {
+      case vtkMRMLScene::NodeAddedEvent:
+        self->AddNode(vtkMRMLDisplayableNode::SafeDownCast(reinterpret_cast<vtkObject*>(callData)));
+        break;
+      case vtkMRMLScene::NodeRemovedEvent:
+        self->RemoveNode(vtkMRMLDisplayableNode::SafeDownCast(reinterpret_cast<vtkObject*>(callData)));
+        break;
+      case vtkCommand::DeleteEvent:
+        self->RemoveAllNodes();
+        break;
+      default:
+        break;
+    }
+    return;
+  }
+
+  vtkMRMLDisplayableNode* node = reinterpret_cast<vtkMRMLDisplayableNode*>(caller);
+  if (event == vtkCommand::DeleteEvent)
+  {
+    self->RemoveNode(node);
+    return;
+  }
+  self->InvalidateNode(node);
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityVisiblePropBoundsCache::AddNode(vtkMRMLDisplayableNode* node)
+{
+  if (node == nullptr || this->Entries.find(node) != this->Entries.end())
+  {
+    return;
+  }
+  Entry& entry = this->Entries[node];
+  vtkMath::UninitializeBounds(entry.Bounds);
+  // Content modification events are specific to each node type (mesh, control points, segments...),
+  // and transform and display modifications are forwarded by the displayable node,
+  // so any event invalidates the entry.
+  node->AddObserver(vtkCommand::AnyEvent, this->CallbackCommand);
+  this->InvalidatedNodes.insert(node);
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityVisiblePropBoundsCache::RemoveNode(vtkMRMLDisplayableNode* node)
+{
+  auto entryIt = this->Entries.find(node);
+  if (entryIt == this->Entries.end())
+  {
+    return;
+  }
+  node->RemoveObserver(this->CallbackCommand);
+  if (entryIt->second.Visible)
+  {
+    this->BoundsRebuildNeeded = true;
+  }
+  if (entryIt->second.Selectable)
+  {
+    this->HierarchyRebuildNeeded = true;
+  }
+  this->Entries.erase(entryIt);
+  this->InvalidatedNodes.erase(node);
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityVisiblePropBoundsCache::RemoveAllNodes()
+{
+  for (auto& entry : this->Entries)
+  {
+    entry.first->RemoveObserver(this->CallbackCommand);
+  }
+  this->Entries.clear();
+  this->InvalidatedNodes.clear();
+  this->BoundsRebuildNeeded = true;
+  this->HierarchyRebuildNeeded = true;
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityVisiblePropBoundsCache::InvalidateNode(vtkMRMLDisplayableNode* node)
+{
+  if (this->Entries.find(node) == this->Entries.end())
+  {
+    return;
+  }
+  this->InvalidatedNodes.insert(node);
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityVisiblePropBoundsCache::InvalidateAll()
+{
+  for (auto& entry : this->Entries)
+  {
+    this->InvalidatedNodes.insert(entry.first);
+  }
+  this->BoundsRebuildNeeded = true;
+}
+
+//----------------------------------------------------------------------------
+int vtkVirtualRealityVisiblePropBoundsCache::GetNumberOfNodes() const
+{
+  return static_cast<int>(this->Entries.size());
+}
+
+//----------------------------------------------------------------------------
+int vtkVirtualRealityVisiblePropBoundsCache::GetNumberOfInvalidatedNodes() const
+{
+  return static_cast<int>(this->InvalidatedNodes.size());
+}
+
+//----------------------------------------------------------------------------
+bool vtkVirtualRealityVisiblePropBoundsCache::IsVisibleInView(vtkMRMLDisplayableNode* node)
+{
+  const char* viewNodeID = this->ViewNode ? this->ViewNode->GetID() : nullptr;
+  for (int displayNodeIndex = 0; displayNodeIndex < node->GetNumberOfDisplayNodes(); ++displayNodeIndex)
+  {
+    vtkMRMLDisplayNode* displayNode = node->GetNthDisplayNode(displayNodeIndex);
+    if (displayNode == nullptr || displayNode->IsA("vtkMRMLVolumeDisplayNode"))
+    {
+      continue;
+    }
+    if (displayNode->GetVisibility() && displayNode->GetVisibility3D()
+      && (viewNodeID == nullptr || displayNode->IsDisplayableInView(viewNodeID)))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityVisiblePropBoundsCache::UpdateEntry(vtkMRMLDisplayableNode* node)
+{
+  Entry& entry = this->Entries[node];
+  bool wasVisible = entry.Visible;
+  double previousBounds[6] = { entry.Bounds[0], entry.Bounds[1], entry.Bounds[2],
+                               entry.Bounds[3], entry.Bounds[4], entry.Bounds[5] };
+
+  entry.Visible = false;
+  if (this->IsVisibleInView(node))
+  {
+    node->GetRASBounds(entry.Bounds);
+    entry.Visible = vtkMath::AreBoundsInitialized(entry.Bounds);
+  }
+
+  if (wasVisible && (!entry.Visible || !ContainsBounds(entry.Bounds, previousBounds)))
+  {
+    // Previous bounds may define the union, it cannot be shrunk incrementally
+    this->BoundsRebuildNeeded = true;
+  }
+  else if (entry.Visible && !this->BoundsRebuildNeeded)
+  {
+    vtkBoundingBox bounds;
+    if (vtkMath::AreBoundsInitialized(this->Bounds))
+    {
+      bounds.SetBounds(this->Bounds);
+    }
+    bounds.AddBounds(entry.Bounds);
+    bounds.GetBounds(this->Bounds);
+  }
+
+  bool wasSelectable = entry.Selectable;
+  entry.Selectable = entry.Visible && node->GetSelectable();
+  if (entry.Selectable != wasSelectable)
+  {
+    this->HierarchyRebuildNeeded = true;
+  }
+  else if (entry.Selectable && !this->HierarchyRebuildNeeded)
+  {
+    this->SelectableNodeHierarchy->SetItemBounds(entry.HierarchyItemIndex, entry.Bounds);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityVisiblePropBoundsCache::UpdateInvalidatedEntries()
+{
+  for (vtkMRMLDisplayableNode* node : this->InvalidatedNodes)
+  {
+    this->UpdateEntry(node);
+  }
+  this->InvalidatedNodes.clear();
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityVisiblePropBoundsCache::BuildSelectableNodeHierarchy()
+{
+  this->SelectableNodeHierarchy->Initialize();
+  this->HierarchyItemNodes.clear();
+  for (auto& entry : this->Entries)
+  {
+    if (!entry.second.Selectable)
+    {
+      entry.second.HierarchyItemIndex = -1;
+      continue;
+    }
+    entry.second.HierarchyItemIndex = this->SelectableNodeHierarchy->AddItem(entry.second.Bounds);
+    this->HierarchyItemNodes.push_back(entry.first);
+  }
+  this->SelectableNodeHierarchy->Build();
+  this->HierarchyRebuildNeeded = false;
+}
+
+//----------------------------------------------------------------------------
+void vtkVirtualRealityVisiblePropBoundsCache::FindSelectableNodesAtPoint(
+  const double point[3], double tolerance, std::vector<vtkMRMLDisplayableNode*>& nodes)
+{
+  nodes.clear();
+  this->UpdateInvalidatedEntries();
+  if (this->HierarchyRebuildNeeded)
+  {
+    this->BuildSelectableNodeHierarchy();
+  }
+  this->SelectableNodeHierarchy->FindItemsAtPoint(point, tolerance, this->HierarchyItemIndices);
+  for (int itemIndex : this->HierarchyItemIndices)
+  {
+    nodes.push_back(this->HierarchyItemNodes[itemIndex]);
+  }
+}
+
+//----------------------------------------------------------------------------
+bool vtkVirtualRealityVisiblePropBoundsCache::GetBounds(double bounds[6])
+{
+  this->UpdateInvalidatedEntries();
+
+  if (this->BoundsRebuildNeeded)
+  {
+    vtkBoundingBox visibleBounds;
+    for (auto& entry : this->Entries)
+    {
+      if (entry.second.Visible)
+      {
+        visibleBounds.AddBounds(entry.second.Bounds);
+      }
+    }
+    if (visibleBounds.IsValid())
+    {
+      visibleBounds.GetBounds(this->Bounds);
+    }
+    else
+    {
+      vtkMath::UninitializeBounds(this->Bounds);
+    }
+    this->BoundsRebuildNeeded = false;
+  }
+
+  for (int i = 0; i < 6; ++i)
+  {
+    bounds[i] = this->Bounds[i];
+  }
+  return vtkMath::AreBoundsInitialized(this->Bounds);
+}
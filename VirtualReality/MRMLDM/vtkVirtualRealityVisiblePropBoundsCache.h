@@ -0,0 +1,138 @@
+/*==============================================================================
+
+  Copyright (c) Kitware Inc.
+
+  See COPYRIGHT.txt
+  or http://www.slicer.org/copyright/copyright.txt for details.
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+==============================================================================*/
+
+#ifndef vtkVirtualRealityVisiblePropBoundsCache_h
+#define vtkVirtualRealityVisiblePropBoundsCache_h
+
+// VR MRMLDM includes
+#include "vtkSlicerVirtualRealityModuleMRMLDisplayableManagerExport.h"
+
+// VR Logic includes
+#include "vtkVirtualRealityBoundingVolumeHierarchy.h"
+
+// VTK includes
+#include <vtkNew.h>
+#include <vtkObject.h>
+#include <vtkWeakPointer.h>
+
+// STD includes
+#include <map>
+#include <set>
+#include <vector>
+
+class vtkCallbackCommand;
+class vtkMRMLAbstractViewNode;
+class vtkMRMLDisplayableNode;
+class vtkMRMLScene;
+
+/// \brief World bounds of the displayable nodes visible in a view, updated incrementally.
+///
+/// vtkRenderer::ComputeVisiblePropBounds() and vtkRenderer::ResetCameraClippingRange() walk
+/// all the visible props of the renderer, which is too costly to do on each controller event
+/// when many nodes are displayed.
+///
+/// Instead, the RAS bounds of each displayable node of the scene are cached. Entries are
+/// invalidated from the events of the displayable node (including transform and display
+/// modifications, which the displayable node forwards), and only invalidated entries are
+/// recomputed when the bounds are requested.
+///
+/// A displayable node contributes to the bounds if one of its display nodes is visible in 3D
+/// and displayable in the view. Volume display nodes are ignored, slices are displayed in
+/// 3D views by the slice model nodes.
+///
+/// Visible nodes that are selectable are also indexed in a bounding volume hierarchy, which is
+/// refitted when their bounds change and rebuilt when nodes are added, removed, shown or hidden.
+/// \sa FindSelectableNodesAtPoint()
+class VTK_SLICER_VIRTUALREALITY_MODULE_MRMLDISPLAYABLEMANAGER_EXPORT vtkVirtualRealityVisiblePropBoundsCache : public vtkObject
+{
+public:
+  static vtkVirtualRealityVisiblePropBoundsCache* New();
+  vtkTypeMacro(vtkVirtualRealityVisiblePropBoundsCache, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  ///@{
+  /// View the bounds are computed for. Displayable nodes of the view node scene are observed.
+  void SetViewNode(vtkMRMLAbstractViewNode* viewNode);
+  vtkMRMLAbstractViewNode* GetViewNode();
+  ///}@
+
+  /// Get the bounds of the visible displayable nodes in world coordinates.
+  /// Returns false if no visible displayable node has valid bounds.
+  bool GetBounds(double bounds[6]);
+
+  /// Get the visible and selectable displayable nodes whose bounds, enlarged by tolerance,
+  /// contain the point (in world coordinates). These are candidates, exact picking is left
+  /// to the caller.
+  void FindSelectableNodesAtPoint(const double point[3], double tolerance, std::vector<vtkMRMLDisplayableNode*>& nodes);
+
+  /// Number of displayable nodes that are observed.
+  int GetNumberOfNodes() const;
+
+  /// Number of displayable nodes whose bounds must be recomputed at the next GetBounds() call.
+  int GetNumberOfInvalidatedNodes() const;
+
+  /// Invalidate all the entries, for example after changing the view node attributes.
+  void InvalidateAll();
+
+protected:
+  vtkVirtualRealityVisiblePropBoundsCache();
+  ~vtkVirtualRealityVisiblePropBoundsCache() override;
+
+  static void ProcessEvents(vtkObject* caller, unsigned long event, void* clientData, void* callData);
+
+  void SetScene(vtkMRMLScene* scene);
+  void AddNode(vtkMRMLDisplayableNode* node);
+  void RemoveNode(vtkMRMLDisplayableNode* node);
+  void RemoveAllNodes();
+  void InvalidateNode(vtkMRMLDisplayableNode* node);
+  void UpdateEntry(vtkMRMLDisplayableNode* node);
+  void UpdateInvalidatedEntries();
+  void BuildSelectableNodeHierarchy();
+  bool IsVisibleInView(vtkMRMLDisplayableNode* node);
+
+  struct Entry
+  {
+    double Bounds[6];
+    bool Visible{false};
+    bool Selectable{false};
+    int HierarchyItemIndex{-1};
+  };
+
+  vtkWeakPointer<vtkMRMLAbstractViewNode> ViewNode;
+  vtkWeakPointer<vtkMRMLScene> Scene;
+  vtkNew<vtkCallbackCommand> CallbackCommand;
+
+  std::map<vtkMRMLDisplayableNode*, Entry> Entries;
+  std::set<vtkMRMLDisplayableNode*> InvalidatedNodes;
+
+  /// Union of the bounds of the visible entries
+  double Bounds[6];
+  /// Set when an entry was removed or its bounds moved, the union must then be recomputed from all entries
+  bool BoundsRebuildNeeded{true};
+
+  vtkNew<vtkVirtualRealityBoundingVolumeHierarchy> SelectableNodeHierarchy;
+  /// Displayable node of each hierarchy item
+  std::vector<vtkMRMLDisplayableNode*> HierarchyItemNodes;
+  /// Set when selectable nodes are added or removed, item indices must then be reassigned
+  bool HierarchyRebuildNeeded{true};
+  /// Query result, kept to avoid allocations
+  std::vector<int> HierarchyItemIndices;
+
+private:
+  vtkVirtualRealityVisiblePropBoundsCache(const vtkVirtualRealityVisiblePropBoundsCache&) = delete;
+  void operator=(const vtkVirtualRealityVisiblePropBoundsCache&) = delete;
+};
+
+#endif
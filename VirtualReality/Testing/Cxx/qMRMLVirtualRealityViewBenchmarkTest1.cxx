@@ -0,0 +1,535 @@
+// VirtualReality Logic includes
+#include <vtkVirtualRealityFrameTimingLog.h>
+
+// VirtualReality MRML includes
+#include <vtkMRMLVirtualRealityViewNode.h>
+
+// VirtualReality MRMLDM includes
+#include <vtkVirtualRealitySimulatedRenderWindow.h>
+
+// VirtualReality Widgets includes
+#include <qMRMLVirtualRealityView.h>
+
+// Slicer includes
+#include <qSlicerApplication.h>
+#include <vtkSlicerApplicationLogic.h>
+
+// Markups includes
+#include <vtkMRMLMarkupsFiducialNode.h>
+#include <vtkSlicerMarkupsLogic.h>
+
+// Volume rendering includes
+#include <vtkMRMLVolumeRenderingDisplayNode.h>
+#include <vtkSlicerVolumeRenderingLogic.h>
+
+// Segmentations includes
+#include <vtkBinaryLabelmapToClosedSurfaceConversionRule.h>
+#include <vtkMRMLSegmentationNode.h>
+#include <vtkOrientedImageData.h>
+#include <vtkSegmentationConverterFactory.h>
+
+// MRML includes
+#include <vtkMRMLCoreTestingMacros.h>
+#include <vtkMRMLModelNode.h>
+#include <vtkMRMLScalarVolumeNode.h>
+#include <vtkMRMLScene.h>
+
+// Qt includes
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+// VTK includes
+#include <vtkAutoInit.h>
+#include <vtkCallbackCommand.h>
+#include <vtkImageEllipsoidSource.h>
+#include <vtkMatrix4x4.h>
+#include <vtkNew.h>
+#include <vtkPolyData.h>
+#include <vtkRTAnalyticSource.h>
+#include <vtkSphereSource.h>
+
+// STD includes
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <map>
+#include <new>
+#include <string>
+
+VTK_MODULE_INIT(vtkSlicerMarkupsModuleMRMLDisplayableManager);
+VTK_MODULE_INIT(vtkSlicerSegmentationsModuleMRMLDisplayableManager);
+VTK_MODULE_INIT(vtkSlicerVolumeRenderingModuleMRMLDisplayableManager);
+
+//----------------------------------------------------------------------------
+// Heap allocations are counted by replacing the global allocation functions, this test is
+// therefore built in its own test driver.
+// Allocations made by shared libraries using their own allocator (e.g on Windows) are not counted.
+namespace
+{
+std::atomic<bool> CountAllocations{false};
+std::atomic<long long> NumberOfAllocations{0};
+}
+
+//----------------------------------------------------------------------------
+void* operator new(std::size_t size)
+{
+  if (CountAllocations.load(std::memory_order_relaxed))
+  {
+    NumberOfAllocations.fetch_add(1, std::memory_order_relaxed);
+  }
+  if (void* ptr = std::malloc(size > 0 ? size : 1))
+  {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+//----------------------------------------------------------------------------
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+//----------------------------------------------------------------------------
+void operator delete(void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+// Size of the synthetic scene
+const int NumberOfModels = 500;
+const int NumberOfSegments = 5;
+const int SegmentationDimension = 160;
+const int VolumeDimension = 192;
+const int NumberOfMarkupsNodes = 30;
+const int NumberOfControlPointsPerMarkupsNode = 10;
+
+//----------------------------------------------------------------------------
+struct BenchmarkOptions
+{
+  std::string OutputDirectory;
+  int NumberOfWarmUpFrames{30};
+  int NumberOfFrames{300};
+  // Thresholds are ignored if negative
+  double MaximumP99FrameTime{-1.0};
+  double MaximumAllocationsPerFrame{-1.0};
+  double MaximumEventsPerFrame{-1.0};
+};
+
+//----------------------------------------------------------------------------
+bool ParseOptions(int argc, char* argv[], BenchmarkOptions& options)
+{
+  if (argc < 2)
+  {
+    return false;
+  }
+  options.OutputDirectory = argv[1];
+  for (int i = 2; i + 1 < argc; i += 2)
+  {
+    double value = atof(argv[i + 1]);
+    if (strcmp(argv[i], "--frames") == 0)
+    {
+      options.NumberOfFrames = static_cast<int>(value);
+    }
+    else if (strcmp(argv[i], "--warm-up-frames") == 0)
+    {
+      options.NumberOfWarmUpFrames = static_cast<int>(value);
+    }
+    else if (strcmp(argv[i], "--max-p99-frame-time-ms") == 0)
+    {
+      options.MaximumP99FrameTime = value;
+    }
+    else if (strcmp(argv[i], "--max-allocations-per-frame") == 0)
+    {
+      options.MaximumAllocationsPerFrame = value;
+    }
+    else if (strcmp(argv[i], "--max-events-per-frame") == 0)
+    {
+      options.MaximumEventsPerFrame = value;
+    }
+    else
+    {
+      std::cerr << "Unknown option: " << argv[i] << std::endl;
+      return false;
+    }
+  }
+  return options.NumberOfFrames > 0 && options.NumberOfWarmUpFrames >= 0;
+}
+
+//----------------------------------------------------------------------------
+struct EventCounter
+{
+  bool Enabled{false};
+  std::map<std::string, long long> Counts;
+};
+
+//----------------------------------------------------------------------------
+void CountEventCallback(vtkObject* vtkNotUsed(caller), unsigned long eventId, void* clientData, void* vtkNotUsed(callData))
+{
+  EventCounter* counter = reinterpret_cast<EventCounter*>(clientData);
+  if (counter->Enabled)
+  {
+    // Allocations of the counter are not made by the view
+    bool countAllocations = CountAllocations.exchange(false);
+    counter->Counts[vtkCommand::GetStringFromEventId(eventId)]++;
+    CountAllocations = countAllocations;
+  }
+}
+
+//----------------------------------------------------------------------------
+void AddModels(vtkMRMLScene* scene)
+{
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetRadius(8.0);
+  sphere->SetThetaResolution(24);
+  sphere->SetPhiResolution(24);
+  sphere->Update();
+  int modelsPerRow = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(NumberOfModels))));
+  for (int modelIndex = 0; modelIndex < NumberOfModels; ++modelIndex)
+  {
+    vtkNew<vtkPolyData> polyData;
+    polyData->DeepCopy(sphere->GetOutput());
+    vtkMRMLModelNode* modelNode = vtkMRMLModelNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLModelNode"));
+    modelNode->SetAndObservePolyData(polyData);
+    modelNode->CreateDefaultDisplayNodes();
+    // Spread the models on a grid in front of the user
+    vtkNew<vtkMatrix4x4> modelToWorld;
+    modelToWorld->SetElement(0, 3, 20.0 * (modelIndex % modelsPerRow) - 10.0 * modelsPerRow);
+    modelToWorld->SetElement(2, 3, 20.0 * (modelIndex / modelsPerRow) - 10.0 * modelsPerRow);
+    modelNode->ApplyTransformMatrix(modelToWorld);
+  }
+}
+
+//----------------------------------------------------------------------------
+void AddSegmentation(vtkMRMLScene* scene)
+{
+  vtkMRMLSegmentationNode* segmentationNode =
+    vtkMRMLSegmentationNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLSegmentationNode"));
+  segmentationNode->CreateDefaultDisplayNodes();
+  for (int segmentIndex = 0; segmentIndex < NumberOfSegments; ++segmentIndex)
+  {
+    vtkNew<vtkImageEllipsoidSource> ellipsoid;
+    ellipsoid->SetOutputScalarTypeToUnsignedChar();
+    ellipsoid->SetWholeExtent(0, SegmentationDimension - 1, 0, SegmentationDimension - 1, 0, SegmentationDimension - 1);
+    ellipsoid->SetCenter(SegmentationDimension * (segmentIndex + 1) / (NumberOfSegments + 1),
+      SegmentationDimension / 2, SegmentationDimension / 2);
+    ellipsoid->SetRadius(SegmentationDimension / (NumberOfSegments + 1), SegmentationDimension / 3, SegmentationDimension / 4);
+    ellipsoid->SetInValue(1);
+    ellipsoid->SetOutValue(0);
+    ellipsoid->Update();
+    vtkNew<vtkOrientedImageData> labelmap;
+    labelmap->ShallowCopy(ellipsoid->GetOutput());
+    segmentationNode->AddSegmentFromBinaryLabelmapRepresentation(labelmap, "Segment_" + std::to_string(segmentIndex));
+  }
+  segmentationNode->CreateClosedSurfaceRepresentation();
+}
+
+//----------------------------------------------------------------------------
+void AddVolumeRendering(vtkMRMLScene* scene, vtkSlicerVolumeRenderingLogic* volumeRenderingLogic)
+{
+  // Synthetic volume with CT-like intensity range
+  int halfDimension = VolumeDimension / 2;
+  vtkNew<vtkRTAnalyticSource> source;
+  source->SetWholeExtent(-halfDimension, halfDimension - 1, -halfDimension, halfDimension - 1, -halfDimension, halfDimension - 1);
+  source->SetMaximum(1000.0);
+  source->Update();
+  vtkMRMLScalarVolumeNode* volumeNode = vtkMRMLScalarVolumeNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLScalarVolumeNode"));
+  volumeNode->SetAndObserveImageData(source->GetOutput());
+  vtkMRMLVolumeRenderingDisplayNode* displayNode = volumeRenderingLogic->CreateDefaultVolumeRenderingNodes(volumeNode);
+  displayNode->SetVisibility(true);
+}
+
+//----------------------------------------------------------------------------
+void AddMarkups(vtkMRMLScene* scene)
+{
+  for (int nodeIndex = 0; nodeIndex < NumberOfMarkupsNodes; ++nodeIndex)
+  {
+    vtkMRMLMarkupsFiducialNode* markupsNode =
+      vtkMRMLMarkupsFiducialNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLMarkupsFiducialNode"));
+    markupsNode->CreateDefaultDisplayNodes();
+    for (int pointIndex = 0; pointIndex < NumberOfControlPointsPerMarkupsNode; ++pointIndex)
+    {
+      markupsNode->AddControlPoint(vtkVector3d(10.0 * pointIndex - 50.0, 10.0 * nodeIndex - 150.0, 50.0));
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+/// Device poses following a script, matrices are allocated once
+struct ScriptedDevicePoses
+{
+  vtkNew<vtkMatrix4x4> HMDPose;
+  vtkNew<vtkMatrix4x4> ControllerPoses[2];
+
+  void Apply(vtkVirtualRealitySimulatedRenderWindow* renderWindow, int frameIndex)
+  {
+    if (renderWindow == nullptr)
+    {
+      return;
+    }
+    // Head moves along a circle of 0.5 m radius while looking around, at typical head speed.
+    const double pi = 3.14159265358979323846;
+    double angle = 2.0 * pi * frameIndex / 360.0;
+    this->HMDPose->SetElement(0, 0, std::cos(angle));
+    this->HMDPose->SetElement(0, 2, std::sin(angle));
+    this->HMDPose->SetElement(2, 0, -std::sin(angle));
+    this->HMDPose->SetElement(2, 2, std::cos(angle));
+    this->HMDPose->SetElement(0, 3, 0.5 * std::cos(angle));
+    this->HMDPose->SetElement(1, 3, 1.7);
+    this->HMDPose->SetElement(2, 3, 0.5 * std::sin(angle));
+    renderWindow->SetDeviceToPhysicalMatrix(vtkVirtualRealitySimulatedRenderWindow::HMDDeviceHandle,
+      vtkEventDataDevice::HeadMountedDisplay, this->HMDPose);
+
+    // Controllers sweep in front of the user
+    for (int controllerIndex = 0; controllerIndex < 2; ++controllerIndex)
+    {
+      double side = controllerIndex == 0 ? -1.0 : 1.0;
+      vtkMatrix4x4* controllerPose = this->ControllerPoses[controllerIndex];
+      controllerPose->SetElement(0, 3, side * 0.3 + 0.2 * std::sin(4.0 * angle));
+      controllerPose->SetElement(1, 3, 1.2 + 0.1 * std::cos(4.0 * angle));
+      controllerPose->SetElement(2, 3, -0.4);
+      renderWindow->SetDeviceToPhysicalMatrix(
+        controllerIndex == 0 ? vtkVirtualRealitySimulatedRenderWindow::LeftControllerDeviceHandle
+                             : vtkVirtualRealitySimulatedRenderWindow::RightControllerDeviceHandle,
+        controllerIndex == 0 ? vtkEventDataDevice::LeftController : vtkEventDataDevice::RightController,
+        controllerPose);
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+/// Devices are posed once at the start of each frame of the view, and allocations, events
+/// and CPU time are only measured between the start and the end of the frames.
+struct FrameMonitor
+{
+  qMRMLVirtualRealityView* View{nullptr};
+  EventCounter* Events{nullptr};
+  ScriptedDevicePoses Poses;
+  int FrameIndex{0};
+  bool Measuring{false};
+  std::clock_t FrameStartCPUTime{0};
+  double CPUTime{0.0};
+};
+
+//----------------------------------------------------------------------------
+void FrameStartedCallback(vtkObject* vtkNotUsed(caller), unsigned long vtkNotUsed(eventId), void* clientData, void* vtkNotUsed(callData))
+{
+  FrameMonitor* monitor = reinterpret_cast<FrameMonitor*>(clientData);
+  monitor->Poses.Apply(vtkVirtualRealitySimulatedRenderWindow::SafeDownCast(monitor->View->renderWindow()),
+    monitor->FrameIndex++);
+  if (monitor->Measuring)
+  {
+    monitor->Events->Enabled = true;
+    monitor->FrameStartCPUTime = std::clock();
+    CountAllocations = true;
+  }
+}
+
+//----------------------------------------------------------------------------
+void FrameEndedCallback(vtkObject* vtkNotUsed(caller), unsigned long vtkNotUsed(eventId), void* clientData, void* vtkNotUsed(callData))
+{
+  FrameMonitor* monitor = reinterpret_cast<FrameMonitor*>(clientData);
+  if (monitor->Measuring)
+  {
+    CountAllocations = false;
+    monitor->CPUTime += static_cast<double>(std::clock() - monitor->FrameStartCPUTime) / CLOCKS_PER_SEC;
+    monitor->Events->Enabled = false;
+  }
+}
+
+//----------------------------------------------------------------------------
+bool WaitForConnection(vtkMRMLVirtualRealityViewNode* viewNode, double timeoutSec)
+{
+  QElapsedTimer timer;
+  timer.start();
+  while (viewNode->GetConnectionState() != vtkMRMLVirtualRealityViewNode::ConnectionStateConnected)
+  {
+    if (timer.elapsed() > timeoutSec * 1000.0)
+    {
+      std::cerr << "View was not connected within " << timeoutSec << " seconds" << std::endl;
+      return false;
+    }
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 1);
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool RunFrames(qMRMLVirtualRealityView& view, vtkTypeInt64 numberOfFrames, double timeoutSec)
+{
+  vtkVirtualRealityFrameTimingLog* frameTimingLog = view.frameTimingLog();
+  vtkTypeInt64 lastFrame = frameTimingLog->GetNumberOfRecordedFrames() + numberOfFrames;
+  QElapsedTimer timer;
+  timer.start();
+  while (frameTimingLog->GetNumberOfRecordedFrames() < lastFrame)
+  {
+    if (timer.elapsed() > timeoutSec * 1000.0)
+    {
+      std::cerr << "Frames were not rendered within " << timeoutSec << " seconds" << std::endl;
+      return false;
+    }
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 1);
+  }
+  return true;
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+int qMRMLVirtualRealityViewBenchmarkTest1(int argc, char * argv[])
+{
+  BenchmarkOptions options;
+  if (!ParseOptions(argc, argv, options))
+  {
+    std::cerr << "Usage: " << argv[0] << " <output-directory> [--frames N] [--warm-up-frames N]"
+              << " [--max-p99-frame-time-ms T] [--max-allocations-per-frame N] [--max-events-per-frame N]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  int applicationArgc = 1;
+  qSlicerApplication app(applicationArgc, argv);
+  vtkSlicerApplicationLogic* appLogic = app.applicationLogic();
+
+  vtkMRMLScene* scene = app.mrmlScene();
+
+  vtkSegmentationConverterFactory::GetInstance()->RegisterConverterRule(
+    vtkSmartPointer<vtkBinaryLabelmapToClosedSurfaceConversionRule>::New());
+
+  vtkNew<vtkSlicerMarkupsLogic> markupsLogic;
+  markupsLogic->SetMRMLApplicationLogic(appLogic);
+  markupsLogic->SetMRMLScene(scene);
+  appLogic->SetModuleLogic("Markups", markupsLogic);
+
+  vtkNew<vtkSlicerVolumeRenderingLogic> volumeRenderingLogic;
+  volumeRenderingLogic->SetMRMLApplicationLogic(appLogic);
+  volumeRenderingLogic->SetMRMLScene(scene);
+  appLogic->SetModuleLogic("VolumeRendering", volumeRenderingLogic);
+
+  AddModels(scene);
+  AddSegmentation(scene);
+  AddVolumeRendering(scene, volumeRenderingLogic);
+  AddMarkups(scene);
+
+  vtkMRMLVirtualRealityViewNode* viewNode =
+    vtkMRMLVirtualRealityViewNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLVirtualRealityViewNode"));
+  viewNode->SetXRBackend(vtkMRMLVirtualRealityViewNode::Simulated);
+  viewNode->SetHMDTransformUpdate(true);
+  viewNode->SetControllerTransformsUpdate(true);
+
+  qMRMLVirtualRealityView view;
+  view.setMRMLVirtualRealityViewNode(viewNode);
+
+  // Count the events that are processed each frame
+  EventCounter eventCounter;
+  vtkNew<vtkCallbackCommand> eventCallback;
+  eventCallback->SetCallback(CountEventCallback);
+  eventCallback->SetClientData(&eventCounter);
+
+  FrameMonitor frameMonitor;
+  frameMonitor.View = &view;
+  frameMonitor.Events = &eventCounter;
+  vtkNew<vtkCallbackCommand> frameStartedCallback;
+  frameStartedCallback->SetCallback(FrameStartedCallback);
+  frameStartedCallback->SetClientData(&frameMonitor);
+  view.frameTimingLog()->AddObserver(vtkCommand::StartEvent, frameStartedCallback);
+  vtkNew<vtkCallbackCommand> frameEndedCallback;
+  frameEndedCallback->SetCallback(FrameEndedCallback);
+  frameEndedCallback->SetClientData(&frameMonitor);
+  view.frameTimingLog()->AddObserver(vtkCommand::EndEvent, frameEndedCallback);
+
+  const double timeoutSec = 600.0;
+  viewNode->SetVisibility(true);
+  CHECK_BOOL(WaitForConnection(viewNode, timeoutSec), true);
+  CHECK_NOT_NULL(vtkVirtualRealitySimulatedRenderWindow::SafeDownCast(view.renderWindow()));
+  viewNode->AddObserver(vtkCommand::AnyEvent, eventCallback);
+  view.interactor()->AddObserver(vtkCommand::AnyEvent, eventCallback);
+  viewNode->SetActive(true);
+
+  // Device transform nodes are created during the first frames
+  CHECK_BOOL(RunFrames(view, options.NumberOfWarmUpFrames + 1, timeoutSec), true);
+  for (vtkMRMLNode* transformNode : { static_cast<vtkMRMLNode*>(viewNode->GetHMDTransformNode()),
+                                      static_cast<vtkMRMLNode*>(viewNode->GetLeftControllerTransformNode()),
+                                      static_cast<vtkMRMLNode*>(viewNode->GetRightControllerTransformNode()) })
+  {
+    if (transformNode != nullptr)
+    {
+      transformNode->AddObserver(vtkCommand::AnyEvent, eventCallback);
+    }
+  }
+
+  // Measured frames
+  view.frameTimingLog()->SetCapacity(options.NumberOfFrames);
+  NumberOfAllocations = 0;
+  frameMonitor.Measuring = true;
+  bool framesRendered = RunFrames(view, options.NumberOfFrames, timeoutSec);
+  frameMonitor.Measuring = false;
+  CHECK_BOOL(framesRendered, true);
+
+  // Report
+  double numberOfFrames = options.NumberOfFrames;
+  long long numberOfEvents = 0;
+  QJsonObject eventsPerFrame;
+  for (const auto& eventCount : eventCounter.Counts)
+  {
+    eventsPerFrame[QString::fromStdString(eventCount.first)] = eventCount.second / numberOfFrames;
+    numberOfEvents += eventCount.second;
+  }
+  double processCPUTimePerFrame = 1000.0 * frameMonitor.CPUTime / numberOfFrames;
+  double allocationsPerFrame = NumberOfAllocations / numberOfFrames;
+
+  QJsonObject report;
+  report["NumberOfModels"] = NumberOfModels;
+  report["NumberOfSegments"] = NumberOfSegments;
+  report["VolumeDimension"] = VolumeDimension;
+  report["NumberOfMarkupsControlPoints"] = NumberOfMarkupsNodes * NumberOfControlPointsPerMarkupsNode;
+  report["FrameTimings"] = QJsonObject::fromVariantMap(view.frameTimingStatistics());
+  report["ProcessCPUTimePerFrame"] = processCPUTimePerFrame;
+  report["AllocationsPerFrame"] = allocationsPerFrame;
+  report["EventsPerFrame"] = numberOfEvents / numberOfFrames;
+  report["EventsPerFrameByType"] = eventsPerFrame;
+
+  QByteArray json = QJsonDocument(report).toJson();
+  std::cout << json.constData() << std::endl;
+  QFile reportFile(QString::fromStdString(options.OutputDirectory + "/qMRMLVirtualRealityViewBenchmarkTest1.json"));
+  CHECK_BOOL(reportFile.open(QIODevice::WriteOnly | QIODevice::Text), true);
+  reportFile.write(json);
+  reportFile.close();
+
+  viewNode->RemoveObserver(eventCallback);
+  view.frameTimingLog()->RemoveObserver(frameStartedCallback);
+  view.frameTimingLog()->RemoveObserver(frameEndedCallback);
+  viewNode->SetActive(false);
+  viewNode->SetVisibility(false);
+  scene->Clear();
+  appLogic->SetModuleLogic("Markups", nullptr);
+  appLogic->SetModuleLogic("VolumeRendering", nullptr);
+
+  // Thresholds
+  double p99FrameTime = report["FrameTimings"].toObject()["Total"].toObject()["P99"].toDouble();
+  if (options.MaximumP99FrameTime >= 0.0 && p99FrameTime > options.MaximumP99FrameTime)
+  {
+    std::cerr << "P99 frame time " << p99FrameTime << " ms exceeds " << options.MaximumP99FrameTime << " ms" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (options.MaximumAllocationsPerFrame >= 0.0 && allocationsPerFrame > options.MaximumAllocationsPerFrame)
+  {
+    std::cerr << "Allocations per frame " << allocationsPerFrame << " exceeds " << options.MaximumAllocationsPerFrame << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (options.MaximumEventsPerFrame >= 0.0 && numberOfEvents / numberOfFrames > options.MaximumEventsPerFrame)
+  {
+    std::cerr << "Events per frame " << numberOfEvents / numberOfFrames << " exceeds " << options.MaximumEventsPerFrame << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
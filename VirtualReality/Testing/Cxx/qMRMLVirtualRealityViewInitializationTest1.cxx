@@ -0,0 +1,188 @@
+
+// VirtualReality MRML includes
+#include <vtkMRMLVirtualRealityViewNode.h>
+
+// VirtualReality MRMLDM includes
+#include <vtkVirtualRealitySimulatedRenderWindow.h>
+
+// VirtualReality Widgets includes
+#include <qMRMLVirtualRealityView.h>
+
+// Slicer includes
+#include <qSlicerApplication.h>
+
+// MRML includes
+#include <vtkMRMLCoreTestingMacros.h>
+#include <vtkMRMLScene.h>
+
+// Qt includes
+#include <QCoreApplication>
+#include <QElapsedTimer>
+
+// VTK includes
+#include <vtkCallbackCommand.h>
+#include <vtkCommand.h>
+#include <vtkNew.h>
+
+// STD includes
+#include <vector>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+/// Record the successive connection states of the view node
+struct ConnectionStateRecorder
+{
+  vtkMRMLVirtualRealityViewNode* ViewNode{nullptr};
+  std::vector<int> States;
+  /// Time of each initialization attempt, in ms since the recording started
+  std::vector<qint64> AttemptTimes;
+  QElapsedTimer Timer;
+
+  void Clear()
+  {
+    this->States.clear();
+    this->AttemptTimes.clear();
+    this->Timer.start();
+  }
+
+  static void Callback(vtkObject* vtkNotUsed(caller), unsigned long vtkNotUsed(eid), void* clientData, void* vtkNotUsed(callData))
+  {
+    ConnectionStateRecorder* self = static_cast<ConnectionStateRecorder*>(clientData);
+    int state = self->ViewNode->GetConnectionState();
+    if (!self->States.empty() && self->States.back() == state)
+    {
+      return;
+    }
+    self->States.push_back(state);
+    if (state == vtkMRMLVirtualRealityViewNode::ConnectionStateConnecting)
+    {
+      self->AttemptTimes.push_back(self->Timer.elapsed());
+    }
+  }
+};
+
+//----------------------------------------------------------------------------
+/// Process events until the view node gets the connection state or the timeout expires
+bool WaitForConnectionState(vtkMRMLVirtualRealityViewNode* viewNode, int state, double timeoutSec)
+{
+  QElapsedTimer timer;
+  timer.start();
+  while (viewNode->GetConnectionState() != state)
+  {
+    if (timer.elapsed() > timeoutSec * 1000.0)
+    {
+      std::cerr << "Connection state " << vtkMRMLVirtualRealityViewNode::GetConnectionStateAsString(state)
+                << " was not reached within " << timeoutSec << " seconds, current state is "
+                << vtkMRMLVirtualRealityViewNode::GetConnectionStateAsString(viewNode->GetConnectionState()) << std::endl;
+      return false;
+    }
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 1);
+  }
+  return true;
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+int qMRMLVirtualRealityViewInitializationTest1(int , char * argv[])
+{
+  int applicationArgc = 1;
+  qSlicerApplication app(applicationArgc, argv);
+
+  vtkMRMLScene* scene = app.mrmlScene();
+  vtkMRMLVirtualRealityViewNode* viewNode =
+    vtkMRMLVirtualRealityViewNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLVirtualRealityViewNode"));
+  viewNode->SetXRBackend(vtkMRMLVirtualRealityViewNode::Simulated);
+
+  ConnectionStateRecorder recorder;
+  recorder.ViewNode = viewNode;
+  vtkNew<vtkCallbackCommand> callback;
+  callback->SetCallback(ConnectionStateRecorder::Callback);
+  callback->SetClientData(&recorder);
+  viewNode->AddObserver(vtkCommand::ModifiedEvent, callback);
+
+  qMRMLVirtualRealityView view;
+  view.setMRMLVirtualRealityViewNode(viewNode);
+  const double timeoutSec = 60.0;
+
+  // Two failed attempts are retried, with a delay doubled after each failure
+  vtkVirtualRealitySimulatedRenderWindow::SetNumberOfFailingInitializations(2);
+  recorder.Clear();
+  viewNode->SetVisibility(true);
+  CHECK_BOOL(WaitForConnectionState(viewNode, vtkMRMLVirtualRealityViewNode::ConnectionStateConnected, timeoutSec), true);
+  CHECK_INT(vtkVirtualRealitySimulatedRenderWindow::GetNumberOfFailingInitializations(), 0);
+  CHECK_INT(viewNode->GetConnectionAttempt(), 3);
+  CHECK_BOOL(viewNode->HasError(), false);
+  CHECK_NOT_NULL(view.renderWindow());
+  CHECK_BOOL(view.renderWindow()->GetVRInitialized(), true);
+  // Session creation blocks, it is reported before it starts
+  const std::vector<int> expectedStates = {
+    vtkMRMLVirtualRealityViewNode::ConnectionStateConnecting,
+    vtkMRMLVirtualRealityViewNode::ConnectionStateCreatingSession,
+    vtkMRMLVirtualRealityViewNode::ConnectionStateRetrying,
+    vtkMRMLVirtualRealityViewNode::ConnectionStateConnecting,
+    vtkMRMLVirtualRealityViewNode::ConnectionStateCreatingSession,
+    vtkMRMLVirtualRealityViewNode::ConnectionStateRetrying,
+    vtkMRMLVirtualRealityViewNode::ConnectionStateConnecting,
+    vtkMRMLVirtualRealityViewNode::ConnectionStateCreatingSession,
+    vtkMRMLVirtualRealityViewNode::ConnectionStateConnected};
+  CHECK_BOOL(recorder.States == expectedStates, true);
+  CHECK_INT(static_cast<int>(recorder.AttemptTimes.size()), 3);
+  CHECK_BOOL(recorder.AttemptTimes[1] - recorder.AttemptTimes[0] >= 500, true);
+  CHECK_BOOL(recorder.AttemptTimes[2] - recorder.AttemptTimes[1] >= 1000, true);
+
+  // Disconnecting clears the connection state
+  viewNode->SetVisibility(false);
+  CHECK_INT(viewNode->GetConnectionState(), vtkMRMLVirtualRealityViewNode::ConnectionStateDisconnected);
+
+  // Initialization is given up after the maximum number of attempts, the error is kept
+  vtkVirtualRealitySimulatedRenderWindow::SetNumberOfFailingInitializations(100);
+  recorder.Clear();
+  viewNode->SetVisibility(true);
+  CHECK_BOOL(WaitForConnectionState(viewNode, vtkMRMLVirtualRealityViewNode::ConnectionStateFailed, timeoutSec), true);
+  CHECK_INT(viewNode->GetConnectionAttempt(), 4);
+  CHECK_INT(vtkVirtualRealitySimulatedRenderWindow::GetNumberOfFailingInitializations(), 96);
+  CHECK_BOOL(viewNode->HasError(), true);
+  CHECK_INT(static_cast<int>(recorder.AttemptTimes.size()), 4);
+  CHECK_BOOL(recorder.AttemptTimes[3] - recorder.AttemptTimes[2] >= 2000, true);
+
+  // No attempt is made after failing
+  QElapsedTimer timer;
+  timer.start();
+  while (timer.elapsed() < 500)
+  {
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 1);
+  }
+  CHECK_INT(vtkVirtualRealitySimulatedRenderWindow::GetNumberOfFailingInitializations(), 96);
+
+  // Disconnecting cancels a scheduled retry
+  viewNode->SetVisibility(false);
+  CHECK_BOOL(viewNode->HasError(), false);
+  recorder.Clear();
+  viewNode->SetVisibility(true);
+  CHECK_BOOL(WaitForConnectionState(viewNode, vtkMRMLVirtualRealityViewNode::ConnectionStateRetrying, timeoutSec), true);
+  viewNode->SetVisibility(false);
+  CHECK_INT(viewNode->GetConnectionState(), vtkMRMLVirtualRealityViewNode::ConnectionStateDisconnected);
+  const int numberOfFailingInitializations = vtkVirtualRealitySimulatedRenderWindow::GetNumberOfFailingInitializations();
+  timer.start();
+  while (timer.elapsed() < 1000)
+  {
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 1);
+  }
+  CHECK_INT(vtkVirtualRealitySimulatedRenderWindow::GetNumberOfFailingInitializations(), numberOfFailingInitializations);
+  CHECK_INT(viewNode->GetConnectionState(), vtkMRMLVirtualRealityViewNode::ConnectionStateDisconnected);
+
+  // Connection succeeds when the runtime gets ready
+  vtkVirtualRealitySimulatedRenderWindow::SetNumberOfFailingInitializations(0);
+  viewNode->SetVisibility(true);
+  CHECK_BOOL(WaitForConnectionState(viewNode, vtkMRMLVirtualRealityViewNode::ConnectionStateConnected, timeoutSec), true);
+  CHECK_INT(viewNode->GetConnectionAttempt(), 1);
+
+  viewNode->SetVisibility(false);
+  viewNode->RemoveObserver(callback);
+  scene->Clear();
+
+  return EXIT_SUCCESS;
+}
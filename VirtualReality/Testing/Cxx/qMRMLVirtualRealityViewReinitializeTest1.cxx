@@ -0,0 +1,155 @@
+
+// VirtualReality MRML includes
+#include <vtkMRMLVirtualRealityViewNode.h>
+
+// VirtualReality MRMLDM includes
+#include <vtkVirtualRealitySimulatedRenderWindow.h>
+
+// VirtualReality Widgets includes
+#include <qMRMLVirtualRealityView.h>
+
+// Slicer includes
+#include <qSlicerApplication.h>
+#include <vtkSlicerApplicationLogic.h>
+
+// Markups includes
+#include <vtkMRMLMarkupsFiducialNode.h>
+#include <vtkSlicerMarkupsLogic.h>
+
+// MRML includes
+#include <vtkMRMLAbstractWidgetRepresentation.h>
+#include <vtkMRMLCoreTestingMacros.h>
+#include <vtkMRMLModelNode.h>
+#include <vtkMRMLScene.h>
+
+// Qt includes
+#include <QCoreApplication>
+#include <QElapsedTimer>
+
+// VTK includes
+#include <vtkAutoInit.h>
+#include <vtkNew.h>
+#include <vtkPropCollection.h>
+#include <vtkRenderer.h>
+#include <vtkRendererCollection.h>
+#include <vtkSmartPointer.h>
+#include <vtkSphereSource.h>
+
+VTK_MODULE_INIT(vtkSlicerMarkupsModuleMRMLDisplayableManager);
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+/// Wait until the view is connected with a render window other than previousRenderWindow
+bool WaitForConnection(qMRMLVirtualRealityView& view, vtkVRRenderWindow* previousRenderWindow, double timeoutSec)
+{
+  vtkMRMLVirtualRealityViewNode* viewNode = view.mrmlVirtualRealityViewNode();
+  QElapsedTimer timer;
+  timer.start();
+  while (viewNode->GetConnectionState() != vtkMRMLVirtualRealityViewNode::ConnectionStateConnected
+         || view.renderWindow() == previousRenderWindow)
+  {
+    if (timer.elapsed() > timeoutSec * 1000.0)
+    {
+      std::cerr << "View was not connected within " << timeoutSec << " seconds" << std::endl;
+      return false;
+    }
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 1);
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+/// Count the widget representations in the renderer, and the ones that are bound to it
+int GetNumberOfWidgetRepresentations(vtkRenderer* renderer, int& numberOfBoundWidgetRepresentations)
+{
+  int numberOfWidgetRepresentations = 0;
+  numberOfBoundWidgetRepresentations = 0;
+  vtkProp* prop = nullptr;
+  vtkCollectionSimpleIterator propIt;
+  vtkPropCollection* viewProps = renderer->GetViewProps();
+  for (viewProps->InitTraversal(propIt); (prop = viewProps->GetNextProp(propIt));)
+  {
+    vtkMRMLAbstractWidgetRepresentation* widgetRepresentation = vtkMRMLAbstractWidgetRepresentation::SafeDownCast(prop);
+    if (widgetRepresentation == nullptr)
+    {
+      continue;
+    }
+    numberOfWidgetRepresentations++;
+    if (widgetRepresentation->GetRenderer() == renderer)
+    {
+      numberOfBoundWidgetRepresentations++;
+    }
+  }
+  return numberOfWidgetRepresentations;
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+int qMRMLVirtualRealityViewReinitializeTest1(int , char * argv[])
+{
+  int applicationArgc = 1;
+  qSlicerApplication app(applicationArgc, argv);
+  vtkSlicerApplicationLogic* appLogic = app.applicationLogic();
+
+  vtkMRMLScene* scene = app.mrmlScene();
+
+  vtkNew<vtkSlicerMarkupsLogic> markupsLogic;
+  markupsLogic->SetMRMLApplicationLogic(appLogic);
+  markupsLogic->SetMRMLScene(scene);
+  appLogic->SetModuleLogic("Markups", markupsLogic);
+
+  vtkMRMLMarkupsFiducialNode* markupsNode =
+    vtkMRMLMarkupsFiducialNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLMarkupsFiducialNode"));
+  markupsNode->CreateDefaultDisplayNodes();
+  markupsNode->AddControlPoint(vtkVector3d(0.0, 0.0, 50.0));
+
+  vtkNew<vtkSphereSource> sphereSource;
+  sphereSource->Update();
+  vtkMRMLModelNode* modelNode = vtkMRMLModelNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLModelNode"));
+  modelNode->SetAndObservePolyData(sphereSource->GetOutput());
+  modelNode->CreateDefaultDisplayNodes();
+
+  vtkMRMLVirtualRealityViewNode* viewNode =
+    vtkMRMLVirtualRealityViewNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLVirtualRealityViewNode"));
+  viewNode->SetXRBackend(vtkMRMLVirtualRealityViewNode::Simulated);
+
+  qMRMLVirtualRealityView view;
+  view.setMRMLVirtualRealityViewNode(viewNode);
+  viewNode->SetVisibility(true);
+
+  const double timeoutSec = 60.0;
+  CHECK_BOOL(WaitForConnection(view, nullptr, timeoutSec), true);
+  vtkSmartPointer<vtkVRRenderWindow> renderWindow = view.renderWindow();
+  CHECK_NOT_NULL(vtkVirtualRealitySimulatedRenderWindow::SafeDownCast(renderWindow));
+  renderWindow->Render();
+
+  vtkRenderer* renderer = renderWindow->GetRenderers()->GetFirstRenderer();
+  int numberOfViewProps = renderer->GetViewProps()->GetNumberOfItems();
+  int numberOfBoundWidgetRepresentations = 0;
+  int numberOfWidgetRepresentations = GetNumberOfWidgetRepresentations(renderer, numberOfBoundWidgetRepresentations);
+  CHECK_BOOL(numberOfWidgetRepresentations > 0, true);
+  CHECK_INT(numberOfBoundWidgetRepresentations, numberOfWidgetRepresentations);
+
+  // Recreate the render window, displayable managers are reused
+  view.reinitializeXRBackend();
+  // previous render window is kept alive so that the new one cannot be allocated at the same address
+  CHECK_BOOL(WaitForConnection(view, renderWindow, timeoutSec), true);
+  renderWindow = view.renderWindow();
+  CHECK_NOT_NULL(vtkVirtualRealitySimulatedRenderWindow::SafeDownCast(renderWindow));
+  renderWindow->Render();
+
+  // Markups are still displayed, their widgets are bound to the new renderer
+  renderer = renderWindow->GetRenderers()->GetFirstRenderer();
+  CHECK_INT(renderer->GetViewProps()->GetNumberOfItems(), numberOfViewProps);
+  CHECK_INT(GetNumberOfWidgetRepresentations(renderer, numberOfBoundWidgetRepresentations), numberOfWidgetRepresentations);
+  CHECK_INT(numberOfBoundWidgetRepresentations, numberOfWidgetRepresentations);
+
+  viewNode->SetVisibility(false);
+  scene->Clear();
+  appLogic->SetModuleLogic("Markups", nullptr);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,95 @@
+
+// VirtualReality MRML includes
+#include <vtkMRMLVirtualRealityViewNode.h>
+
+// VirtualReality MRMLDM includes
+#include <vtkVirtualRealitySimulatedRenderWindow.h>
+
+// VirtualReality Widgets includes
+#include <qMRMLVirtualRealityView.h>
+
+// Slicer includes
+#include <qSlicerApplication.h>
+
+// MRML includes
+#include <vtkMRMLCoreTestingMacros.h>
+#include <vtkMRMLScene.h>
+#include <vtkMRMLViewNode.h>
+
+// Qt includes
+#include <QCoreApplication>
+#include <QElapsedTimer>
+
+// VTK includes
+#include <vtkSmartPointer.h>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+/// Wait until the view is connected with a render window other than previousRenderWindow
+bool WaitForConnection(qMRMLVirtualRealityView& view, vtkVRRenderWindow* previousRenderWindow, double timeoutSec)
+{
+  vtkMRMLVirtualRealityViewNode* viewNode = view.mrmlVirtualRealityViewNode();
+  QElapsedTimer timer;
+  timer.start();
+  while (viewNode->GetConnectionState() != vtkMRMLVirtualRealityViewNode::ConnectionStateConnected
+         || view.renderWindow() == previousRenderWindow)
+  {
+    if (timer.elapsed() > timeoutSec * 1000.0)
+    {
+      std::cerr << "View was not connected within " << timeoutSec << " seconds" << std::endl;
+      return false;
+    }
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 1);
+  }
+  return true;
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+int qMRMLVirtualRealityViewSharedGraphicsResourcesTest1(int , char * argv[])
+{
+  int applicationArgc = 1;
+  qSlicerApplication app(applicationArgc, argv);
+
+  vtkMRMLScene* scene = app.mrmlScene();
+
+  // Reference view has no widget, there is no layout manager in the test application
+  vtkMRMLViewNode* referenceViewNode = vtkMRMLViewNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLViewNode"));
+  vtkMRMLVirtualRealityViewNode* viewNode =
+    vtkMRMLVirtualRealityViewNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLVirtualRealityViewNode"));
+  viewNode->SetXRBackend(vtkMRMLVirtualRealityViewNode::Simulated);
+  viewNode->SetAndObserveReferenceViewNode(referenceViewNode);
+  viewNode->SetSharedGraphicsResources(true);
+
+  qMRMLVirtualRealityView view;
+  view.setMRMLVirtualRealityViewNode(viewNode);
+  CHECK_BOOL(view.graphicsResourcesShared(), false);
+
+  // Render window falls back to its own OpenGL context
+  viewNode->SetVisibility(true);
+  const double timeoutSec = 60.0;
+  CHECK_BOOL(WaitForConnection(view, nullptr, timeoutSec), true);
+  vtkSmartPointer<vtkVRRenderWindow> renderWindow = view.renderWindow();
+  CHECK_NOT_NULL(vtkVirtualRealitySimulatedRenderWindow::SafeDownCast(renderWindow));
+  CHECK_NULL(renderWindow->GetSharedRenderWindow());
+  CHECK_BOOL(view.graphicsResourcesShared(), false);
+  CHECK_STRING(viewNode->GetError().c_str(), "");
+  renderWindow->Render();
+
+  // Same after the render window is created again
+  view.reinitializeXRBackend();
+  CHECK_BOOL(WaitForConnection(view, renderWindow, timeoutSec), true);
+  renderWindow = view.renderWindow();
+  CHECK_NULL(renderWindow->GetSharedRenderWindow());
+  CHECK_BOOL(view.graphicsResourcesShared(), false);
+  renderWindow->Render();
+
+  viewNode->SetVisibility(false);
+  CHECK_BOOL(view.graphicsResourcesShared(), false);
+  scene->Clear();
+
+  return EXIT_SUCCESS;
+}
@@ -4,6 +4,8 @@
 
 // MRML includes
 #include <vtkMRMLCoreTestingMacros.h>
+#include <vtkMRMLLinearTransformNode.h>
+#include <vtkMRMLScene.h>
 
 int vtkMRMLVirtualRealityViewNodeTest1(int , char * [])
 {
@@ -16,6 +18,93 @@ int vtkMRMLVirtualRealityViewNodeTest1(int , char * [])
   CHECK_INT(vtkMRMLVirtualRealityViewNode::GetXRBackendFromString("undefined"), vtkMRMLVirtualRealityViewNode::UndefinedXRBackend);
   CHECK_INT(vtkMRMLVirtualRealityViewNode::GetXRBackendFromString("OpenVR"), vtkMRMLVirtualRealityViewNode::OpenVR);
   CHECK_INT(vtkMRMLVirtualRealityViewNode::GetXRBackendFromString("OpenXR"), vtkMRMLVirtualRealityViewNode::OpenXR);
+  CHECK_INT(vtkMRMLVirtualRealityViewNode::GetXRBackendFromString("Simulated"), vtkMRMLVirtualRealityViewNode::Simulated);
+
+  CHECK_INT(vtkMRMLVirtualRealityViewNode::GetTrackingResultFromString(nullptr), -1);
+  CHECK_INT(vtkMRMLVirtualRealityViewNode::GetTrackingResultFromString("any"), -1);
+  CHECK_INT(vtkMRMLVirtualRealityViewNode::GetTrackingResultFromString("Uninitialized"), vtkMRMLVirtualRealityViewNode::TrackingResultUninitialized);
+  CHECK_INT(vtkMRMLVirtualRealityViewNode::GetTrackingResultFromString("RunningOk"), vtkMRMLVirtualRealityViewNode::TrackingResultRunningOK);
+  CHECK_INT(vtkMRMLVirtualRealityViewNode::GetTrackingResultFromString("CalibratingOutOfRange"), vtkMRMLVirtualRealityViewNode::TrackingResultCalibratingOutOfRange);
+
+  CHECK_INT(vtkMRMLVirtualRealityViewNode::GetConnectionStateFromString(nullptr), -1);
+  CHECK_INT(vtkMRMLVirtualRealityViewNode::GetConnectionStateFromString("any"), -1);
+  CHECK_INT(vtkMRMLVirtualRealityViewNode::GetConnectionStateFromString("Disconnected"), vtkMRMLVirtualRealityViewNode::ConnectionStateDisconnected);
+  CHECK_INT(vtkMRMLVirtualRealityViewNode::GetConnectionStateFromString("Retrying"), vtkMRMLVirtualRealityViewNode::ConnectionStateRetrying);
+  CHECK_INT(vtkMRMLVirtualRealityViewNode::GetConnectionStateFromString("Failed"), vtkMRMLVirtualRealityViewNode::ConnectionStateFailed);
+  CHECK_INT(node1->GetConnectionState(), vtkMRMLVirtualRealityViewNode::ConnectionStateDisconnected);
+  CHECK_INT(vtkMRMLVirtualRealityViewNode::GetConnectionStateFromString("Standby"), vtkMRMLVirtualRealityViewNode::ConnectionStateStandby);
+  CHECK_INT(vtkMRMLVirtualRealityViewNode::GetConnectionStateFromString("CreatingSession"), vtkMRMLVirtualRealityViewNode::ConnectionStateCreatingSession);
+  CHECK_BOOL(node1->GetAdaptiveQuality(), true);
+  CHECK_DOUBLE(node1->GetAdaptiveQualityMinimum(), 0.0);
+  CHECK_DOUBLE(node1->GetAdaptiveQualityMaximum(), 1.0);
+  CHECK_BOOL(node1->GetWarmStandby(), false);
+  CHECK_BOOL(node1->GetSharedGraphicsResources(), false);
+  CHECK_BOOL(node1->GetKeepAliveSubmission(), false);
+
+  // Device status
+  vtkNew<vtkMRMLVirtualRealityViewNode> node2;
+  CHECK_BOOL(node2->HasDeviceStatus(vtkEventDataDevice::HeadMountedDisplay), false);
+  CHECK_INT(node2->GetDeviceTrackingResult(vtkEventDataDevice::HeadMountedDisplay), vtkMRMLVirtualRealityViewNode::TrackingResultUninitialized);
+  CHECK_BOOL(node2->SetDeviceStatus(vtkEventDataDevice::HeadMountedDisplay, 0,
+    vtkMRMLVirtualRealityViewNode::TrackingResultRunningOK, true, true, 1.0), true);
+  CHECK_BOOL(node2->HasDeviceStatus(vtkEventDataDevice::HeadMountedDisplay), true);
+  CHECK_INT(node2->GetDeviceTrackingResult(vtkEventDataDevice::HeadMountedDisplay), vtkMRMLVirtualRealityViewNode::TrackingResultRunningOK);
+  CHECK_BOOL(node2->GetDeviceConnected(vtkEventDataDevice::HeadMountedDisplay), true);
+  CHECK_BOOL(node2->GetDevicePoseValid(vtkEventDataDevice::HeadMountedDisplay), true);
+  // Same status reported again: no change, only the update time is recorded
+  CHECK_BOOL(node2->SetDeviceStatus(vtkEventDataDevice::HeadMountedDisplay, 0,
+    vtkMRMLVirtualRealityViewNode::TrackingResultRunningOK, true, true, 2.0), false);
+  CHECK_DOUBLE(node2->GetDeviceLastUpdateTime(vtkEventDataDevice::HeadMountedDisplay), 2.0);
+  CHECK_BOOL(node2->SetDeviceStatus(vtkEventDataDevice::HeadMountedDisplay, 0,
+    vtkMRMLVirtualRealityViewNode::TrackingResultRunningOutOfRange, true, false, 3.0), true);
+  // Trackers are identified by their device handle
+  CHECK_BOOL(node2->SetDeviceStatus(vtkEventDataDevice::GenericTracker, 5,
+    vtkMRMLVirtualRealityViewNode::TrackingResultRunningOK, true, true, 3.0), true);
+  CHECK_BOOL(node2->HasDeviceStatus(vtkEventDataDevice::GenericTracker, 5), true);
+  CHECK_BOOL(node2->HasDeviceStatus(vtkEventDataDevice::GenericTracker, 6), false);
+  // Disabling tracker transform update resets their status
+  node2->SetTrackerTransformUpdate(true);
+  node2->SetTrackerTransformUpdate(false);
+  CHECK_BOOL(node2->HasDeviceStatus(vtkEventDataDevice::GenericTracker, 5), false);
+  CHECK_BOOL(node2->HasDeviceStatus(vtkEventDataDevice::HeadMountedDisplay), true);
+  node2->RemoveAllDeviceStatuses();
+  CHECK_BOOL(node2->HasDeviceStatus(vtkEventDataDevice::HeadMountedDisplay), false);
+
+  // Tracker transform nodes
+  vtkNew<vtkMRMLScene> scene;
+  vtkNew<vtkMRMLVirtualRealityViewNode> node3;
+  scene->AddNode(node3);
+  CHECK_NULL(node3->GetTrackerTransformNode(3));
+  vtkMRMLLinearTransformNode* tracker3 = node3->CreateDefaultTrackerTransformNode(3);
+  CHECK_NOT_NULL(tracker3);
+  vtkMRMLLinearTransformNode* tracker12 = node3->CreateDefaultTrackerTransformNode(12);
+  CHECK_NOT_NULL(tracker12);
+  CHECK_POINTER(node3->CreateDefaultTrackerTransformNode(3), tracker3);
+  CHECK_POINTER(node3->GetTrackerTransformNode(12), tracker12);
+  CHECK_STRING(node3->GetTrackerTransformNodeID(12), tracker12->GetID());
+  CHECK_INT(static_cast<int>(node3->GetTrackerTransformNodes().size()), 2);
+  CHECK_POINTER(node3->GetTrackerTransformNodes()[0], tracker3);
+  CHECK_INT(static_cast<int>(node3->GetTrackerTransformNodeDeviceHandle(tracker12)), 12);
+  CHECK_NULL(node3->GetTrackerTransformNode(UINT32_MAX));
+
+  // Index is kept consistent with node references set using the generic API
+  node3->SetAndObserveNodeReferenceID("7.GenericTracker", tracker12->GetID());
+  CHECK_POINTER(node3->GetTrackerTransformNode(7), tracker12);
+  node3->RemoveNodeReferenceIDs("7.GenericTracker");
+  CHECK_NULL(node3->GetTrackerTransformNode(7));
+
+  // Index is rebuilt when references are copied
+  vtkNew<vtkMRMLVirtualRealityViewNode> node4;
+  scene->AddNode(node4);
+  node4->Copy(node3);
+  CHECK_POINTER(node4->GetTrackerTransformNode(3), tracker3);
+
+  node3->RemoveTrackerTransformNode(3);
+  CHECK_NULL(node3->GetTrackerTransformNode(3));
+  CHECK_INT(static_cast<int>(node3->GetTrackerTransformNodes().size()), 1);
+  node3->RemoveAllTrackerTransformNodes();
+  CHECK_INT(static_cast<int>(node3->GetTrackerTransformNodes().size()), 0);
+  CHECK_NULL(node3->GetNodeReferenceID("12.GenericTracker"));
 
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,230 @@
+
+// VirtualReality Logic includes
+#include <vtkSlicerVirtualRealityLogic.h>
+#include <vtkVirtualRealityMath.h>
+
+// MRML includes
+#include <vtkMRMLCoreTestingMacros.h>
+
+// VTK includes
+#include <vtkMath.h>
+#include <vtkMatrix4x4.h>
+#include <vtkMinimalStandardRandomSequence.h>
+#include <vtkNew.h>
+#include <vtkSmartPointer.h>
+#include <vtkTransform.h>
+
+// STD includes
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+// Number of randomized inputs, operations cycle through them
+const int NumberOfInputs = 1024;
+const int NumberOfOperations = 100000;
+// Median of the repetitions is reported, for stable numbers across runs
+const int NumberOfRepetitions = 9;
+
+// Prevents the compiler from optimizing away the measured operations
+volatile double Sink = 0.0;
+
+//----------------------------------------------------------------------------
+struct ViewState
+{
+  double Position[3];
+  double Direction[3];
+  double ViewUp[3];
+};
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkMatrix4x4> RandomPose(vtkMinimalStandardRandomSequence* random, double maximumTranslation)
+{
+  vtkNew<vtkTransform> transform;
+  double values[7];
+  for (int i = 0; i < 7; ++i)
+  {
+    random->Next();
+    values[i] = random->GetRangeValue(-1.0, 1.0);
+  }
+  transform->Translate(values[0] * maximumTranslation, values[1] * maximumTranslation, values[2] * maximumTranslation);
+  transform->RotateWXYZ(values[3] * 180.0, values[4], values[5], values[6] + 2.0);
+  vtkSmartPointer<vtkMatrix4x4> pose = vtkSmartPointer<vtkMatrix4x4>::New();
+  pose->DeepCopy(transform->GetMatrix());
+  return pose;
+}
+
+//----------------------------------------------------------------------------
+void RandomViewState(vtkMinimalStandardRandomSequence* random, ViewState& state)
+{
+  vtkSmartPointer<vtkMatrix4x4> pose = RandomPose(random, 1000.0);
+  for (int i = 0; i < 3; ++i)
+  {
+    state.Position[i] = pose->GetElement(i, 3);
+    state.Direction[i] = -pose->GetElement(i, 2);
+    state.ViewUp[i] = pose->GetElement(i, 1);
+  }
+}
+
+//----------------------------------------------------------------------------
+template <typename Operation>
+double MeasureNanosecondsPerOperation(Operation operation)
+{
+  std::vector<double> durations;
+  for (int repetition = 0; repetition < NumberOfRepetitions; ++repetition)
+  {
+    auto start = std::chrono::steady_clock::now();
+    for (int operationIndex = 0; operationIndex < NumberOfOperations; ++operationIndex)
+    {
+      operation(operationIndex % NumberOfInputs);
+    }
+    auto stop = std::chrono::steady_clock::now();
+    durations.push_back(std::chrono::duration<double, std::nano>(stop - start).count() / NumberOfOperations);
+  }
+  std::nth_element(durations.begin(), durations.begin() + NumberOfRepetitions / 2, durations.end());
+  return durations[NumberOfRepetitions / 2];
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+int vtkSlicerVirtualRealityLogicBenchmarkTest1(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << argv[0] << " <output-directory>" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Randomized inputs, using a fixed seed so that all runs measure the same inputs
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(8775070);
+  std::vector<ViewState> lastViewStates(NumberOfInputs);
+  std::vector<ViewState> viewStates(NumberOfInputs);
+  std::vector<vtkSmartPointer<vtkMatrix4x4>> controller0Poses;
+  std::vector<vtkSmartPointer<vtkMatrix4x4>> controller1Poses;
+  std::vector<vtkSmartPointer<vtkMatrix4x4>> physicalToWorldMatrices;
+  std::vector<double> motionSensitivities;
+  for (int inputIndex = 0; inputIndex < NumberOfInputs; ++inputIndex)
+  {
+    RandomViewState(random, lastViewStates[inputIndex]);
+    RandomViewState(random, viewStates[inputIndex]);
+    controller0Poses.push_back(RandomPose(random, 1.0));
+    controller1Poses.push_back(RandomPose(random, 1.0));
+    vtkSmartPointer<vtkMatrix4x4> physicalToWorldMatrix = RandomPose(random, 500.0);
+    for (int row = 0; row < 3; ++row)
+    {
+      for (int column = 0; column < 3; ++column)
+      {
+        physicalToWorldMatrix->SetElement(row, column, 100.0 * physicalToWorldMatrix->GetElement(row, column));
+      }
+    }
+    physicalToWorldMatrices.push_back(physicalToWorldMatrix);
+    random->Next();
+    motionSensitivities.push_back(random->GetRangeValue(0.01, 0.99));
+  }
+
+  // Check kernels used by the interactor style delegate
+  vtkNew<vtkMatrix4x4> combinedPose;
+  vtkNew<vtkMatrix4x4> resultMatrix;
+  CHECK_BOOL(vtkSlicerVirtualRealityLogic::CalculateCombinedControllerPose(
+    controller0Poses[0], controller1Poses[0], combinedPose), true);
+  // Controllers did not move since the start of the gesture: world does not move
+  vtkSlicerVirtualRealityLogic::ComputePinch3DPhysicalToWorldMatrix(
+    physicalToWorldMatrices[0], combinedPose, combinedPose, resultMatrix);
+  CHECK_BOOL(vtkSlicerVirtualRealityLogic::AreMatricesEqual(resultMatrix, physicalToWorldMatrices[0], 1e-6), true);
+  // Scaling keeps the focus point in place
+  double focusPoint_World[3] = { 10.0, -20.0, 30.0 };
+  vtkSlicerVirtualRealityLogic::ComputeScaledPhysicalToWorldMatrix(
+    physicalToWorldMatrices[0], focusPoint_World, 1.0, resultMatrix);
+  CHECK_BOOL(vtkSlicerVirtualRealityLogic::AreMatricesEqual(resultMatrix, physicalToWorldMatrices[0], 1e-9), true);
+  vtkNew<vtkMatrix4x4> worldToPhysicalMatrix;
+  vtkMatrix4x4::Invert(physicalToWorldMatrices[0], worldToPhysicalMatrix);
+  double focusPoint_Physical[4] = { focusPoint_World[0], focusPoint_World[1], focusPoint_World[2], 1.0 };
+  worldToPhysicalMatrix->MultiplyPoint(focusPoint_Physical, focusPoint_Physical);
+  vtkSlicerVirtualRealityLogic::ComputeScaledPhysicalToWorldMatrix(
+    physicalToWorldMatrices[0], focusPoint_World, 2.0, resultMatrix);
+  double scaledFocusPoint_World[4] = { 0.0, 0.0, 0.0, 1.0 };
+  resultMatrix->MultiplyPoint(focusPoint_Physical, scaledFocusPoint_World);
+  CHECK_DOUBLE_TOLERANCE(sqrt(vtkMath::Distance2BetweenPoints(scaledFocusPoint_World, focusPoint_World)), 0.0, 1e-6);
+
+  // Measure
+  double shouldConsiderQuickViewMotionTime = MeasureNanosecondsPerOperation([&](int inputIndex)
+  {
+    ViewState& lastState = lastViewStates[inputIndex];
+    ViewState& state = viewStates[inputIndex];
+    Sink = Sink + vtkSlicerVirtualRealityLogic::ShouldConsiderQuickViewMotion(
+      motionSensitivities[inputIndex], 100.0, 0.011,
+      lastState.Position, lastState.Direction, lastState.ViewUp,
+      state.Position, state.Direction, state.ViewUp);
+  });
+
+  double calculateCombinedControllerPoseTime = MeasureNanosecondsPerOperation([&](int inputIndex)
+  {
+    vtkSlicerVirtualRealityLogic::CalculateCombinedControllerPose(
+      controller0Poses[inputIndex], controller1Poses[inputIndex], combinedPose);
+    Sink = Sink + combinedPose->GetElement(0, 3);
+  });
+
+  double computeDeviceToWorldMatrixTime = MeasureNanosecondsPerOperation([&](int inputIndex)
+  {
+    vtkSlicerVirtualRealityLogic::ComputeDeviceToWorldMatrix(
+      controller0Poses[inputIndex], physicalToWorldMatrices[inputIndex], resultMatrix);
+    Sink = Sink + resultMatrix->GetElement(0, 3);
+  });
+
+  // Same chain as vtkVirtualRealityViewInteractorStyleDelegate::OnPinch3D()
+  vtkNew<vtkMatrix4x4> combinedStartingPose;
+  vtkSlicerVirtualRealityLogic::CalculateCombinedControllerPose(controller0Poses[0], controller1Poses[0], combinedStartingPose);
+  double pinch3DTime = MeasureNanosecondsPerOperation([&](int inputIndex)
+  {
+    if (vtkSlicerVirtualRealityLogic::CalculateCombinedControllerPose(
+      controller0Poses[inputIndex], controller1Poses[inputIndex], combinedPose))
+    {
+      vtkSlicerVirtualRealityLogic::ComputePinch3DPhysicalToWorldMatrix(
+        physicalToWorldMatrices[inputIndex], combinedStartingPose, combinedPose, resultMatrix);
+    }
+    Sink = Sink + resultMatrix->GetElement(0, 3);
+  });
+
+  // Same chain as vtkVirtualRealityViewInteractorStyleDelegate::SetMagnification()
+  double setMagnificationTime = MeasureNanosecondsPerOperation([&](int inputIndex)
+  {
+    vtkSlicerVirtualRealityLogic::ComputeScaledPhysicalToWorldMatrix(
+      physicalToWorldMatrices[inputIndex], viewStates[inputIndex].Position, motionSensitivities[inputIndex] + 0.5, resultMatrix);
+    Sink = Sink + resultMatrix->GetElement(0, 3);
+  });
+
+  // Same kernel as vtkVirtualRealityViewInteractorStyleDelegate::PositionProp()
+  double grabTime = MeasureNanosecondsPerOperation([&](int inputIndex)
+  {
+    int lastInputIndex = (inputIndex + NumberOfInputs - 1) % NumberOfInputs;
+    double orientation[4] = { 90.0 * motionSensitivities[inputIndex], 0.0, 1.0, 0.0 };
+    double lastOrientation[4] = { 90.0 * motionSensitivities[lastInputIndex], 0.0, 1.0, 0.0 };
+    vtkVirtualRealityMath::Matrix4 interactionTransform = vtkVirtualRealityMath::GrabInteractionTransform(
+      viewStates[inputIndex].Position, viewStates[lastInputIndex].Position, orientation, lastOrientation);
+    Sink = Sink + interactionTransform(0, 3);
+  });
+
+  // Report
+  std::string report = std::string("{\n")
+    + "  \"ShouldConsiderQuickViewMotion\": " + std::to_string(shouldConsiderQuickViewMotionTime) + ",\n"
+    + "  \"CalculateCombinedControllerPose\": " + std::to_string(calculateCombinedControllerPoseTime) + ",\n"
+    + "  \"ComputeDeviceToWorldMatrix\": " + std::to_string(computeDeviceToWorldMatrixTime) + ",\n"
+    + "  \"Pinch3D\": " + std::to_string(pinch3DTime) + ",\n"
+    + "  \"SetMagnification\": " + std::to_string(setMagnificationTime) + ",\n"
+    + "  \"GrabInteractionTransform\": " + std::to_string(grabTime) + "\n"
+    + "}\n";
+  std::cout << "Nanoseconds per operation:\n" << report << std::endl;
+  std::ofstream reportFile(std::string(argv[1]) + "/vtkSlicerVirtualRealityLogicBenchmarkTest1.json");
+  CHECK_BOOL(reportFile.is_open(), true);
+  reportFile << report;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,116 @@
+// VirtualReality Logic includes
+#include <vtkVirtualRealityAdaptiveQualityController.h>
+
+// MRML includes
+#include <vtkMRMLCoreTestingMacros.h>
+
+// VTK includes
+#include <vtkNew.h>
+
+int vtkVirtualRealityAdaptiveQualityControllerTest1(int , char * [])
+{
+  vtkNew<vtkVirtualRealityAdaptiveQualityController> controller;
+  controller->SetTargetFrameTime(0.010);
+  controller->Reset(0.0);
+  CHECK_DOUBLE(controller->GetQuality(), 0.0);
+
+  // No measurement
+  CHECK_BOOL(controller->Update(0.0), false);
+
+  // Headroom: quality ramps up by at most one step per frame
+  CHECK_BOOL(controller->Update(0.002), true);
+  CHECK_DOUBLE_TOLERANCE(controller->GetQuality(), controller->GetQualityIncreaseStep(), 1e-9);
+  for (int frame = 0; frame < 200; ++frame)
+  {
+    controller->Update(0.002);
+  }
+  CHECK_DOUBLE(controller->GetQuality(), 1.0);
+
+  // Increase may be prevented, for example while the view is moving
+  controller->Reset(0.5);
+  CHECK_BOOL(controller->Update(0.002, false), false);
+  CHECK_DOUBLE(controller->GetQuality(), 0.5);
+
+  // Within the hysteresis band: quality is kept
+  controller->Reset(0.5);
+  CHECK_BOOL(controller->Update(0.008), false);
+  CHECK_DOUBLE(controller->GetQuality(), 0.5);
+
+  // Over budget: quality decreases after the smoothed frame time crosses the upper threshold
+  controller->Reset(0.5);
+  controller->Update(0.008);
+  CHECK_BOOL(controller->Update(0.020), true);
+  CHECK_DOUBLE_TOLERANCE(controller->GetQuality(), 0.5 - controller->GetQualityDecreaseStep(), 1e-9);
+  for (int frame = 0; frame < 200; ++frame)
+  {
+    controller->Update(0.020);
+  }
+  CHECK_DOUBLE(controller->GetQuality(), 0.0);
+
+  // Quality range
+  controller->SetMinimumQuality(0.2);
+  controller->SetMaximumQuality(0.6);
+  controller->Update(0.020);
+  CHECK_DOUBLE(controller->GetQuality(), 0.2);
+  controller->Reset(1.0);
+  CHECK_DOUBLE(controller->GetQuality(), 0.6);
+
+  // Logarithmic interpolation
+  CHECK_DOUBLE_TOLERANCE(vtkVirtualRealityAdaptiveQualityController::InterpolateLogarithmic(0.0, 100.0, 0.01), 100.0, 1e-9);
+  CHECK_DOUBLE_TOLERANCE(vtkVirtualRealityAdaptiveQualityController::InterpolateLogarithmic(0.5, 100.0, 0.01), 1.0, 1e-9);
+  CHECK_DOUBLE_TOLERANCE(vtkVirtualRealityAdaptiveQualityController::InterpolateLogarithmic(1.0, 100.0, 0.01), 0.01, 1e-9);
+
+  // Cascade: only one of the controllers changes at each frame
+  vtkNew<vtkVirtualRealityAdaptiveQualityController> qualityController;
+  qualityController->SetTargetFrameTime(0.010);
+  qualityController->SetMinimumQuality(0.2);
+  qualityController->Reset(1.0);
+  vtkNew<vtkVirtualRealityAdaptiveQualityController> scaleController;
+  scaleController->SetTargetFrameTime(0.010);
+  scaleController->Reset(1.0);
+
+  // Over budget: quality is lowered first, resolution only once quality is at its minimum
+  for (int frame = 0; frame < 16; ++frame)
+  {
+    CHECK_BOOL(vtkVirtualRealityAdaptiveQualityController::UpdateCascade(qualityController, scaleController, 0.020), true);
+    CHECK_DOUBLE(scaleController->GetQuality(), 1.0);
+  }
+  CHECK_DOUBLE_TOLERANCE(qualityController->GetQuality(), 0.2, 1e-9);
+  CHECK_BOOL(vtkVirtualRealityAdaptiveQualityController::UpdateCascade(qualityController, scaleController, 0.020), true);
+  CHECK_DOUBLE_TOLERANCE(qualityController->GetQuality(), 0.2, 1e-9);
+  CHECK_DOUBLE_TOLERANCE(scaleController->GetQuality(), 1.0 - scaleController->GetQualityDecreaseStep(), 1e-9);
+  for (int frame = 0; frame < 200; ++frame)
+  {
+    vtkVirtualRealityAdaptiveQualityController::UpdateCascade(qualityController, scaleController, 0.020);
+  }
+  CHECK_DOUBLE_TOLERANCE(qualityController->GetQuality(), 0.2, 1e-9);
+  CHECK_DOUBLE(scaleController->GetQuality(), 0.0);
+
+  // Within the hysteresis band: nothing changes
+  qualityController->Reset(0.5);
+  scaleController->Reset(0.5);
+  CHECK_BOOL(vtkVirtualRealityAdaptiveQualityController::UpdateCascade(qualityController, scaleController, 0.008), false);
+  CHECK_DOUBLE(qualityController->GetQuality(), 0.5);
+  CHECK_DOUBLE(scaleController->GetQuality(), 0.5);
+
+  // Headroom: resolution is raised first, quality only once resolution is at its maximum
+  qualityController->Reset(0.2);
+  scaleController->Reset(0.0);
+  for (int frame = 0; frame < 100; ++frame)
+  {
+    CHECK_BOOL(vtkVirtualRealityAdaptiveQualityController::UpdateCascade(qualityController, scaleController, 0.002), true);
+    CHECK_DOUBLE_TOLERANCE(qualityController->GetQuality(), 0.2, 1e-9);
+  }
+  CHECK_DOUBLE_TOLERANCE(scaleController->GetQuality(), 1.0, 1e-9);
+  // Quality increase may be prevented, for example while the view is moving
+  CHECK_BOOL(vtkVirtualRealityAdaptiveQualityController::UpdateCascade(qualityController, scaleController, 0.002, false), false);
+  CHECK_BOOL(vtkVirtualRealityAdaptiveQualityController::UpdateCascade(qualityController, scaleController, 0.002), true);
+  CHECK_DOUBLE_TOLERANCE(qualityController->GetQuality(), 0.2 + qualityController->GetQualityIncreaseStep(), 1e-9);
+  CHECK_DOUBLE_TOLERANCE(scaleController->GetQuality(), 1.0, 1e-9);
+
+  TESTING_OUTPUT_ASSERT_WARNINGS_BEGIN();
+  CHECK_BOOL(vtkVirtualRealityAdaptiveQualityController::UpdateCascade(qualityController, nullptr, 0.002), false);
+  TESTING_OUTPUT_ASSERT_WARNINGS_END();
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,149 @@
+
+// VirtualReality Logic includes
+#include <vtkVirtualRealityBoundingVolumeHierarchy.h>
+
+// MRML includes
+#include <vtkMRMLCoreTestingMacros.h>
+
+// VTK includes
+#include <vtkMinimalStandardRandomSequence.h>
+#include <vtkNew.h>
+
+// STD includes
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+void RandomBounds(vtkMinimalStandardRandomSequence* random, double bounds[6])
+{
+  for (int axis = 0; axis < 3; ++axis)
+  {
+    random->Next();
+    double center = random->GetRangeValue(-500.0, 500.0);
+    random->Next();
+    double halfSize = random->GetRangeValue(0.5, 20.0);
+    bounds[2 * axis] = center - halfSize;
+    bounds[2 * axis + 1] = center + halfSize;
+  }
+}
+
+//----------------------------------------------------------------------------
+bool CheckQueries(vtkVirtualRealityBoundingVolumeHierarchy* hierarchy, vtkMinimalStandardRandomSequence* random)
+{
+  std::vector<int> foundItems;
+  for (int queryIndex = 0; queryIndex < 200; ++queryIndex)
+  {
+    double point[3] = { 0.0, 0.0, 0.0 };
+    if (queryIndex % 2 == 0)
+    {
+      // Query inside an item, so that most queries find items
+      double bounds[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+      hierarchy->GetItemBounds(queryIndex % hierarchy->GetNumberOfItems(), bounds);
+      point[0] = bounds[0];
+      point[1] = 0.5 * (bounds[2] + bounds[3]);
+      point[2] = bounds[5];
+    }
+    else
+    {
+      for (int axis = 0; axis < 3; ++axis)
+      {
+        random->Next();
+        point[axis] = random->GetRangeValue(-520.0, 520.0);
+      }
+    }
+    const double tolerance = 1.0;
+    hierarchy->FindItemsAtPoint(point, tolerance, foundItems);
+    std::sort(foundItems.begin(), foundItems.end());
+
+    std::vector<int> expectedItems;
+    for (int itemIndex = 0; itemIndex < hierarchy->GetNumberOfItems(); ++itemIndex)
+    {
+      double bounds[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+      hierarchy->GetItemBounds(itemIndex, bounds);
+      if (point[0] >= bounds[0] - tolerance && point[0] <= bounds[1] + tolerance
+        && point[1] >= bounds[2] - tolerance && point[1] <= bounds[3] + tolerance
+        && point[2] >= bounds[4] - tolerance && point[2] <= bounds[5] + tolerance)
+      {
+        expectedItems.push_back(itemIndex);
+      }
+    }
+    if (foundItems != expectedItems)
+    {
+      std::cerr << "Query " << queryIndex << ": found " << foundItems.size()
+                << " items, expected " << expectedItems.size() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+int vtkVirtualRealityBoundingVolumeHierarchyTest1(int , char * [])
+{
+  vtkNew<vtkVirtualRealityBoundingVolumeHierarchy> hierarchy;
+
+  // Empty hierarchy
+  std::vector<int> foundItems;
+  double origin[3] = { 0.0, 0.0, 0.0 };
+  hierarchy->FindItemsAtPoint(origin, 0.0, foundItems);
+  CHECK_BOOL(foundItems.empty(), true);
+  CHECK_INT(hierarchy->GetNumberOfHierarchyNodes(), 0);
+
+  // Single item
+  double unitBounds[6] = { -1.0, 1.0, -1.0, 1.0, -1.0, 1.0 };
+  CHECK_INT(hierarchy->AddItem(unitBounds), 0);
+  hierarchy->FindItemsAtPoint(origin, 0.0, foundItems);
+  CHECK_INT(static_cast<int>(foundItems.size()), 1);
+  double outsidePoint[3] = { 1.5, 0.0, 0.0 };
+  hierarchy->FindItemsAtPoint(outsidePoint, 0.0, foundItems);
+  CHECK_BOOL(foundItems.empty(), true);
+  hierarchy->FindItemsAtPoint(outsidePoint, 0.5, foundItems);
+  CHECK_INT(static_cast<int>(foundItems.size()), 1);
+
+  // Random items, compared to testing all items
+  hierarchy->Initialize();
+  CHECK_INT(hierarchy->GetNumberOfItems(), 0);
+  vtkNew<vtkMinimalStandardRandomSequence> random;
+  random->SetSeed(2209);
+  const int numberOfItems = 1000;
+  for (int itemIndex = 0; itemIndex < numberOfItems; ++itemIndex)
+  {
+    double bounds[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    RandomBounds(random, bounds);
+    CHECK_INT(hierarchy->AddItem(bounds), itemIndex);
+  }
+  hierarchy->Build();
+  CHECK_INT(hierarchy->GetNumberOfItems(), numberOfItems);
+  // A binary tree with at most 4 items per leaf
+  CHECK_BOOL(hierarchy->GetNumberOfHierarchyNodes() >= numberOfItems / 4, true);
+  CHECK_BOOL(hierarchy->GetNumberOfHierarchyNodes() < 2 * numberOfItems, true);
+  CHECK_BOOL(CheckQueries(hierarchy, random), true);
+
+  // Refit after moving items
+  for (int itemIndex = 0; itemIndex < numberOfItems; itemIndex += 3)
+  {
+    double bounds[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    RandomBounds(random, bounds);
+    hierarchy->SetItemBounds(itemIndex, bounds);
+  }
+  int numberOfHierarchyNodes = hierarchy->GetNumberOfHierarchyNodes();
+  CHECK_BOOL(CheckQueries(hierarchy, random), true);
+  // Topology is kept
+  CHECK_INT(hierarchy->GetNumberOfHierarchyNodes(), numberOfHierarchyNodes);
+
+  // Adding an item rebuilds the hierarchy at the next query
+  double farBounds[6] = { 1000.0, 1001.0, 1000.0, 1001.0, 1000.0, 1001.0 };
+  int farItemIndex = hierarchy->AddItem(farBounds);
+  CHECK_INT(hierarchy->GetNumberOfHierarchyNodes(), 0);
+  double farPoint[3] = { 1000.5, 1000.5, 1000.5 };
+  hierarchy->FindItemsAtPoint(farPoint, 0.0, foundItems);
+  CHECK_INT(static_cast<int>(foundItems.size()), 1);
+  CHECK_INT(foundItems[0], farItemIndex);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,166 @@
+
+// VirtualReality Logic includes
+#include <vtkVirtualRealityFrameTimingLog.h>
+
+// MRML includes
+#include <vtkMRMLCoreTestingMacros.h>
+
+// VTK includes
+#include <vtkCallbackCommand.h>
+#include <vtkCommand.h>
+#include <vtkNew.h>
+#include <vtkObjectFactory.h>
+
+// STD includes
+#include <chrono>
+#include <thread>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+/// Give access to the durations of the frame being recorded, for recording known durations
+class vtkTestFrameTimingLog : public vtkVirtualRealityFrameTimingLog
+{
+public:
+  static vtkTestFrameTimingLog* New();
+  vtkTypeMacro(vtkTestFrameTimingLog, vtkVirtualRealityFrameTimingLog);
+
+  /// Record a frame with the given duration (in seconds) of a phase
+  void RecordFrame(int phase, double duration, bool dropped)
+  {
+    this->StartFrame();
+    this->CurrentFrame.PhaseDurations[phase] = duration;
+    this->EndFrame(dropped);
+  }
+};
+vtkStandardNewMacro(vtkTestFrameTimingLog);
+
+//----------------------------------------------------------------------------
+void CountEvents(vtkObject* vtkNotUsed(caller), unsigned long event, void* clientData, void* vtkNotUsed(callData))
+{
+  int* counts = static_cast<int*>(clientData);
+  if (event == vtkCommand::StartEvent)
+  {
+    counts[0]++;
+  }
+  else if (event == vtkCommand::EndEvent)
+  {
+    counts[1]++;
+  }
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+int vtkVirtualRealityFrameTimingLogTest1(int , char * [])
+{
+  const int motionCheck = vtkVirtualRealityFrameTimingLog::MotionCheckPhase;
+  const int render = vtkVirtualRealityFrameTimingLog::RenderPhase;
+  const int total = vtkVirtualRealityFrameTimingLog::TotalPhase;
+
+  // Phase names
+  CHECK_STRING(vtkVirtualRealityFrameTimingLog::GetPhaseAsString(render), "Render");
+  CHECK_INT(vtkVirtualRealityFrameTimingLog::GetPhaseFromString("Render"), render);
+  CHECK_INT(vtkVirtualRealityFrameTimingLog::GetPhaseFromString("Total"), total);
+  CHECK_INT(vtkVirtualRealityFrameTimingLog::GetPhaseFromString("Unknown"), -1);
+  CHECK_INT(vtkVirtualRealityFrameTimingLog::GetPhaseFromString(nullptr), -1);
+
+  vtkNew<vtkTestFrameTimingLog> timingLog;
+  CHECK_INT(timingLog->GetCapacity(), 1024);
+  TESTING_OUTPUT_ASSERT_ERRORS_BEGIN();
+  timingLog->SetCapacity(0);
+  TESTING_OUTPUT_ASSERT_ERRORS_END();
+  CHECK_INT(timingLog->GetCapacity(), 1024);
+
+  // Statistics of an empty log
+  timingLog->SetCapacity(8);
+  CHECK_INT(timingLog->GetNumberOfFrames(), 0);
+  CHECK_DOUBLE(timingLog->GetPhaseDurationPercentile(total, 50.0), 0.0);
+  CHECK_DOUBLE(timingLog->GetPhaseDurationMean(total), 0.0);
+  CHECK_DOUBLE(timingLog->GetPhaseDurationMaximum(total), 0.0);
+
+  // Frames are started and recorded with events
+  int eventCounts[2] = { 0, 0 };
+  vtkNew<vtkCallbackCommand> callback;
+  callback->SetCallback(CountEvents);
+  callback->SetClientData(eventCounts);
+  timingLog->AddObserver(vtkCommand::StartEvent, callback);
+  timingLog->AddObserver(vtkCommand::EndEvent, callback);
+
+  // Phase durations accumulate over the frame, phases that are not started have a zero duration
+  timingLog->StartFrame();
+  CHECK_INT(eventCounts[0], 1);
+  CHECK_INT(eventCounts[1], 0);
+  timingLog->StartPhase(render);
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  timingLog->EndPhase(render);
+  double firstRenderDuration = timingLog->GetCurrentPhaseDuration(render);
+  CHECK_BOOL(firstRenderDuration > 0.0, true);
+  timingLog->StartPhase(render);
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  timingLog->EndPhase(render);
+  CHECK_BOOL(timingLog->GetCurrentPhaseDuration(render) > firstRenderDuration, true);
+  CHECK_DOUBLE(timingLog->GetCurrentPhaseDuration(motionCheck), 0.0);
+  timingLog->EndFrame(false);
+  CHECK_INT(eventCounts[1], 1);
+  CHECK_INT(timingLog->GetNumberOfFrames(), 1);
+  CHECK_BOOL(timingLog->GetPhaseDuration(0, total) >= timingLog->GetPhaseDuration(0, render), true);
+  CHECK_DOUBLE(timingLog->GetPhaseDuration(0, motionCheck), 0.0);
+  CHECK_BOOL(timingLog->GetFrameDropped(0), false);
+
+  // Invalid phase and frame
+  TESTING_OUTPUT_ASSERT_ERRORS_BEGIN();
+  CHECK_DOUBLE(timingLog->GetCurrentPhaseDuration(vtkVirtualRealityFrameTimingLog::Phase_Last), 0.0);
+  CHECK_DOUBLE(timingLog->GetPhaseDuration(1, total), 0.0);
+  CHECK_DOUBLE(timingLog->GetFrameStartTime(-1), 0.0);
+  CHECK_DOUBLE(timingLog->GetPhaseDurationMean(-1), 0.0);
+  TESTING_OUTPUT_ASSERT_ERRORS_END();
+
+  // Ring wraps around: durations of 1 to 10 ms, only the last 8 frames are stored.
+  // Frames of even durations are dropped.
+  timingLog->Clear();
+  CHECK_INT(timingLog->GetNumberOfFrames(), 0);
+  CHECK_INT(timingLog->GetNumberOfRecordedFrames(), 0);
+  for (int frame = 1; frame <= 10; ++frame)
+  {
+    timingLog->RecordFrame(motionCheck, frame * 0.001, frame % 2 == 0);
+  }
+  CHECK_INT(eventCounts[0], 11);
+  CHECK_INT(eventCounts[1], 11);
+  CHECK_INT(timingLog->GetNumberOfFrames(), 8);
+  CHECK_INT(timingLog->GetNumberOfRecordedFrames(), 10);
+  for (int frameIndex = 0; frameIndex < 8; ++frameIndex)
+  {
+    // Oldest stored frame is the third one
+    CHECK_DOUBLE_TOLERANCE(timingLog->GetPhaseDuration(frameIndex, motionCheck), (frameIndex + 3) * 0.001, 1e-12);
+    CHECK_BOOL(timingLog->GetFrameDropped(frameIndex), (frameIndex + 3) % 2 == 0);
+    CHECK_DOUBLE(timingLog->GetPhaseDuration(frameIndex, render), 0.0);
+    if (frameIndex > 0)
+    {
+      CHECK_BOOL(timingLog->GetFrameStartTime(frameIndex) >= timingLog->GetFrameStartTime(frameIndex - 1), true);
+    }
+  }
+
+  // Per-phase statistics of the stored frames (3 to 10 ms)
+  CHECK_DOUBLE_TOLERANCE(timingLog->GetPhaseDurationMean(motionCheck), 0.0065, 1e-12);
+  CHECK_DOUBLE_TOLERANCE(timingLog->GetPhaseDurationMaximum(motionCheck), 0.010, 1e-12);
+  CHECK_DOUBLE_TOLERANCE(timingLog->GetPhaseDurationPercentile(motionCheck, 0.0), 0.003, 1e-12);
+  CHECK_DOUBLE_TOLERANCE(timingLog->GetPhaseDurationPercentile(motionCheck, 50.0), 0.006, 1e-12);
+  CHECK_DOUBLE_TOLERANCE(timingLog->GetPhaseDurationPercentile(motionCheck, 90.0), 0.010, 1e-12);
+  CHECK_DOUBLE_TOLERANCE(timingLog->GetPhaseDurationPercentile(motionCheck, 100.0), 0.010, 1e-12);
+  // Percentile is clamped to [0, 100]
+  CHECK_DOUBLE_TOLERANCE(timingLog->GetPhaseDurationPercentile(motionCheck, 150.0), 0.010, 1e-12);
+  CHECK_DOUBLE(timingLog->GetPhaseDurationMaximum(render), 0.0);
+  CHECK_INT(timingLog->GetNumberOfDroppedFrames(), 4);
+  // Computing percentiles does not change the stored frames
+  CHECK_DOUBLE_TOLERANCE(timingLog->GetPhaseDuration(0, motionCheck), 0.003, 1e-12);
+
+  // Setting the capacity clears the log
+  timingLog->SetCapacity(4);
+  CHECK_INT(timingLog->GetNumberOfFrames(), 0);
+  CHECK_INT(timingLog->GetNumberOfRecordedFrames(), 0);
+  CHECK_INT(timingLog->GetNumberOfDroppedFrames(), 0);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,151 @@
+
+// VirtualReality Logic includes
+#include <vtkVirtualRealityInputEventQueue.h>
+
+// MRML includes
+#include <vtkMRMLCoreTestingMacros.h>
+
+// VTK includes
+#include <vtkCommand.h>
+#include <vtkEventData.h>
+#include <vtkNew.h>
+#include <vtkSmartPointer.h>
+
+// STD includes
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+vtkVirtualRealityInputEventQueue::InputEvent MakeEvent(int index)
+{
+  vtkVirtualRealityInputEventQueue::InputEvent event;
+  event.Type = vtkVirtualRealityInputEventQueue::InputEvent::ButtonEventType;
+  event.Time = static_cast<double>(index);
+  event.Values[0] = static_cast<double>(index);
+  return event;
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+int vtkVirtualRealityInputEventQueueTest1(int , char * [])
+{
+  typedef vtkVirtualRealityInputEventQueue::InputEvent InputEvent;
+
+  CHECK_STRING(vtkVirtualRealityInputEventQueue::GetEventTypeAsString(InputEvent::PoseEventType), "Pose");
+  CHECK_INT(vtkVirtualRealityInputEventQueue::GetEventTypeFromString("Axis"), InputEvent::AxisEventType);
+  CHECK_INT(vtkVirtualRealityInputEventQueue::GetEventTypeFromString("any"), -1);
+
+  vtkNew<vtkVirtualRealityInputEventQueue> queue;
+  CHECK_INT(queue->GetCapacity(), 256);
+
+  // Capacity is rounded up to a power of two
+  queue->SetCapacity(5);
+  CHECK_INT(queue->GetCapacity(), 8);
+
+  InputEvent event;
+  CHECK_BOOL(queue->Pop(event), false);
+
+  // Events are popped in order
+  for (int index = 0; index < 3; ++index)
+  {
+    CHECK_BOOL(queue->Push(MakeEvent(index)), true);
+  }
+  CHECK_INT(queue->GetNumberOfEvents(), 3);
+  CHECK_BOOL(queue->Pop(event), true);
+  CHECK_DOUBLE(event.Time, 0.0);
+  CHECK_INT(queue->GetNumberOfEvents(), 2);
+
+  // New events are dropped and counted when the queue is full
+  for (int index = 3; index < 12; ++index)
+  {
+    queue->Push(MakeEvent(index));
+  }
+  CHECK_INT(queue->GetNumberOfEvents(), 8);
+  CHECK_INT(static_cast<int>(queue->GetNumberOfOverflows()), 3);
+
+  // Batches, across the end of the ring
+  std::vector<InputEvent> events;
+  CHECK_INT(queue->PopEvents(events, 5), 5);
+  CHECK_INT(queue->PopEvents(events), 3);
+  CHECK_INT(static_cast<int>(events.size()), 8);
+  for (int index = 0; index < 8; ++index)
+  {
+    CHECK_DOUBLE(events[index].Values[0], static_cast<double>(index + 1));
+  }
+  CHECK_INT(queue->GetNumberOfEvents(), 0);
+  CHECK_INT(queue->PopEvents(events), 0);
+
+  queue->Clear();
+  CHECK_INT(static_cast<int>(queue->GetNumberOfOverflows()), 0);
+
+  // Events created from VTK event data
+  vtkSmartPointer<vtkEventDataDevice3D> buttonData = vtkSmartPointer<vtkEventDataDevice3D>::Take(
+    vtkEventDataDevice3D::New());
+  buttonData->SetDevice(vtkEventDataDevice::RightController);
+  buttonData->SetInput(vtkEventDataDeviceInput::TrackPad);
+  buttonData->SetAction(vtkEventDataAction::Press);
+  double trackPadPosition[2] = { 0.25, -0.5 };
+  buttonData->SetTrackPadPosition(trackPadPosition);
+  CHECK_BOOL(queue->PushEvent(vtkCommand::Button3DEvent, buttonData, 1.5), true);
+  CHECK_BOOL(queue->Pop(event), true);
+  CHECK_INT(event.Type, InputEvent::ButtonEventType);
+  CHECK_INT(event.Device, static_cast<int>(vtkEventDataDevice::RightController));
+  CHECK_INT(event.Input, static_cast<int>(vtkEventDataDeviceInput::TrackPad));
+  CHECK_INT(event.Action, static_cast<int>(vtkEventDataAction::Press));
+  CHECK_DOUBLE(event.Time, 1.5);
+  CHECK_DOUBLE(event.Values[1], -0.5);
+
+  vtkSmartPointer<vtkEventDataDevice3D> poseData = vtkSmartPointer<vtkEventDataDevice3D>::Take(
+    vtkEventDataDevice3D::New());
+  poseData->SetDevice(vtkEventDataDevice::LeftController);
+  double position[3] = { 1.0, 2.0, 3.0 };
+  double orientation[4] = { 1.0, 0.0, 0.0, 0.0 };
+  poseData->SetWorldPosition(position);
+  poseData->SetWorldOrientation(orientation);
+  CHECK_BOOL(queue->PushEvent(vtkCommand::Move3DEvent, poseData, 2.0), true);
+  CHECK_BOOL(queue->PushEvent(vtkCommand::ViewerMovement3DEvent, buttonData, 2.0), true);
+  CHECK_BOOL(queue->Pop(event), true);
+  CHECK_INT(event.Type, InputEvent::PoseEventType);
+  CHECK_DOUBLE(event.Values[2], 3.0);
+  CHECK_DOUBLE(event.Values[3], 1.0);
+  CHECK_BOOL(queue->Pop(event), true);
+  CHECK_INT(event.Type, InputEvent::AxisEventType);
+
+  // Producer and consumer threads, no event is lost or reordered
+  queue->SetCapacity(64);
+  const int numberOfEvents = 100000;
+  std::thread producer([&queue, numberOfEvents]()
+    {
+      for (int index = 0; index < numberOfEvents; ++index)
+      {
+        while (!queue->Push(MakeEvent(index)))
+        {
+          std::this_thread::yield();
+        }
+      }
+    });
+  int expectedIndex = 0;
+  bool ordered = true;
+  while (expectedIndex < numberOfEvents)
+  {
+    if (!queue->Pop(event))
+    {
+      std::this_thread::yield();
+      continue;
+    }
+    if (event.Values[0] != static_cast<double>(expectedIndex))
+    {
+      ordered = false;
+    }
+    ++expectedIndex;
+  }
+  producer.join();
+  CHECK_BOOL(ordered, true);
+  CHECK_INT(queue->GetNumberOfEvents(), 0);
+
+  return EXIT_SUCCESS;
+}
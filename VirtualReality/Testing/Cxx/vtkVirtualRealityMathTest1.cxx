@@ -0,0 +1,140 @@
+
+// VirtualReality Logic includes
+#include <vtkVirtualRealityMath.h>
+
+// MRML includes
+#include <vtkMRMLCoreTestingMacros.h>
+
+// VTK includes
+#include <vtkMath.h>
+#include <vtkMatrix4x4.h>
+#include <vtkNew.h>
+#include <vtkQuaternion.h>
+#include <vtkTransform.h>
+
+// STD includes
+#include <cmath>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+bool AreEqual(const vtkVirtualRealityMath::Matrix4& matrix1, vtkMatrix4x4* matrix2, double tolerance = 1e-9)
+{
+  for (int i = 0; i < 16; ++i)
+  {
+    if (std::fabs(matrix1.Elements[i] - matrix2->GetData()[i]) > tolerance)
+    {
+      std::cerr << "Element " << i << " differs: " << matrix1.Elements[i] << " != " << matrix2->GetData()[i] << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+int vtkVirtualRealityMathTest1(int , char * [])
+{
+  using vtkVirtualRealityMath::Matrix4;
+  using vtkVirtualRealityMath::Quaternion;
+
+  // Compile-time evaluation
+  constexpr Matrix4 translation = Matrix4::Translation(1.0, 2.0, 3.0) * Matrix4::Scaling(2.0);
+  static_assert(translation(0, 0) == 2.0 && translation(2, 3) == 3.0, "Unexpected constexpr matrix product");
+
+  // Multiplication and inversion match vtkMatrix4x4
+  vtkNew<vtkTransform> transform1;
+  transform1->Translate(10.0, -5.0, 2.0);
+  transform1->RotateWXYZ(30.0, 1.0, 2.0, 3.0);
+  transform1->Scale(2.0, 2.0, 2.0);
+  vtkNew<vtkTransform> transform2;
+  transform2->RotateWXYZ(-70.0, 0.0, 1.0, 0.5);
+  transform2->Translate(1.0, 2.0, 3.0);
+  vtkNew<vtkMatrix4x4> product;
+  vtkMatrix4x4::Multiply4x4(transform1->GetMatrix(), transform2->GetMatrix(), product);
+  Matrix4 matrix1 = Matrix4::FromVTK(transform1->GetMatrix());
+  Matrix4 matrix2 = Matrix4::FromVTK(transform2->GetMatrix());
+  CHECK_BOOL(AreEqual(matrix1 * matrix2, product), true);
+
+  vtkNew<vtkMatrix4x4> inverse;
+  vtkMatrix4x4::Invert(transform1->GetMatrix(), inverse);
+  Matrix4 inverseMatrix1;
+  CHECK_BOOL(vtkVirtualRealityMath::Invert(matrix1, inverseMatrix1), true);
+  CHECK_BOOL(AreEqual(inverseMatrix1, inverse), true);
+  CHECK_BOOL(vtkVirtualRealityMath::Invert(Matrix4::Scaling(0.0), inverseMatrix1), false);
+
+  vtkNew<vtkMatrix4x4> converted;
+  matrix1.ToVTK(converted);
+  CHECK_BOOL(AreEqual(matrix1, converted), true);
+
+  // Quaternions match vtkQuaternion
+  vtkQuaternion<double> vtkQuaternion1;
+  vtkQuaternion1.SetRotationAngleAndAxis(0.3, 1.0, 2.0, 3.0);
+  vtkQuaternion<double> vtkQuaternion2;
+  vtkQuaternion2.SetRotationAngleAndAxis(-1.2, 0.0, 1.0, 0.0);
+  vtkQuaternion<double> vtkProduct = vtkQuaternion2 * vtkQuaternion1.Conjugated();
+  Quaternion quaternionProduct = Quaternion::FromAngleAxis(-1.2, 0.0, 1.0, 0.0)
+    * Quaternion::FromAngleAxis(0.3, 1.0, 2.0, 3.0).Conjugate();
+  CHECK_DOUBLE_TOLERANCE(quaternionProduct.W, vtkProduct.GetW(), 1e-12);
+  CHECK_DOUBLE_TOLERANCE(quaternionProduct.X, vtkProduct.GetX(), 1e-12);
+  CHECK_DOUBLE_TOLERANCE(quaternionProduct.Y, vtkProduct.GetY(), 1e-12);
+  CHECK_DOUBLE_TOLERANCE(quaternionProduct.Z, vtkProduct.GetZ(), 1e-12);
+
+  vtkNew<vtkTransform> rotation;
+  rotation->RotateWXYZ(40.0, 1.0, -1.0, 2.0);
+  CHECK_BOOL(AreEqual(Quaternion::FromAngleAxis(vtkMath::RadiansFromDegrees(40.0), 1.0, -1.0, 2.0).ToMatrix(),
+    rotation->GetMatrix()), true);
+  vtkNew<vtkMatrix4x4> identity;
+  CHECK_BOOL(AreEqual(Quaternion::FromAngleAxis(1.0, 0.0, 0.0, 0.0).ToMatrix(), identity), true);
+
+  // Grab interaction transform matches the transform previously computed with vtkTransform
+  double worldPosition[3] = { 10.0, 20.0, 30.0 };
+  double lastWorldPosition[3] = { 12.0, 19.0, 27.0 };
+  double worldOrientation[4] = { 35.0, 0.0, 0.0, 1.0 };
+  double lastWorldOrientation[4] = { 20.0, 0.0, 1.0, 1.0 };
+  vtkNew<vtkTransform> interactionTransform;
+  interactionTransform->PreMultiply();
+  vtkQuaternion<double> q1;
+  q1.SetRotationAngleAndAxis(vtkMath::RadiansFromDegrees(lastWorldOrientation[0]),
+    lastWorldOrientation[1], lastWorldOrientation[2], lastWorldOrientation[3]);
+  vtkQuaternion<double> q2;
+  q2.SetRotationAngleAndAxis(vtkMath::RadiansFromDegrees(worldOrientation[0]),
+    worldOrientation[1], worldOrientation[2], worldOrientation[3]);
+  q1.Conjugate();
+  q2 = q2 * q1;
+  double axis[4] = { 0.0, 0.0, 0.0, 0.0 };
+  axis[0] = vtkMath::DegreesFromRadians(q2.GetRotationAngleAndAxis(axis + 1));
+  interactionTransform->Translate(worldPosition[0], worldPosition[1], worldPosition[2]);
+  interactionTransform->RotateWXYZ(axis[0], axis[1], axis[2], axis[3]);
+  interactionTransform->Translate(-worldPosition[0], -worldPosition[1], -worldPosition[2]);
+  interactionTransform->Translate(worldPosition[0] - lastWorldPosition[0],
+    worldPosition[1] - lastWorldPosition[1], worldPosition[2] - lastWorldPosition[2]);
+  CHECK_BOOL(AreEqual(vtkVirtualRealityMath::GrabInteractionTransform(
+    worldPosition, lastWorldPosition, worldOrientation, lastWorldOrientation), interactionTransform->GetMatrix()), true);
+
+  // Combined controller pose
+  Matrix4 controller0Pose = Matrix4::Translation(-0.2, 1.0, 0.0);
+  Matrix4 controller1Pose = Matrix4::Translation(0.2, 1.0, 0.0);
+  Matrix4 combinedPose = Matrix4::Identity();
+  CHECK_BOOL(vtkVirtualRealityMath::CombinedControllerPose(controller0Pose, controller1Pose, combinedPose), true);
+  CHECK_DOUBLE_TOLERANCE(combinedPose(0, 0), 0.4, 1e-12);
+  CHECK_DOUBLE_TOLERANCE(combinedPose(1, 1), 0.4, 1e-12);
+  CHECK_DOUBLE_TOLERANCE(combinedPose(2, 2), 0.4, 1e-12);
+  CHECK_DOUBLE_TOLERANCE(combinedPose(1, 3), 1.0, 1e-12);
+  // Controllers displaced along their Y axis
+  controller1Pose = Matrix4::Translation(-0.2, 2.0, 0.0);
+  CHECK_BOOL(vtkVirtualRealityMath::CombinedControllerPose(controller0Pose, controller1Pose, combinedPose), false);
+
+  // Pinch 3D: moving both controllers by the same offset moves the world by the opposite offset
+  Matrix4 physicalToWorld = matrix1;
+  Matrix4 startingPose = Matrix4::Translation(0.0, 1.0, 0.0);
+  Matrix4 currentPose = Matrix4::Translation(0.5, 1.0, 0.0);
+  Matrix4 pinchPhysicalToWorld = vtkVirtualRealityMath::Pinch3DPhysicalToWorld(physicalToWorld, startingPose, currentPose);
+  vtkNew<vtkMatrix4x4> expectedPhysicalToWorld;
+  (physicalToWorld * Matrix4::Translation(-0.5, 0.0, 0.0)).ToVTK(expectedPhysicalToWorld);
+  CHECK_BOOL(AreEqual(pinchPhysicalToWorld, expectedPhysicalToWorld), true);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,146 @@
+
+// VirtualReality Logic includes
+#include <vtkVirtualRealityPoseTraceReader.h>
+#include <vtkVirtualRealityPoseTraceWriter.h>
+
+// VirtualReality MRMLDM includes
+#include <vtkVirtualRealityPoseTracePlayer.h>
+#include <vtkVirtualRealitySimulatedRenderWindow.h>
+#include <vtkVirtualRealityViewSimulatedInteractor.h>
+
+// MRML includes
+#include <vtkMRMLCoreTestingMacros.h>
+
+// VTK includes
+#include <vtkCallbackCommand.h>
+#include <vtkCommand.h>
+#include <vtkEventData.h>
+#include <vtkMatrix4x4.h>
+#include <vtkNew.h>
+
+// STD includes
+#include <string>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+void CountEvent(vtkObject* vtkNotUsed(caller), unsigned long vtkNotUsed(eid), void* clientData, void* vtkNotUsed(callData))
+{
+  int* count = static_cast<int*>(clientData);
+  (*count)++;
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+int vtkVirtualRealityPoseTracePlayerTest1(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << argv[0] << " <temporary-directory>" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::string fileName = std::string(argv[1]) + "/vtkVirtualRealityPoseTracePlayerTest1.bin";
+
+  // Record a trace: the HMD moves along X, a button is pressed at frame 2
+  const int numberOfFrames = 4;
+  vtkNew<vtkMatrix4x4> hmdPose;
+  vtkNew<vtkMatrix4x4> physicalToWorld;
+  physicalToWorld->SetElement(0, 0, 10.0);
+  physicalToWorld->SetElement(1, 1, 10.0);
+  physicalToWorld->SetElement(2, 2, 10.0);
+  physicalToWorld->SetElement(2, 3, -25.0);
+  vtkNew<vtkEventDataDevice3D> eventData;
+  eventData->SetDevice(vtkEventDataDevice::RightController);
+  eventData->SetInput(vtkEventDataDeviceInput::Trigger);
+  eventData->SetAction(vtkEventDataAction::Press);
+
+  vtkNew<vtkVirtualRealityPoseTraceWriter> writer;
+  CHECK_BOOL(writer->Open(fileName.c_str()), true);
+  for (int frame = 0; frame < numberOfFrames; ++frame)
+  {
+    writer->WriteFrame(0.1 * frame);
+    if (frame == 2)
+    {
+      writer->WriteEvent(vtkCommand::Button3DEvent, eventData);
+    }
+    hmdPose->SetElement(0, 3, frame);
+    writer->WriteDevicePose(vtkVirtualRealitySimulatedRenderWindow::HMDDeviceHandle,
+      vtkEventDataDevice::HeadMountedDisplay, hmdPose);
+    writer->WritePhysicalToWorldMatrix(physicalToWorld);
+  }
+  writer->Close();
+
+  vtkNew<vtkVirtualRealityPoseTracePlayer> player;
+  CHECK_BOOL(player->Load(fileName.c_str()), true);
+  CHECK_INT(player->GetReader()->GetNumberOfFrames(), numberOfFrames);
+
+  // Frames cannot be applied without simulated render window
+  TESTING_OUTPUT_ASSERT_ERRORS_BEGIN();
+  CHECK_BOOL(player->ApplyFrame(0), false);
+  CHECK_BOOL(player->ApplyFrame(numberOfFrames), false);
+  TESTING_OUTPUT_ASSERT_ERRORS_END();
+
+  vtkNew<vtkVirtualRealitySimulatedRenderWindow> renderWindow;
+  vtkNew<vtkVirtualRealityViewSimulatedInteractor> interactor;
+  interactor->SetRenderWindow(renderWindow);
+  player->SetInteractor(interactor);
+  CHECK_POINTER(player->GetInteractor(), interactor.GetPointer());
+
+  int numberOfEndEvents = 0;
+  vtkNew<vtkCallbackCommand> endCallback;
+  endCallback->SetCallback(CountEvent);
+  endCallback->SetClientData(&numberOfEndEvents);
+  player->AddObserver(vtkCommand::EndEvent, endCallback);
+
+  // Frames are only applied while playing
+  interactor->InvokeEvent(vtkVirtualRealityViewSimulatedInteractor::UpdateDevicesEvent);
+  CHECK_NULL(renderWindow->GetDeviceToPhysicalMatrixForDeviceHandle(vtkVirtualRealitySimulatedRenderWindow::HMDDeviceHandle));
+
+  // One frame is applied each time the interactor updates the devices
+  player->Play();
+  CHECK_BOOL(player->GetPlaying(), true);
+  for (int frame = 0; frame < numberOfFrames; ++frame)
+  {
+    CHECK_INT(player->GetCurrentFrame(), frame);
+    interactor->InvokeEvent(vtkVirtualRealityViewSimulatedInteractor::UpdateDevicesEvent);
+    vtkMatrix4x4* pose =
+      renderWindow->GetDeviceToPhysicalMatrixForDeviceHandle(vtkVirtualRealitySimulatedRenderWindow::HMDDeviceHandle);
+    CHECK_NOT_NULL(pose);
+    CHECK_DOUBLE(pose->GetElement(0, 3), frame);
+    CHECK_INT(interactor->GetNumberOfQueuedEvents(), frame >= 2 ? 1 : 0);
+  }
+  renderWindow->GetPhysicalToWorldMatrix(hmdPose);
+  CHECK_DOUBLE_TOLERANCE(hmdPose->GetElement(0, 0), 10.0, 1e-6);
+  CHECK_DOUBLE_TOLERANCE(hmdPose->GetElement(2, 3), -25.0, 1e-6);
+
+  // Playback stops after the last frame
+  CHECK_BOOL(player->GetPlaying(), false);
+  CHECK_INT(numberOfEndEvents, 1);
+  interactor->InvokeEvent(vtkVirtualRealityViewSimulatedInteractor::UpdateDevicesEvent);
+  CHECK_INT(player->GetCurrentFrame(), numberOfFrames);
+
+  // Looping restarts from the first frame
+  player->SetLoop(true);
+  player->Play();
+  for (int frame = 0; frame < numberOfFrames + 1; ++frame)
+  {
+    interactor->InvokeEvent(vtkVirtualRealityViewSimulatedInteractor::UpdateDevicesEvent);
+  }
+  CHECK_BOOL(player->GetPlaying(), true);
+  CHECK_INT(player->GetCurrentFrame(), 1);
+  CHECK_DOUBLE(renderWindow->GetDeviceToPhysicalMatrixForDeviceHandle(
+    vtkVirtualRealitySimulatedRenderWindow::HMDDeviceHandle)->GetElement(0, 3), 0.0);
+  CHECK_INT(numberOfEndEvents, 1);
+  player->Stop();
+  CHECK_BOOL(player->GetPlaying(), false);
+
+  // Interactor is no longer observed
+  player->Play();
+  player->SetInteractor(nullptr);
+  interactor->InvokeEvent(vtkVirtualRealityViewSimulatedInteractor::UpdateDevicesEvent);
+  CHECK_INT(player->GetCurrentFrame(), 0);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,110 @@
+
+// VirtualReality Logic includes
+#include <vtkVirtualRealityPoseTraceReader.h>
+#include <vtkVirtualRealityPoseTraceWriter.h>
+
+// MRML includes
+#include <vtkMRMLCoreTestingMacros.h>
+
+// VTK includes
+#include <vtkCommand.h>
+#include <vtkEventData.h>
+#include <vtkMatrix4x4.h>
+#include <vtkNew.h>
+
+// STD includes
+#include <string>
+
+int vtkVirtualRealityPoseTraceTest1(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << argv[0] << " <temporary-directory>" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::string fileName = std::string(argv[1]) + "/vtkVirtualRealityPoseTraceTest1.bin";
+
+  vtkNew<vtkMatrix4x4> hmdPose;
+  hmdPose->SetElement(0, 1, 0.5);
+  hmdPose->SetElement(1, 3, 1.7);
+  vtkNew<vtkMatrix4x4> physicalToWorld;
+  physicalToWorld->SetElement(0, 0, 100.0);
+  physicalToWorld->SetElement(2, 3, -25.0);
+  vtkNew<vtkEventDataDevice3D> eventData;
+  eventData->SetDevice(vtkEventDataDevice::RightController);
+  eventData->SetInput(vtkEventDataDeviceInput::TrackPad);
+  eventData->SetAction(vtkEventDataAction::Press);
+  eventData->SetTrackPadPosition(0.25, -0.75);
+
+  // Use a small buffer so that records are flushed while recording
+  const int numberOfFrames = 10;
+  vtkNew<vtkVirtualRealityPoseTraceWriter> writer;
+  writer->SetBufferSize(3);
+  CHECK_BOOL(writer->Open(fileName.c_str()), true);
+  for (int frame = 0; frame < numberOfFrames; ++frame)
+  {
+    writer->WriteFrame(0.1 * frame);
+    if (frame == 5)
+    {
+      writer->WriteEvent(vtkCommand::Button3DEvent, eventData);
+    }
+    hmdPose->SetElement(0, 3, frame);
+    writer->WriteDevicePose(0, vtkEventDataDevice::HeadMountedDisplay, hmdPose);
+    writer->WritePhysicalToWorldMatrix(physicalToWorld);
+  }
+  CHECK_INT(writer->GetNumberOfFrames(), numberOfFrames);
+  writer->Close();
+  CHECK_BOOL(writer->IsOpen(), false);
+
+  vtkNew<vtkVirtualRealityPoseTraceReader> reader;
+  CHECK_BOOL(reader->Read(fileName.c_str()), true);
+  CHECK_INT(reader->GetNumberOfFrames(), numberOfFrames);
+  CHECK_DOUBLE(reader->GetFrameTime(3), 0.3);
+  CHECK_INT(reader->GetNumberOfFrameRecords(4), 2);
+  CHECK_INT(reader->GetNumberOfFrameRecords(5), 3);
+  CHECK_NULL(reader->GetFrameRecord(4, 2));
+
+  const vtkVirtualRealityPoseTraceRecord* record = reader->GetFrameRecord(5, 0);
+  CHECK_NOT_NULL(record);
+  CHECK_INT(record->Type, vtkVirtualRealityPoseTraceRecord::EventRecordType);
+  CHECK_INT(record->EventId, vtkCommand::Button3DEvent);
+  CHECK_INT(record->Device, static_cast<int>(vtkEventDataDevice::RightController));
+  CHECK_INT(record->Input, static_cast<int>(vtkEventDataDeviceInput::TrackPad));
+  CHECK_INT(record->Action, static_cast<int>(vtkEventDataAction::Press));
+  CHECK_DOUBLE(record->Values[0], 0.25);
+  CHECK_DOUBLE(record->Values[1], -0.75);
+
+  vtkNew<vtkMatrix4x4> matrix;
+  record = reader->GetFrameRecord(7, 0);
+  CHECK_INT(record->Type, vtkVirtualRealityPoseTraceRecord::DevicePoseRecordType);
+  CHECK_INT(record->Device, static_cast<int>(vtkEventDataDevice::HeadMountedDisplay));
+  vtkVirtualRealityPoseTraceReader::GetRecordMatrix(record, matrix);
+  hmdPose->SetElement(0, 3, 7);
+  for (int i = 0; i < 4; ++i)
+  {
+    for (int j = 0; j < 4; ++j)
+    {
+      CHECK_DOUBLE(matrix->GetElement(i, j), hmdPose->GetElement(i, j));
+    }
+  }
+
+  record = reader->GetFrameRecord(7, 1);
+  CHECK_INT(record->Type, vtkVirtualRealityPoseTraceRecord::PhysicalToWorldRecordType);
+  vtkVirtualRealityPoseTraceReader::GetRecordMatrix(record, matrix);
+  CHECK_DOUBLE(matrix->GetElement(0, 0), 100.0);
+  CHECK_DOUBLE(matrix->GetElement(2, 3), -25.0);
+  CHECK_DOUBLE(matrix->GetElement(3, 3), 1.0);
+
+  // Reading a file that is not a pose trace fails
+  std::string invalidFileName = std::string(argv[1]) + "/vtkVirtualRealityPoseTraceTest1-invalid.bin";
+  FILE* invalidFile = fopen(invalidFileName.c_str(), "wb");
+  CHECK_NOT_NULL(invalidFile);
+  fputs("not a pose trace file, not a pose trace file", invalidFile);
+  fclose(invalidFile);
+  TESTING_OUTPUT_ASSERT_ERRORS_BEGIN();
+  CHECK_BOOL(reader->Read(invalidFileName.c_str()), false);
+  TESTING_OUTPUT_ASSERT_ERRORS_END();
+  CHECK_INT(reader->GetNumberOfFrames(), 0);
+
+  return EXIT_SUCCESS;
+}
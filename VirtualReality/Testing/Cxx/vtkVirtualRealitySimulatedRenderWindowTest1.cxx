@@ -0,0 +1,100 @@
+
+// VirtualReality MRMLDM includes
+#include <vtkVirtualRealitySimulatedCamera.h>
+#include <vtkVirtualRealitySimulatedRenderer.h>
+#include <vtkVirtualRealitySimulatedRenderWindow.h>
+
+// MRML includes
+#include <vtkMRMLCoreTestingMacros.h>
+
+// VTK includes
+#include <vtkActor.h>
+#include <vtkMatrix4x4.h>
+#include <vtkNew.h>
+#include <vtkOpenGLFramebufferObject.h>
+#include <vtkOpenGLState.h>
+#include <vtkPolyDataMapper.h>
+#include <vtkProperty.h>
+#include <vtkSphereSource.h>
+#if __has_include(<vtk_glad.h>)
+#include <vtk_glad.h>
+#else
+#include <vtk_glew.h>
+#endif
+
+//----------------------------------------------------------------------------
+int vtkVirtualRealitySimulatedRenderWindowTest1(int , char * [])
+{
+  vtkNew<vtkVirtualRealitySimulatedRenderWindow> renderWindow;
+  renderWindow->SetEyeRenderSize(64, 48);
+  vtkNew<vtkVirtualRealitySimulatedRenderer> renderer;
+  renderer->SetBackground(0.0, 0.0, 0.0);
+  renderWindow->AddRenderer(renderer);
+
+  // Red sphere at the origin of the physical space
+  vtkNew<vtkSphereSource> sphere;
+  sphere->SetRadius(0.2);
+  vtkNew<vtkPolyDataMapper> mapper;
+  mapper->SetInputConnection(sphere->GetOutputPort());
+  vtkNew<vtkActor> actor;
+  actor->SetMapper(mapper);
+  actor->GetProperty()->SetColor(1.0, 0.0, 0.0);
+  actor->GetProperty()->SetAmbient(1.0);
+  actor->GetProperty()->SetDiffuse(0.0);
+  renderer->AddActor(actor);
+
+  // HMD is 1 m in front of the sphere, looking at it
+  vtkNew<vtkMatrix4x4> physicalToWorldMatrix;
+  renderWindow->SetPhysicalToWorldMatrix(physicalToWorldMatrix);
+  vtkNew<vtkMatrix4x4> hmdToPhysicalMatrix;
+  hmdToPhysicalMatrix->SetElement(2, 3, 1.0);
+  renderWindow->SetDeviceToPhysicalMatrix(vtkVirtualRealitySimulatedRenderWindow::HMDDeviceHandle,
+    vtkEventDataDevice::HeadMountedDisplay, hmdToPhysicalMatrix);
+
+  // Eye framebuffer is created when the window is initialized
+  renderWindow->Initialize();
+  CHECK_BOOL(renderWindow->GetVRInitialized(), true);
+  CHECK_NOT_NULL(renderWindow->GetEyeFramebuffer());
+  CHECK_BOOL(renderWindow->GetEyeFramebuffer()->GetFBOIndex() != 0, true);
+  CHECK_INT(renderWindow->GetEyeFramebuffer()->GetLastSize()[0], 64);
+  CHECK_INT(renderWindow->GetEyeFramebuffer()->GetLastSize()[1], 48);
+
+  renderWindow->Render();
+
+  // Rendered frame is copied into the eye framebuffer: sphere at the center, background at the corner
+  unsigned char center[4] = { 0, 0, 0, 0 };
+  unsigned char corner[4] = { 255, 255, 255, 255 };
+  renderWindow->MakeCurrent();
+  vtkOpenGLState* state = renderWindow->GetState();
+  state->PushReadFramebufferBinding();
+  renderWindow->GetEyeFramebuffer()->Bind(GL_READ_FRAMEBUFFER);
+  renderWindow->GetEyeFramebuffer()->ActivateReadBuffer(0);
+  glReadPixels(32, 24, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, center);
+  glReadPixels(0, 0, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, corner);
+  state->PopReadFramebufferBinding();
+  CHECK_BOOL(center[0] > 200, true);
+  CHECK_BOOL(center[1] < 50, true);
+  CHECK_BOOL(center[2] < 50, true);
+  CHECK_BOOL(corner[0] < 50, true);
+
+  // Camera follows the HMD pose and its eye matrices project the sphere center at the center of the image
+  vtkVirtualRealitySimulatedCamera* camera = vtkVirtualRealitySimulatedCamera::SafeDownCast(renderer->GetActiveCamera());
+  CHECK_NOT_NULL(camera);
+  CHECK_DOUBLE_TOLERANCE(camera->GetPosition()[2], 1.0, 1e-6);
+  vtkMatrix4x4* physicalToProjectionMatrix = nullptr;
+  camera->GetPhysicalToProjectionMatrix(physicalToProjectionMatrix);
+  CHECK_NOT_NULL(physicalToProjectionMatrix);
+  // Matrices are stored transposed, the point is multiplied as a row vector
+  double origin[4] = { 0.0, 0.0, 0.0, 1.0 };
+  double projected[4] = { 0.0, 0.0, 0.0, 0.0 };
+  vtkNew<vtkMatrix4x4> projectionMatrix;
+  vtkMatrix4x4::Transpose(physicalToProjectionMatrix, projectionMatrix);
+  projectionMatrix->MultiplyPoint(origin, projected);
+  CHECK_BOOL(projected[3] > 0.0, true);
+  CHECK_DOUBLE_TOLERANCE(projected[0] / projected[3], 0.0, 1e-6);
+  CHECK_DOUBLE_TOLERANCE(projected[1] / projected[3], 0.0, 1e-6);
+  CHECK_BOOL(projected[2] / projected[3] > -1.0 && projected[2] / projected[3] < 1.0, true);
+
+  renderWindow->Finalize();
+  return EXIT_SUCCESS;
+}
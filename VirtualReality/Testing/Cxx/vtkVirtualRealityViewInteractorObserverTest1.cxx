@@ -0,0 +1,267 @@
+
+// VirtualReality MRMLDM includes
+#include <vtkVirtualRealityViewInteractorObserver.h>
+
+// MRMLDisplayableManager includes
+#include <vtkMRMLAbstractDisplayableManager.h>
+#include <vtkMRMLDisplayableManagerGroup.h>
+
+// MRML includes
+#include <vtkMRMLCoreTestingMacros.h>
+#include <vtkMRMLInteractionEventData.h>
+
+// VTK includes
+#include <vtkCommand.h>
+#include <vtkEventData.h>
+#include <vtkInteractorStyle.h>
+#include <vtkNew.h>
+#include <vtkObjectFactory.h>
+#include <vtkRenderWindow.h>
+#include <vtkRenderWindowInteractor.h>
+#include <vtkRenderer.h>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+/// Displayable manager processing the events it is offered if CanProcess is set
+class vtkTestDisplayableManager : public vtkMRMLAbstractDisplayableManager
+{
+public:
+  static vtkTestDisplayableManager* New();
+  vtkTypeMacro(vtkTestDisplayableManager, vtkMRMLAbstractDisplayableManager);
+
+  bool CanProcessInteractionEvent(vtkMRMLInteractionEventData* eventData, double& distance2) override
+  {
+    if (eventData->GetType() == vtkCommand::Move3DEvent)
+    {
+      ++this->NumberOfOfferedMove3DEvents;
+    }
+    distance2 = 0.0;
+    return this->CanProcess;
+  }
+  bool ProcessInteractionEvent(vtkMRMLInteractionEventData* vtkNotUsed(eventData)) override
+  {
+    return true;
+  }
+  void SetHasFocus(bool hasFocus, vtkMRMLInteractionEventData* eventData) override
+  {
+    this->Focused = hasFocus;
+    this->Superclass::SetHasFocus(hasFocus, eventData);
+  }
+
+  bool CanProcess{false};
+  bool Focused{false};
+  int NumberOfOfferedMove3DEvents{0};
+};
+vtkStandardNewMacro(vtkTestDisplayableManager);
+
+//----------------------------------------------------------------------------
+/// Second class, for subscriptions by class name
+class vtkTestDisplayableManager2 : public vtkTestDisplayableManager
+{
+public:
+  static vtkTestDisplayableManager2* New();
+  vtkTypeMacro(vtkTestDisplayableManager2, vtkTestDisplayableManager);
+};
+vtkStandardNewMacro(vtkTestDisplayableManager2);
+
+//----------------------------------------------------------------------------
+/// Give access to the delegation to subscribed displayable managers
+class vtkTestInteractorObserver : public vtkVirtualRealityViewInteractorObserver
+{
+public:
+  static vtkTestInteractorObserver* New();
+  vtkTypeMacro(vtkTestInteractorObserver, vtkVirtualRealityViewInteractorObserver);
+  using vtkVirtualRealityViewInteractorObserver::DelegateInteractionEventDataToSubscribedDisplayableManagers;
+  using vtkVirtualRealityViewInteractorObserver::GetSubscribedDisplayableManagers;
+  vtkMRMLAbstractDisplayableManager* GetFocusedDisplayableManager() { return this->FocusedDisplayableManager; }
+  void OnMove3D(vtkEventData* vtkNotUsed(eventData)) override { ++this->NumberOfStyleMove3DEvents; }
+
+  /// Number of Move3D events passed on to the interactor style
+  int NumberOfStyleMove3DEvents{0};
+};
+vtkStandardNewMacro(vtkTestInteractorObserver);
+
+//----------------------------------------------------------------------------
+void InvokeEvent(vtkRenderWindowInteractor* interactor, unsigned long event, vtkEventDataDevice device)
+{
+  vtkNew<vtkEventDataDevice3D> eventData;
+  eventData->SetType(event);
+  eventData->SetDevice(device);
+  interactor->InvokeEvent(event, eventData);
+}
+
+//----------------------------------------------------------------------------
+int TestMove3DEventCoalescing()
+{
+  const vtkEventDataDevice right = vtkEventDataDevice::RightController;
+  const vtkEventDataDevice left = vtkEventDataDevice::LeftController;
+
+  vtkNew<vtkRenderer> renderer;
+  vtkNew<vtkRenderWindow> renderWindow;
+  renderWindow->AddRenderer(renderer);
+  vtkNew<vtkRenderWindowInteractor> interactor;
+  vtkNew<vtkInteractorStyle> interactorStyle;
+  interactor->SetInteractorStyle(interactorStyle);
+  interactor->SetRenderWindow(renderWindow);
+
+  vtkNew<vtkMRMLDisplayableManagerGroup> group;
+  group->SetRenderer(renderer);
+  vtkNew<vtkTestDisplayableManager> displayableManager;
+  group->AddDisplayableManager(displayableManager);
+  vtkNew<vtkTestInteractorObserver> observer;
+  observer->SetInteractor(interactor);
+  observer->SetDisplayableManagers(group);
+  observer->UpdateDisplayableManagerSubscriptionTable();
+  CHECK_BOOL(observer->GetMove3DEventCoalescing(), true);
+
+  // Moves are delegated once when rendering starts. Displayable managers did not process the last
+  // moves, moves are processed by the interactor style without delay.
+  displayableManager->CanProcess = true;
+  InvokeEvent(interactor, vtkCommand::Move3DEvent, right);
+  InvokeEvent(interactor, vtkCommand::Move3DEvent, right);
+  InvokeEvent(interactor, vtkCommand::Move3DEvent, right);
+  CHECK_INT(displayableManager->NumberOfOfferedMove3DEvents, 0);
+  CHECK_INT(observer->NumberOfStyleMove3DEvents, 3);
+  CHECK_INT(observer->GetNumberOfCoalescedMove3DEvents(), 2);
+  renderWindow->InvokeEvent(vtkCommand::StartEvent);
+  CHECK_INT(displayableManager->NumberOfOfferedMove3DEvents, 1);
+  CHECK_INT(observer->NumberOfStyleMove3DEvents, 3);
+  // No pending move
+  renderWindow->InvokeEvent(vtkCommand::StartEvent);
+  CHECK_INT(displayableManager->NumberOfOfferedMove3DEvents, 1);
+
+  // Displayable managers processed the last move, moves are not processed by the interactor style.
+  // If displayable managers do not process the pending move, the interactor style processes it
+  // when it is delegated.
+  InvokeEvent(interactor, vtkCommand::Move3DEvent, right);
+  InvokeEvent(interactor, vtkCommand::Move3DEvent, right);
+  CHECK_INT(observer->NumberOfStyleMove3DEvents, 3);
+  CHECK_INT(observer->GetNumberOfCoalescedMove3DEvents(), 3);
+  displayableManager->CanProcess = false;
+  renderWindow->InvokeEvent(vtkCommand::StartEvent);
+  CHECK_INT(displayableManager->NumberOfOfferedMove3DEvents, 2);
+  CHECK_INT(observer->NumberOfStyleMove3DEvents, 4);
+
+  // Pending moves are delegated before any other event
+  InvokeEvent(interactor, vtkCommand::Move3DEvent, left);
+  CHECK_INT(displayableManager->NumberOfOfferedMove3DEvents, 2);
+  InvokeEvent(interactor, vtkCommand::Button3DEvent, left);
+  CHECK_INT(displayableManager->NumberOfOfferedMove3DEvents, 3);
+
+  // Full-rate requests only apply to the requested device
+  {
+    vtkNew<vtkObject> requester;
+    observer->AddFullRateMove3DEventRequester(requester, static_cast<int>(right));
+    CHECK_BOOL(observer->HasFullRateMove3DEventRequester(static_cast<int>(right)), true);
+    CHECK_BOOL(observer->HasFullRateMove3DEventRequester(static_cast<int>(left)), false);
+    InvokeEvent(interactor, vtkCommand::Move3DEvent, right);
+    CHECK_INT(displayableManager->NumberOfOfferedMove3DEvents, 4);
+    InvokeEvent(interactor, vtkCommand::Move3DEvent, left);
+    CHECK_INT(displayableManager->NumberOfOfferedMove3DEvents, 4);
+    renderWindow->InvokeEvent(vtkCommand::StartEvent);
+    CHECK_INT(displayableManager->NumberOfOfferedMove3DEvents, 5);
+
+    // Request for any device
+    vtkNew<vtkObject> requester2;
+    observer->AddFullRateMove3DEventRequester(requester2);
+    CHECK_BOOL(observer->HasFullRateMove3DEventRequester(static_cast<int>(left)), true);
+    observer->RemoveFullRateMove3DEventRequester(requester2);
+    CHECK_BOOL(observer->HasFullRateMove3DEventRequester(static_cast<int>(left)), false);
+    CHECK_BOOL(observer->HasFullRateMove3DEventRequester(static_cast<int>(right)), true);
+  }
+  // Deleted requesters are ignored
+  CHECK_BOOL(observer->HasFullRateMove3DEventRequester(static_cast<int>(right)), false);
+  InvokeEvent(interactor, vtkCommand::Move3DEvent, right);
+  CHECK_INT(displayableManager->NumberOfOfferedMove3DEvents, 5);
+
+  // Moves are delegated immediately when coalescing is disabled
+  observer->SetMove3DEventCoalescing(false);
+  InvokeEvent(interactor, vtkCommand::Move3DEvent, left);
+  CHECK_INT(displayableManager->NumberOfOfferedMove3DEvents, 7);
+
+  observer->SetInteractor(nullptr);
+  return EXIT_SUCCESS;
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+int vtkVirtualRealityViewInteractorObserverTest1(int , char * [])
+{
+  const int right = static_cast<int>(vtkEventDataDevice::RightController);
+  const int left = static_cast<int>(vtkEventDataDevice::LeftController);
+
+  vtkNew<vtkTestInteractorObserver> observer;
+
+  // Display-only displayable managers are not subscribed by default, other classes are subscribed to all events
+  CHECK_BOOL(observer->IsDisplayableManagerSubscribed("vtkMRMLModelDisplayableManager", vtkCommand::Button3DEvent, right), false);
+  CHECK_BOOL(observer->IsDisplayableManagerSubscribed("vtkMRMLVolumeRenderingDisplayableManager", vtkCommand::Move3DEvent, left), false);
+  CHECK_BOOL(observer->IsDisplayableManagerSubscribed("vtkMRMLMarkupsDisplayableManager", vtkCommand::Button3DEvent, right), true);
+  CHECK_BOOL(observer->IsDisplayableManagerSubscribed(nullptr, vtkCommand::Button3DEvent, right), false);
+
+  // Subscription to an event of a device, or of any device
+  const char* className = "vtkTestDisplayableManager2";
+  observer->AddDisplayableManagerSubscription(className, vtkCommand::Button3DEvent, right);
+  CHECK_BOOL(observer->IsDisplayableManagerSubscribed(className, vtkCommand::Button3DEvent, right), true);
+  CHECK_BOOL(observer->IsDisplayableManagerSubscribed(className, vtkCommand::Button3DEvent, left), false);
+  CHECK_BOOL(observer->IsDisplayableManagerSubscribed(className, vtkCommand::Move3DEvent, right), false);
+  observer->AddDisplayableManagerSubscription(className, vtkCommand::Move3DEvent);
+  CHECK_BOOL(observer->IsDisplayableManagerSubscribed(className, vtkCommand::Move3DEvent, left), true);
+  CHECK_BOOL(observer->IsDisplayableManagerSubscribed(className, vtkCommand::Select3DEvent, left), false);
+  observer->SetDisplayableManagerSubscribedToAllEvents(className);
+  CHECK_BOOL(observer->IsDisplayableManagerSubscribed(className, vtkCommand::Select3DEvent, left), true);
+  observer->RemoveAllDisplayableManagerSubscriptions(className);
+  CHECK_BOOL(observer->IsDisplayableManagerSubscribed(className, vtkCommand::Button3DEvent, right), false);
+  observer->AddDisplayableManagerSubscription(className, vtkCommand::Button3DEvent, right);
+
+  // Table lists the subscribed displayable managers of the group
+  vtkNew<vtkRenderer> renderer;
+  vtkNew<vtkMRMLDisplayableManagerGroup> group;
+  group->SetRenderer(renderer);
+  vtkNew<vtkTestDisplayableManager> displayableManager;
+  vtkNew<vtkTestDisplayableManager2> displayableManager2;
+  group->AddDisplayableManager(displayableManager);
+  group->AddDisplayableManager(displayableManager2);
+  observer->SetDisplayableManagers(group);
+  CHECK_INT(observer->GetNumberOfSubscribedDisplayableManagers(vtkCommand::Button3DEvent, right), 0);
+  observer->UpdateDisplayableManagerSubscriptionTable();
+  CHECK_INT(observer->GetNumberOfSubscribedDisplayableManagers(vtkCommand::Button3DEvent, right), 2);
+  CHECK_INT(observer->GetNumberOfSubscribedDisplayableManagers(vtkCommand::Button3DEvent, left), 1);
+  CHECK_INT(observer->GetNumberOfSubscribedDisplayableManagers(vtkCommand::Move3DEvent, left), 1);
+  CHECK_POINTER(observer->GetSubscribedDisplayableManagers(vtkCommand::Move3DEvent, left)[0].GetPointer(),
+    displayableManager.GetPointer());
+
+  // Subscriptions are applied when the table is updated
+  observer->RemoveAllDisplayableManagerSubscriptions("vtkTestDisplayableManager");
+  CHECK_INT(observer->GetNumberOfSubscribedDisplayableManagers(vtkCommand::Button3DEvent, right), 2);
+  observer->UpdateDisplayableManagerSubscriptionTable();
+  CHECK_INT(observer->GetNumberOfSubscribedDisplayableManagers(vtkCommand::Button3DEvent, right), 1);
+  CHECK_INT(observer->GetNumberOfSubscribedDisplayableManagers(vtkCommand::Move3DEvent, left), 0);
+  observer->SetDisplayableManagerSubscribedToAllEvents("vtkTestDisplayableManager");
+  observer->UpdateDisplayableManagerSubscriptionTable();
+
+  // Only subscribed displayable managers get the focus
+  vtkNew<vtkMRMLInteractionEventData> eventData;
+  eventData->SetType(vtkCommand::Button3DEvent);
+  eventData->SetDevice(vtkEventDataDevice::LeftController);
+  CHECK_BOOL(observer->DelegateInteractionEventDataToSubscribedDisplayableManagers(eventData), false);
+  displayableManager2->CanProcess = true;
+  CHECK_BOOL(observer->DelegateInteractionEventDataToSubscribedDisplayableManagers(eventData), false);
+  displayableManager->CanProcess = true;
+  CHECK_BOOL(observer->DelegateInteractionEventDataToSubscribedDisplayableManagers(eventData), true);
+  CHECK_POINTER(observer->GetFocusedDisplayableManager(), displayableManager.GetPointer());
+  CHECK_BOOL(displayableManager->Focused, true);
+  CHECK_BOOL(displayableManager2->Focused, false);
+
+  // Focus is lost when no displayable manager can process the event
+  displayableManager->CanProcess = false;
+  CHECK_BOOL(observer->DelegateInteractionEventDataToSubscribedDisplayableManagers(eventData), false);
+  CHECK_NULL(observer->GetFocusedDisplayableManager());
+  CHECK_BOOL(displayableManager->Focused, false);
+
+  CHECK_EXIT_SUCCESS(TestMove3DEventCoalescing());
+
+  return EXIT_SUCCESS;
+}
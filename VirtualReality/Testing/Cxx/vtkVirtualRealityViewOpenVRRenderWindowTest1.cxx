@@ -0,0 +1,84 @@
+
+// VirtualReality MRMLDM includes
+#include <vtkVirtualRealityViewOpenVRRenderWindow.h>
+
+// MRML includes
+#include <vtkMRMLCoreTestingMacros.h>
+
+// VTK includes
+#include <vtkNew.h>
+#include <vtkObjectFactory.h>
+
+// STD includes
+#include <chrono>
+#include <thread>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+/// Give access to the lock held while a frame is rendered
+class vtkTestOpenVRRenderWindow : public vtkVirtualRealityViewOpenVRRenderWindow
+{
+public:
+  static vtkTestOpenVRRenderWindow* New();
+  vtkTypeMacro(vtkTestOpenVRRenderWindow, vtkVirtualRealityViewOpenVRRenderWindow);
+  std::mutex& GetFrameMutex() { return this->FrameMutex; }
+  void SetRenderRequested(bool requested) { this->RenderRequested = requested; }
+};
+vtkStandardNewMacro(vtkTestOpenVRRenderWindow);
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+int vtkVirtualRealityViewOpenVRRenderWindowTest1(int , char * [])
+{
+  // Render window is not initialized (no headset), the keep-alive thread runs without submitting frames
+  vtkNew<vtkTestOpenVRRenderWindow> renderWindow;
+  renderWindow->SetKeepAliveTimeout(0.02);
+  CHECK_BOOL(renderWindow->IsKeepAliveSubmissionRunning(), false);
+
+  renderWindow->StartKeepAliveSubmission();
+  CHECK_BOOL(renderWindow->IsKeepAliveSubmissionRunning(), true);
+  // Starting again has no effect
+  renderWindow->StartKeepAliveSubmission();
+  CHECK_BOOL(renderWindow->IsKeepAliveSubmissionRunning(), true);
+
+  // No frame is rendered, the render loop is stalled
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  CHECK_BOOL(renderWindow->GetNumberOfKeepAliveFrames() > 0, true);
+
+  // No keep-alive frame while a frame is rendered
+  {
+    std::lock_guard<std::mutex> frameLock(renderWindow->GetFrameMutex());
+    int numberOfKeepAliveFrames = renderWindow->GetNumberOfKeepAliveFrames();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    CHECK_INT(renderWindow->GetNumberOfKeepAliveFrames(), numberOfKeepAliveFrames);
+  }
+
+  // No keep-alive frame while the render loop waits to render a frame
+  {
+    renderWindow->SetRenderRequested(true);
+    int numberOfKeepAliveFrames = renderWindow->GetNumberOfKeepAliveFrames();
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    CHECK_INT(renderWindow->GetNumberOfKeepAliveFrames(), numberOfKeepAliveFrames);
+    renderWindow->SetRenderRequested(false);
+  }
+
+  renderWindow->StopKeepAliveSubmission();
+  CHECK_BOOL(renderWindow->IsKeepAliveSubmissionRunning(), false);
+  int numberOfKeepAliveFrames = renderWindow->GetNumberOfKeepAliveFrames();
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  CHECK_INT(renderWindow->GetNumberOfKeepAliveFrames(), numberOfKeepAliveFrames);
+  // Stopping again has no effect
+  renderWindow->StopKeepAliveSubmission();
+
+  // Restarting resets the number of frames, thread is stopped when the window is finalized
+  renderWindow->SetKeepAliveTimeout(10.0);
+  renderWindow->StartKeepAliveSubmission();
+  CHECK_INT(renderWindow->GetNumberOfKeepAliveFrames(), 0);
+  renderWindow->Finalize();
+  CHECK_BOOL(renderWindow->IsKeepAliveSubmissionRunning(), false);
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,169 @@
+
+// VirtualReality MRML includes
+#include <vtkMRMLVirtualRealityViewNode.h>
+
+// VirtualReality MRMLDM includes
+#include <vtkVirtualRealityVisiblePropBoundsCache.h>
+
+// MRML includes
+#include <vtkMRMLCoreTestingMacros.h>
+#include <vtkMRMLLinearTransformNode.h>
+#include <vtkMRMLModelDisplayNode.h>
+#include <vtkMRMLModelNode.h>
+#include <vtkMRMLScene.h>
+
+// VTK includes
+#include <vtkCubeSource.h>
+#include <vtkMatrix4x4.h>
+#include <vtkNew.h>
+
+// STD includes
+#include <vector>
+
+namespace
+{
+
+//----------------------------------------------------------------------------
+vtkMRMLModelNode* AddCubeModel(vtkMRMLScene* scene, double center[3])
+{
+  vtkNew<vtkCubeSource> cube;
+  cube->SetCenter(center);
+  cube->SetXLength(2.0);
+  cube->SetYLength(2.0);
+  cube->SetZLength(2.0);
+  cube->Update();
+  vtkMRMLModelNode* modelNode = vtkMRMLModelNode::SafeDownCast(scene->AddNewNodeByClass("vtkMRMLModelNode"));
+  modelNode->SetAndObservePolyData(cube->GetOutput());
+  modelNode->CreateDefaultDisplayNodes();
+  return modelNode;
+}
+
+//----------------------------------------------------------------------------
+bool CheckBounds(vtkVirtualRealityVisiblePropBoundsCache* cache, double xMin, double xMax)
+{
+  double bounds[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+  if (!cache->GetBounds(bounds))
+  {
+    std::cerr << "Bounds are not valid" << std::endl;
+    return false;
+  }
+  if (bounds[0] != xMin || bounds[1] != xMax || bounds[2] != -1.0 || bounds[3] != 1.0)
+  {
+    std::cerr << "Unexpected bounds: " << bounds[0] << " " << bounds[1] << " " << bounds[2] << " " << bounds[3]
+              << ", expected: " << xMin << " " << xMax << " -1 1" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+} // end of anonymous namespace
+
+//----------------------------------------------------------------------------
+int vtkVirtualRealityVisiblePropBoundsCacheTest1(int , char * [])
+{
+  vtkNew<vtkMRMLScene> scene;
+  vtkNew<vtkMRMLVirtualRealityViewNode> viewNode;
+  scene->AddNode(viewNode);
+
+  double center1[3] = { 0.0, 0.0, 0.0 };
+  vtkMRMLModelNode* modelNode1 = AddCubeModel(scene, center1);
+
+  vtkNew<vtkVirtualRealityVisiblePropBoundsCache> cache;
+  double bounds[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+  CHECK_BOOL(cache->GetBounds(bounds), false);
+
+  // Existing nodes are added when the view node is set
+  cache->SetViewNode(viewNode);
+  CHECK_INT(cache->GetNumberOfNodes(), 1);
+  CHECK_BOOL(CheckBounds(cache, -1.0, 1.0), true);
+  CHECK_INT(cache->GetNumberOfInvalidatedNodes(), 0);
+
+  // Nodes added to the scene are observed
+  double center2[3] = { 10.0, 0.0, 0.0 };
+  vtkMRMLModelNode* modelNode2 = AddCubeModel(scene, center2);
+  CHECK_INT(cache->GetNumberOfNodes(), 2);
+  CHECK_BOOL(CheckBounds(cache, -1.0, 11.0), true);
+
+  // Bounds are unchanged and nothing is recomputed if no node is modified
+  CHECK_BOOL(CheckBounds(cache, -1.0, 11.0), true);
+  CHECK_INT(cache->GetNumberOfInvalidatedNodes(), 0);
+
+  // Only the transformed node is invalidated
+  vtkMRMLLinearTransformNode* transformNode = vtkMRMLLinearTransformNode::SafeDownCast(
+    scene->AddNewNodeByClass("vtkMRMLLinearTransformNode"));
+  modelNode2->SetAndObserveTransformNodeID(transformNode->GetID());
+  cache->GetBounds(bounds);
+  vtkNew<vtkMatrix4x4> matrix;
+  matrix->SetElement(0, 3, 5.0);
+  transformNode->SetMatrixTransformToParent(matrix);
+  CHECK_INT(cache->GetNumberOfInvalidatedNodes(), 1);
+  CHECK_BOOL(CheckBounds(cache, -1.0, 16.0), true);
+
+  // Moving a node back shrinks the bounds
+  matrix->SetElement(0, 3, -5.0);
+  transformNode->SetMatrixTransformToParent(matrix);
+  CHECK_BOOL(CheckBounds(cache, -1.0, 6.0), true);
+
+  // Hidden nodes are ignored
+  modelNode1->GetDisplayNode()->SetVisibility(false);
+  CHECK_BOOL(CheckBounds(cache, 4.0, 6.0), true);
+  modelNode1->GetDisplayNode()->SetVisibility(true);
+  modelNode1->GetDisplayNode()->SetVisibility3D(false);
+  CHECK_BOOL(CheckBounds(cache, 4.0, 6.0), true);
+  modelNode1->GetDisplayNode()->SetVisibility3D(true);
+  CHECK_BOOL(CheckBounds(cache, -1.0, 6.0), true);
+
+  // Nodes not displayable in the view are ignored
+  vtkNew<vtkMRMLVirtualRealityViewNode> otherViewNode;
+  scene->AddNode(otherViewNode);
+  modelNode2->GetDisplayNode()->SetViewNodeIDs({ otherViewNode->GetID() });
+  CHECK_BOOL(CheckBounds(cache, -1.0, 1.0), true);
+  modelNode2->GetDisplayNode()->RemoveAllViewNodeIDs();
+  CHECK_BOOL(CheckBounds(cache, -1.0, 6.0), true);
+
+  // Selectable nodes are found from their bounds
+  std::vector<vtkMRMLDisplayableNode*> candidateNodes;
+  double point[3] = { 5.0, 0.0, 0.0 };
+  cache->FindSelectableNodesAtPoint(point, 0.0, candidateNodes);
+  CHECK_INT(static_cast<int>(candidateNodes.size()), 1);
+  CHECK_POINTER(candidateNodes[0], modelNode2);
+  point[0] = 2.5;
+  cache->FindSelectableNodesAtPoint(point, 0.0, candidateNodes);
+  CHECK_INT(static_cast<int>(candidateNodes.size()), 0);
+  cache->FindSelectableNodesAtPoint(point, 1.5, candidateNodes);
+  CHECK_INT(static_cast<int>(candidateNodes.size()), 2);
+  modelNode2->SetSelectable(false);
+  point[0] = 5.0;
+  cache->FindSelectableNodesAtPoint(point, 0.0, candidateNodes);
+  CHECK_INT(static_cast<int>(candidateNodes.size()), 0);
+  modelNode2->SetSelectable(true);
+  cache->FindSelectableNodesAtPoint(point, 0.0, candidateNodes);
+  CHECK_INT(static_cast<int>(candidateNodes.size()), 1);
+
+  // Hierarchy is refitted when a node is transformed
+  matrix->SetElement(0, 3, 0.0);
+  transformNode->SetMatrixTransformToParent(matrix);
+  cache->FindSelectableNodesAtPoint(point, 0.0, candidateNodes);
+  CHECK_INT(static_cast<int>(candidateNodes.size()), 0);
+  point[0] = 10.0;
+  cache->FindSelectableNodesAtPoint(point, 0.0, candidateNodes);
+  CHECK_INT(static_cast<int>(candidateNodes.size()), 1);
+  CHECK_POINTER(candidateNodes[0], modelNode2);
+  CHECK_BOOL(CheckBounds(cache, -1.0, 11.0), true);
+
+  // Removed nodes are no longer observed
+  scene->RemoveNode(modelNode2);
+  CHECK_INT(cache->GetNumberOfNodes(), 1);
+  CHECK_BOOL(CheckBounds(cache, -1.0, 1.0), true);
+
+  scene->RemoveNode(modelNode1);
+  CHECK_INT(cache->GetNumberOfNodes(), 0);
+  CHECK_BOOL(cache->GetBounds(bounds), false);
+
+  // Scene is no longer observed after the view node is unset
+  cache->SetViewNode(nullptr);
+  AddCubeModel(scene, center1);
+  CHECK_INT(cache->GetNumberOfNodes(), 0);
+
+  return EXIT_SUCCESS;
+}
@@ -26,6 +26,7 @@
 #include <QDebug>
 #include <QIcon>
 #include <QPushButton>
+#include <QTimer>
 
 // MRML includes
 #include <vtkMRMLLinearTransformNode.h>
@@ -34,52 +35,6 @@
 #include <vtkEventData.h>
 
 
-namespace
-{
-  // Copied from https://github.com/ValveSoftware/openvr/blob/v2.0.10/headers/openvr.h
-  enum ETrackingResult
-  {
-    TrackingResult_Uninitialized = 1,
-
-    TrackingResult_Calibrating_InProgress	= 100,
-    TrackingResult_Calibrating_OutOfRange	= 101,
-
-    TrackingResult_Running_OK = 200,
-    TrackingResult_Running_OutOfRange = 201,
-
-    TrackingResult_Fallback_RotationOnly = 300,
-  };
-
-  ::ETrackingResult StringToPoseStatus(const char* cpose)
-  {
-    if (cpose == nullptr)
-    {
-      return ::TrackingResult_Uninitialized;
-    }
-    std::string pose(cpose);
-
-    if (pose.compare("CalibratingInProgress") == 0)
-    {
-      return ::TrackingResult_Calibrating_InProgress;
-    }
-    else if (pose.compare("CalibratingOutOfRange") == 0)
-    {
-      return ::TrackingResult_Calibrating_OutOfRange;
-    }
-    else if (pose.compare("RunningOk") == 0)
-    {
-      return ::TrackingResult_Running_OK;
-    }
-    else if (pose.compare("RunningOutOfRange") == 0)
-    {
-      return ::TrackingResult_Running_OutOfRange;
-    }
-    else
-    {
-      return ::TrackingResult_Uninitialized;
-    }
-  }
-}
 //-----------------------------------------------------------------------------
 class qMRMLVirtualRealityTransformWidgetPrivate
   : public Ui_qMRMLVirtualRealityTransformWidget
@@ -94,7 +49,10 @@ public:
   vtkWeakPointer<vtkMRMLVirtualRealityViewNode> VRViewNode;
   vtkWeakPointer<vtkMRMLLinearTransformNode>    TransformNode;
   vtkEventDataDevice                            TransformType;
-  ::ETrackingResult                             PreviousStatus;
+  uint32_t                                      DeviceHandle;
+  int                                           PreviousStatus;
+  bool                                          PreviousTransformUpdate;
+  QTimer                                        RefreshTimer;
 };
 
 //-----------------------------------------------------------------------------
@@ -106,7 +64,9 @@ qMRMLVirtualRealityTransformWidgetPrivate::qMRMLVirtualRealityTransformWidgetPri
   , VRViewNode(nullptr)
   , TransformNode(nullptr)
   , TransformType(vtkEventDataDevice::Unknown)
-  , PreviousStatus(::TrackingResult_Uninitialized)
+  , DeviceHandle(0)
+  , PreviousStatus(-1)
+  , PreviousTransformUpdate(false)
 {
 
 }
@@ -119,6 +79,10 @@ void qMRMLVirtualRealityTransformWidgetPrivate::init()
 
   QObject::connect(this->pushButton_Transform, &QPushButton::clicked, q, &qMRMLVirtualRealityTransformWidget::onButtonClicked);
 
+  this->RefreshTimer.setSingleShot(true);
+  this->RefreshTimer.setInterval(200);
+  QObject::connect(&this->RefreshTimer, SIGNAL(timeout()), q, SLOT(updateWidgetFromMRML()));
+
   q->updateWidgetFromMRML();
 }
 
@@ -133,6 +97,14 @@ qMRMLVirtualRealityTransformWidget::qMRMLVirtualRealityTransformWidget(vtkMRMLVi
   Q_D(qMRMLVirtualRealityTransformWidget);
 
   d->VRViewNode = viewNode;
+  if (d->VRViewNode != nullptr)
+  {
+    // Icon depends on the device status and on the transform update flags of the view node
+    qvtkConnect(d->VRViewNode, vtkMRMLVirtualRealityViewNode::DeviceStatusModifiedEvent,
+                this, SLOT(scheduleUpdateWidgetFromMRML()));
+    qvtkConnect(d->VRViewNode, vtkCommand::ModifiedEvent,
+                this, SLOT(scheduleUpdateWidgetFromMRML()));
+  }
 
   Q_INIT_RESOURCE(qMRMLVirtualRealityTransformWidget);
 
@@ -161,9 +133,6 @@ void qMRMLVirtualRealityTransformWidget::setMRMLLinearTransformNode(vtkMRMLLinea
     return;
   }
 
-  qvtkReconnect(d->TransformNode, node, vtkCommand::ModifiedEvent,
-                this, SLOT(updateWidgetFromMRML()));
-
   // decipher correct type of images to load/show
   std::string name = std::string(d->TransformNode->GetName());
   if (name.find("VirtualReality") != std::string::npos && name.find("Controller") != std::string::npos)
@@ -193,9 +162,56 @@ void qMRMLVirtualRealityTransformWidget::setMRMLLinearTransformNode(vtkMRMLLinea
     qCritical() << "Non-VR transform sent to VRTransformWidget";
   }
 
+  // Identify the device reporting the status displayed by the widget
+  d->DeviceHandle = 0;
+  if (d->VRViewNode != nullptr)
+  {
+    if (d->TransformType == vtkEventDataDevice::LeftController
+        && d->VRViewNode->GetRightControllerTransformNode() == d->TransformNode)
+    {
+      d->TransformType = vtkEventDataDevice::RightController;
+    }
+    else if (d->TransformType == vtkEventDataDevice::GenericTracker)
+    {
+      d->DeviceHandle = d->VRViewNode->GetTrackerTransformNodeDeviceHandle(d->TransformNode);
+    }
+  }
+  d->PreviousStatus = -1;
+
   this->updateWidgetFromMRML();
 }
 
+//-----------------------------------------------------------------------------
+vtkMRMLLinearTransformNode* qMRMLVirtualRealityTransformWidget::mrmlLinearTransformNode() const
+{
+  Q_D(const qMRMLVirtualRealityTransformWidget);
+  return d->TransformNode;
+}
+
+//-----------------------------------------------------------------------------
+int qMRMLVirtualRealityTransformWidget::refreshInterval() const
+{
+  Q_D(const qMRMLVirtualRealityTransformWidget);
+  return d->RefreshTimer.interval();
+}
+
+//-----------------------------------------------------------------------------
+void qMRMLVirtualRealityTransformWidget::setRefreshInterval(int interval)
+{
+  Q_D(qMRMLVirtualRealityTransformWidget);
+  d->RefreshTimer.setInterval(interval);
+}
+
+//-----------------------------------------------------------------------------
+void qMRMLVirtualRealityTransformWidget::scheduleUpdateWidgetFromMRML()
+{
+  Q_D(qMRMLVirtualRealityTransformWidget);
+  if (!d->RefreshTimer.isActive())
+  {
+    d->RefreshTimer.start();
+  }
+}
+
 //----------------------------------------------------------------------------
 void qMRMLVirtualRealityTransformWidget::onButtonClicked()
 {
@@ -249,17 +265,32 @@ void qMRMLVirtualRealityTransformWidget::updateWidgetFromMRML()
     d->pushButton_Transform->setEnabled(true);
   }
 
-  ::ETrackingResult status = StringToPoseStatus(d->TransformNode->GetAttribute("VirtualReality.PoseStatus"));
-  if (d->PreviousStatus == status)
+  if (d->VRViewNode == nullptr)
   {
-    // No change
     return;
   }
 
-  if (d->VRViewNode == nullptr)
+  int status = d->VRViewNode->GetDeviceTrackingResult(d->TransformType, d->DeviceHandle);
+  bool transformUpdate = false;
+  switch (d->TransformType)
+  {
+    case vtkEventDataDevice::HeadMountedDisplay:
+      transformUpdate = d->VRViewNode->GetHMDTransformUpdate();
+      break;
+    case vtkEventDataDevice::GenericTracker:
+      transformUpdate = d->VRViewNode->GetTrackerTransformUpdate();
+      break;
+    default:
+      transformUpdate = d->VRViewNode->GetControllerTransformsUpdate();
+      break;
+  }
+  if (d->PreviousStatus == status && d->PreviousTransformUpdate == transformUpdate)
   {
+    // No change
     return;
   }
+  d->PreviousStatus = status;
+  d->PreviousTransformUpdate = transformUpdate;
 
   // Choose correct icon based on node attributes
   switch (d->TransformType)
@@ -273,19 +304,19 @@ void qMRMLVirtualRealityTransformWidget::updateWidgetFromMRML()
         }
         switch (status)
         {
-          case ::TrackingResult_Running_OK:
+          case vtkMRMLVirtualRealityViewNode::TrackingResultRunningOK:
             d->pushButton_Transform->setIcon(QIcon(":/Icons/headset_status_ready.png"));
 
             break;
-          case ::TrackingResult_Running_OutOfRange:
+          case vtkMRMLVirtualRealityViewNode::TrackingResultRunningOutOfRange:
             d->pushButton_Transform->setIcon(QIcon(":/Icons/headset_status_range.png"));
 
             break;
-          case ::TrackingResult_Calibrating_InProgress:
+          case vtkMRMLVirtualRealityViewNode::TrackingResultCalibratingInProgress:
             d->pushButton_Transform->setIcon(QIcon(":/Icons/headset_status_alert.png"));
 
             break;
-          case ::TrackingResult_Calibrating_OutOfRange:
+          case vtkMRMLVirtualRealityViewNode::TrackingResultCalibratingOutOfRange:
             d->pushButton_Transform->setIcon(QIcon(":/Icons/headset_status_range.png"));
             break;
           default:
@@ -302,19 +333,19 @@ void qMRMLVirtualRealityTransformWidget::updateWidgetFromMRML()
         }
         switch (status)
         {
-          case ::TrackingResult_Running_OK:
+          case vtkMRMLVirtualRealityViewNode::TrackingResultRunningOK:
             d->pushButton_Transform->setIcon(QIcon(":/Icons/tracker_status_ready.png"));
 
             break;
-          case ::TrackingResult_Running_OutOfRange:
+          case vtkMRMLVirtualRealityViewNode::TrackingResultRunningOutOfRange:
             d->pushButton_Transform->setIcon(QIcon(":/Icons/tracker_status_range.png"));
 
             break;
-          case ::TrackingResult_Calibrating_InProgress:
+          case vtkMRMLVirtualRealityViewNode::TrackingResultCalibratingInProgress:
             d->pushButton_Transform->setIcon(QIcon(":/Icons/tracker_status_alert.png"));
 
             break;
-          case ::TrackingResult_Calibrating_OutOfRange:
+          case vtkMRMLVirtualRealityViewNode::TrackingResultCalibratingOutOfRange:
             d->pushButton_Transform->setIcon(QIcon(":/Icons/tracker_status_range.png"));
 
             break;
@@ -335,19 +366,19 @@ void qMRMLVirtualRealityTransformWidget::updateWidgetFromMRML()
         }
         switch (status)
         {
-          case ::TrackingResult_Running_OK:
+          case vtkMRMLVirtualRealityViewNode::TrackingResultRunningOK:
             d->pushButton_Transform->setIcon(QIcon(":/Icons/controller_status_ready.png"));
 
             break;
-          case ::TrackingResult_Running_OutOfRange:
+          case vtkMRMLVirtualRealityViewNode::TrackingResultRunningOutOfRange:
             d->pushButton_Transform->setIcon(QIcon(":/Icons/controller_status_range.png"));
 
             break;
-          case ::TrackingResult_Calibrating_InProgress:
+          case vtkMRMLVirtualRealityViewNode::TrackingResultCalibratingInProgress:
             d->pushButton_Transform->setIcon(QIcon(":/Icons/controller_status_alert.png"));
 
             break;
-          case ::TrackingResult_Calibrating_OutOfRange:
+          case vtkMRMLVirtualRealityViewNode::TrackingResultCalibratingOutOfRange:
             d->pushButton_Transform->setIcon(QIcon(":/Icons/controller_status_range.png"));
 
             break;
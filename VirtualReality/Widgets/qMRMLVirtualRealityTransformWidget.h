@@ -48,6 +48,14 @@ public:
   qMRMLVirtualRealityTransformWidget(vtkMRMLVirtualRealityViewNode* viewNode, QWidget* newParent = nullptr);
   ~qMRMLVirtualRealityTransformWidget() override;
 
+  vtkMRMLLinearTransformNode* mrmlLinearTransformNode() const;
+
+  /// Interval between icon refreshes, in milliseconds.
+  /// Device statuses may be modified at the headset frame rate, the icon is refreshed
+  /// at most once per interval. Default is 200 ms (5 Hz).
+  int refreshInterval() const;
+  void setRefreshInterval(int interval);
+
 public slots:
   void setMRMLLinearTransformNode(vtkMRMLLinearTransformNode* node);
   void setMRMLLinearTransformNode(vtkMRMLNode* node);
@@ -56,6 +64,9 @@ public slots:
 protected slots:
   void updateWidgetFromMRML();
 
+  /// Schedule an icon refresh, if none is scheduled already.
+  void scheduleUpdateWidgetFromMRML();
+
 protected:
   QScopedPointer<qMRMLVirtualRealityTransformWidgetPrivate> d_ptr;
 
@@ -31,6 +31,11 @@
 
 // VR Logic includes
 #include "vtkSlicerVirtualRealityLogic.h"
+#include "vtkVirtualRealityAdaptiveQualityController.h"
+#include "vtkVirtualRealityFramePacer.h"
+#include "vtkVirtualRealityFrameTimingLog.h"
+#include "vtkVirtualRealityInputEventQueue.h"
+#include "vtkVirtualRealityPoseTraceWriter.h"
 
 // VR MRML includes
 #include "vtkMRMLVirtualRealityViewNode.h"
@@ -38,6 +43,12 @@
 // VR MRMLDM includes
 #include "vtkVirtualRealityViewInteractorObserver.h"
 #include "vtkVirtualRealityViewInteractorStyleDelegate.h"
+#include "vtkVirtualRealityPoseTracePlayer.h"
+#include "vtkVirtualRealitySimulatedCamera.h"
+#include "vtkVirtualRealitySimulatedRenderer.h"
+#include "vtkVirtualRealitySimulatedRenderWindow.h"
+#include "vtkVirtualRealityViewSimulatedInteractor.h"
+#include "vtkVirtualRealityViewSimulatedInteractorStyle.h"
 #if defined(SlicerVirtualReality_HAS_OPENVR_SUPPORT)
 #include "vtkVirtualRealityViewOpenVRInteractor.h"
 #include "vtkVirtualRealityViewOpenVRInteractorStyle.h"
@@ -67,7 +78,10 @@
 #include <ctkPimpl.h> // For CTK_GET_CPP, CTK_SET_CPP
 
 // Slicer includes
+#include <qMRMLThreeDView.h>
+#include <qMRMLThreeDWidget.h>
 #include <qSlicerApplication.h>
+#include <qSlicerLayoutManager.h>
 #include <vtkSlicerCamerasModuleLogic.h>
 
 // MRMLDisplayableManager includes
@@ -81,6 +95,9 @@
 #include <vtkMRMLScene.h>
 
 #if defined(SlicerVirtualReality_HAS_OPENVR_SUPPORT)
+// VR MRMLDM includes
+#include "vtkVirtualRealityViewOpenVRRenderWindow.h"
+
 // VTK Rendering/OpenVR includes
 #include <vtkOpenVRCamera.h>
 #include <vtkOpenVRModel.h>
@@ -116,34 +133,112 @@
 #include <vtkCullerCollection.h>
 #include <vtkLight.h>
 #include <vtkLightCollection.h>
+#include <vtkMatrix4x4.h>
 #include <vtkNew.h>
 #include <vtkOpenGLFramebufferObject.h>
+#include <vtkOpenGLRenderWindow.h>
 #include <vtkPolyDataMapper.h>
+#include <vtkPropCollection.h>
 #include <vtkRenderer.h>
 #include <vtkRendererCollection.h>
 #include <vtkSmartPointer.h>
 #include <vtkTimerLog.h>
-#include <vtkTransform.h>
+#if __has_include(<vtk_glad.h>)
+#include <vtk_glad.h>
+#else
+#include <vtk_glew.h>
+#endif
+
+// STD includes
+#include <algorithm>
+#include <memory>
+#include <thread>
 
 namespace
 {
+  /// Initialization of the XR backend is attempted up to this number of times
+  const int MaximumNumberOfInitializationAttempts = 4;
+  /// Delay before retrying a failed initialization (in ms), doubled after each failed attempt
+  const int InitializationRetryMinimumDelay = 500;
+  const int InitializationRetryMaximumDelay = 4000;
+  /// Interval for checking if initialization stages running in the background completed (in ms)
+  const int InitializationPollingInterval = 50;
+  /// Input events are only emitted if the next frame is due in more than this time (in s)
+  const double InputEventProcessingMinimumTime = 0.001;
+
+  //--------------------------------------------------------------------------
+  /// Return true if a buffer created in the OpenGL context of the first window exists in the
+  /// context of the second one. Bindings are restored so that the state cached by VTK stays valid.
+  bool IsOpenGLContextShared(vtkOpenGLRenderWindow* renderWindow, vtkOpenGLRenderWindow* otherRenderWindow)
+  {
+    // Size identifies the buffer, names are only unique within a context
+    const GLsizeiptr bufferSize = 1237;
+    renderWindow->MakeCurrent();
+    GLuint buffer = 0;
+    glGenBuffers(1, &buffer);
+    GLint previousBuffer = 0;
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &previousBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glBufferData(GL_ARRAY_BUFFER, bufferSize, nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, static_cast<GLuint>(previousBuffer));
+    glFinish();
+
+    bool shared = false;
+    otherRenderWindow->MakeCurrent();
+    if (glIsBuffer(buffer))
+    {
+      glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &previousBuffer);
+      glBindBuffer(GL_ARRAY_BUFFER, buffer);
+      GLint size = 0;
+      glGetBufferParameteriv(GL_ARRAY_BUFFER, GL_BUFFER_SIZE, &size);
+      glBindBuffer(GL_ARRAY_BUFFER, static_cast<GLuint>(previousBuffer));
+      shared = (size == bufferSize);
+    }
+
+    renderWindow->MakeCurrent();
+    glDeleteBuffers(1, &buffer);
+    otherRenderWindow->MakeCurrent();
+    return shared;
+  }
+
 #if defined(SlicerVirtualReality_HAS_OPENVR_SUPPORT)
   //--------------------------------------------------------------------------
-  std::string PoseStatusToString(vr::ETrackingResult result)
+  /// Check that a headset is present and start the OpenVR runtime server if \a startRuntime is set,
+  /// which takes several seconds if SteamVR is not running. Run in a background thread.
+  void CheckOpenVRRuntime(std::shared_ptr<qMRMLVirtualRealityViewPrivate::RuntimeCheckState> state, bool startRuntime)
+  {
+    bool hmdPresent = vr::VR_IsHmdPresent();
+    if (hmdPresent && startRuntime)
+    {
+      // Utility applications connect to the runtime server without loading drivers, the session
+      // of the render window then does not have to wait for the server to start
+      vr::EVRInitError error = vr::VRInitError_None;
+      vr::VR_Init(&error, vr::VRApplication_Utility);
+      if (error == vr::VRInitError_None)
+      {
+        vr::VR_Shutdown();
+      }
+    }
+    state->HMDPresent = hmdPresent;
+    state->Completed = true;
+  }
+
+  //--------------------------------------------------------------------------
+  int TrackingResultFromOpenVR(vr::ETrackingResult result)
   {
     switch (result)
     {
       case vr::TrackingResult_Calibrating_InProgress:
-        return "CalibratingInProgress";
+        return vtkMRMLVirtualRealityViewNode::TrackingResultCalibratingInProgress;
       case vr::TrackingResult_Calibrating_OutOfRange:
-        return "CalibratingOutOfRange";
+        return vtkMRMLVirtualRealityViewNode::TrackingResultCalibratingOutOfRange;
       case vr::TrackingResult_Running_OK:
-        return "RunningOk";
+        return vtkMRMLVirtualRealityViewNode::TrackingResultRunningOK;
       case vr::TrackingResult_Running_OutOfRange:
-        return "RunningOutOfRange";
+        return vtkMRMLVirtualRealityViewNode::TrackingResultRunningOutOfRange;
       case vr::TrackingResult_Uninitialized:
       default:
-        return "Uninitialized";
+        return vtkMRMLVirtualRealityViewNode::TrackingResultUninitialized;
     }
   }
 #endif
@@ -168,7 +263,28 @@ qMRMLVirtualRealityViewPrivate::~qMRMLVirtualRealityViewPrivate()
 //---------------------------------------------------------------------------
 void qMRMLVirtualRealityViewPrivate::init()
 {
+  this->FramePacer = vtkSmartPointer<vtkVirtualRealityFramePacer>::New();
+  this->FrameTimingLog = vtkSmartPointer<vtkVirtualRealityFrameTimingLog>::New();
+  this->AdaptiveQualityController = vtkSmartPointer<vtkVirtualRealityAdaptiveQualityController>::New();
+  this->RenderScaleController = vtkSmartPointer<vtkVirtualRealityAdaptiveQualityController>::New();
+  this->PoseTraceWriter = vtkSmartPointer<vtkVirtualRealityPoseTraceWriter>::New();
+  this->PoseTracePlayer = vtkSmartPointer<vtkVirtualRealityPoseTracePlayer>::New();
+  this->PoseTraceMatrix = vtkSmartPointer<vtkMatrix4x4>::New();
+  this->PhysicalToWorldMatrix = vtkSmartPointer<vtkMatrix4x4>::New();
+  this->DeviceToWorldMatrix = vtkSmartPointer<vtkMatrix4x4>::New();
+  this->PublishedDeviceToWorldMatrix = vtkSmartPointer<vtkMatrix4x4>::New();
+
+  // The loop is re-armed after each frame with the time left until the next wake-up point
+  this->VirtualRealityLoopTimer.setSingleShot(true);
+  this->VirtualRealityLoopTimer.setTimerType(Qt::PreciseTimer);
   QObject::connect(&this->VirtualRealityLoopTimer, SIGNAL(timeout()), this, SLOT(doOpenVirtualReality()));
+
+  this->InitializationTimer.setSingleShot(true);
+  QObject::connect(&this->InitializationTimer, SIGNAL(timeout()), this, SLOT(continueInitialization()));
+
+  this->InputEventQueue = vtkSmartPointer<vtkVirtualRealityInputEventQueue>::New();
+  this->InputEventTimer.setSingleShot(true);
+  QObject::connect(&this->InputEventTimer, SIGNAL(timeout()), this, SLOT(processInputEvents()));
 }
 
 //----------------------------------------------------------------------------
@@ -195,6 +311,26 @@ int qMRMLVirtualRealityView::currentXRBackend() const
   return static_cast<int>(d->currentXRBackend());
 }
 
+// --------------------------------------------------------------------------
+void qMRMLVirtualRealityView::reinitializeXRBackend()
+{
+  Q_D(qMRMLVirtualRealityView);
+  if (!d->MRMLVirtualRealityViewNode || !d->MRMLVirtualRealityViewNode->GetVisibility())
+  {
+    return;
+  }
+  d->cancelInitialization();
+  d->InitializationAttempts = 0;
+  d->scheduleInitialization(0);
+}
+
+// --------------------------------------------------------------------------
+bool qMRMLVirtualRealityView::graphicsResourcesShared() const
+{
+  Q_D(const qMRMLVirtualRealityView);
+  return d->GraphicsResourcesShared;
+}
+
 //---------------------------------------------------------------------------
 void qMRMLVirtualRealityViewPrivate::createRenderWindow(vtkMRMLVirtualRealityViewNode::XRBackendType xrBackend)
 {
@@ -234,13 +370,25 @@ void qMRMLVirtualRealityViewPrivate::createRenderWindow(vtkMRMLVirtualRealityVie
   this->InteractorStyleDelegate = vtkSmartPointer<vtkVirtualRealityViewInteractorStyleDelegate>::New();
 
   // XRBackend
+  if (xrBackend == vtkMRMLVirtualRealityViewNode::Simulated)
+  {
+    vtkNew<vtkVirtualRealityViewSimulatedInteractorStyle> interactorStyle;
+    interactorStyle->SetInteractorStyleDelegate(this->InteractorStyleDelegate);
+
+    this->RenderWindow = vtkSmartPointer<vtkVirtualRealitySimulatedRenderWindow>::New();
+    this->Renderer = vtkSmartPointer<vtkVirtualRealitySimulatedRenderer>::New();
+    this->InteractorStyle = interactorStyle;
+    this->Interactor = vtkSmartPointer<vtkVirtualRealityViewSimulatedInteractor>::New();
+    this->Camera = vtkSmartPointer<vtkVirtualRealitySimulatedCamera>::New();
+  }
+  else
 #if defined(SlicerVirtualReality_HAS_OPENVR_SUPPORT)
   if (xrBackend == vtkMRMLVirtualRealityViewNode::OpenVR)
   {
     vtkNew<vtkVirtualRealityViewOpenVRInteractorStyle> interactorStyle;
     interactorStyle->SetInteractorStyleDelegate(this->InteractorStyleDelegate);
 
-    this->RenderWindow = vtkSmartPointer<vtkOpenVRRenderWindow>::New();
+    this->RenderWindow = vtkSmartPointer<vtkVirtualRealityViewOpenVRRenderWindow>::New();
     this->Renderer = vtkSmartPointer<vtkOpenVRRenderer>::New();
     this->InteractorStyle = interactorStyle;
     this->Interactor = vtkSmartPointer<vtkVirtualRealityViewOpenVRInteractor>::New();
@@ -302,6 +450,11 @@ void qMRMLVirtualRealityViewPrivate::createRenderWindow(vtkMRMLVirtualRealityVie
   this->RenderWindow->SetInteractor(this->Interactor);
   // Set default 10x magnification (conversion: PhysicalScale = 1000 / Magnification)
   this->RenderWindow->SetPhysicalScale(100.0);
+  vtkOpenGLRenderWindow* sharedRenderWindow = nullptr;
+  if (this->MRMLVirtualRealityViewNode->GetSharedGraphicsResources() && !this->GraphicsResourcesSharingFailed)
+  {
+    sharedRenderWindow = this->shareGraphicsResourcesWithReferenceView();
+  }
 
   //
   // Connections
@@ -311,8 +464,23 @@ void qMRMLVirtualRealityViewPrivate::createRenderWindow(vtkMRMLVirtualRealityVie
   qvtkReconnect(this->RenderWindow, vtkVRRenderWindow::PhysicalToWorldMatrixModified,
                 q, SLOT(onPhysicalToWorldMatrixModified()));
 
-  // Observe button press event
-  qvtkReconnect(this->Interactor, vtkCommand::Button3DEvent, q, SLOT(onButton3DEvent(vtkObject*,void*,unsigned long,void*)));
+  // Time rendering of the scene, render window events are invoked once per frame for all eyes
+  qvtkReconnect(this->RenderWindow, vtkCommand::StartEvent, this, SLOT(onRenderStarted()));
+  qvtkReconnect(this->RenderWindow, vtkCommand::EndEvent, this, SLOT(onRenderEnded()));
+
+  // Queue button events, signals are emitted after the frame
+  qvtkReconnect(this->Interactor, vtkCommand::Button3DEvent, q,
+                SLOT(onDevice3DEventForInputQueue(vtkObject*,void*,unsigned long,void*)));
+
+  // Observe input events for pose trace recording, before they may be aborted by other observers
+  const float poseTracePriority = 1.0f;
+  for (unsigned long event : { vtkCommand::Button3DEvent, vtkCommand::Menu3DEvent, vtkCommand::Select3DEvent,
+                               vtkCommand::NextPose3DEvent, vtkCommand::ViewerMovement3DEvent,
+                               vtkCommand::PositionProp3DEvent, vtkCommand::Elevation3DEvent })
+  {
+    qvtkReconnect(this->Interactor, event, q,
+                  SLOT(onDevice3DEventForPoseTrace(vtkObject*,void*,unsigned long,void*)), poseTracePriority);
+  }
 
   //
   // DisplayableManager registration
@@ -350,11 +518,40 @@ void qMRMLVirtualRealityViewPrivate::createRenderWindow(vtkMRMLVirtualRealityVie
     }
   }
 
-  this->DisplayableManagerGroup = vtkSmartPointer<vtkMRMLDisplayableManagerGroup>::Take(
-                                    factory->InstantiateDisplayableManagers(q->renderer()));
+  if (this->DetachedDisplayableManagerGroup)
+  {
+    // Reuse the displayable managers of the previous render window, their actors and mappers
+    // are kept, only the graphics resources are created again in the new rendering context.
+    this->DisplayableManagerGroup = this->DetachedDisplayableManagerGroup;
+    this->DisplayableManagerGroup->SetRenderer(this->Renderer);
+    vtkProp* prop = nullptr;
+    vtkCollectionSimpleIterator propIt;
+    for (this->DetachedViewProps->InitTraversal(propIt); (prop = this->DetachedViewProps->GetNextProp(propIt));)
+    {
+      this->Renderer->AddViewProp(prop);
+    }
+    this->DetachedDisplayableManagerGroup = nullptr;
+    this->DetachedViewProps = nullptr;
+    // Create the widgets removed by detachDisplayableManagers() with the new renderer
+    foreach (const QString& className, qMRMLVirtualRealityViewPrivate::widgetDisplayableManagerClassNames())
+    {
+      vtkMRMLAbstractDisplayableManager* displayableManager =
+        this->DisplayableManagerGroup->GetDisplayableManagerByClassName(className.toLatin1());
+      if (displayableManager)
+      {
+        displayableManager->SetMRMLScene(this->MRMLVirtualRealityViewNode->GetScene());
+      }
+    }
+  }
+  else
+  {
+    this->DisplayableManagerGroup = vtkSmartPointer<vtkMRMLDisplayableManagerGroup>::Take(
+                                      factory->InstantiateDisplayableManagers(q->renderer()));
+  }
   this->DisplayableManagerGroup->SetMRMLDisplayableNode(this->MRMLVirtualRealityViewNode);
   this->InteractorStyleDelegate->SetDisplayableManagers(this->DisplayableManagerGroup);
   this->InteractorObserver->SetDisplayableManagers(this->DisplayableManagerGroup);
+  this->InteractorObserver->UpdateDisplayableManagerSubscriptionTable();
 
   // Default inputs mapping
   vtkSlicerVirtualRealityLogic::SetTriggerButtonFunction(
@@ -413,17 +610,43 @@ void qMRMLVirtualRealityViewPrivate::createRenderWindow(vtkMRMLVirtualRealityVie
     return;
   }
 
-  // Keep track of last valid parameters in the settings
-  QSettings().setValue("VirtualReality/DefaultXRBackend", xrBackendAsStr);
+  // Drivers may fail to share the native context of the XR render window with the one of the
+  // reference view, the buffer cache shared by VTK would then refer to buffers that do not exist.
+  if (sharedRenderWindow)
+  {
+    this->GraphicsResourcesShared = IsOpenGLContextShared(sharedRenderWindow, this->RenderWindow);
+    if (!this->GraphicsResourcesShared)
+    {
+      qWarning() << Q_FUNC_INFO << ": Graphics resources are not shared, OpenGL context of the reference view cannot be shared";
+      this->GraphicsResourcesSharingFailed = true;
+    }
+  }
+
+  this->FramePacer->SetRefreshRate(this->displayRefreshRate());
+  this->FramePacer->Reset();
+  this->FrameTimingLog->Clear();
+  this->AdaptiveQualityController->SetTargetFrameTime(this->FramePacer->GetFramePeriod());
+  this->AdaptiveQualityController->Reset(this->AdaptiveQualityController->GetMaximumQuality());
+  // Start at full resolution, it is reduced only if frames are over budget
+  this->RenderScaleController->SetTargetFrameTime(this->FramePacer->GetFramePeriod());
+  this->RenderScaleController->Reset(1.0);
+
+  // Keep track of last valid parameters in the settings.
+  // The simulated backend is only used for testing, it is never made the default.
+  if (xrBackend != vtkMRMLVirtualRealityViewNode::Simulated)
+  {
+    QSettings().setValue("VirtualReality/DefaultXRBackend", xrBackendAsStr);
 #if defined(SlicerVirtualReality_HAS_OPENXRREMOTING_SUPPORT)
-  QSettings().setValue("VirtualReality/DefaultRemotingEnabled", this->MRMLVirtualRealityViewNode->GetRemoting());
-  QSettings().setValue("VirtualReality/DefaultPlayerIPAddress", QString::fromStdString(this->MRMLVirtualRealityViewNode->GetPlayerIPAddress()));
+    QSettings().setValue("VirtualReality/DefaultRemotingEnabled", this->MRMLVirtualRealityViewNode->GetRemoting());
+    QSettings().setValue("VirtualReality/DefaultPlayerIPAddress", QString::fromStdString(this->MRMLVirtualRealityViewNode->GetPlayerIPAddress()));
 #endif
+  }
 
   qDebug() << "";
   qDebug() << "XR backend \"" << xrBackendAsStr << "\" initialized";
   qDebug() << "";
   qDebug() << "ActionManifestPath:" << q->actionManifestPath();
+  qDebug() << "Display refresh rate:" << this->FramePacer->GetRefreshRate() << "Hz";
   qDebug() << "Number of registered displayable manager:" << this->DisplayableManagerGroup->GetDisplayableManagerCount();
   qDebug() << "Registered displayable managers:";
   for (int idx=0; idx < this->DisplayableManagerGroup->GetDisplayableManagerCount(); idx++)
@@ -437,6 +660,14 @@ void qMRMLVirtualRealityViewPrivate::createRenderWindow(vtkMRMLVirtualRealityVie
 void qMRMLVirtualRealityViewPrivate::destroyRenderWindow()
 {
   this->VirtualRealityLoopTimer.stop();
+  // Queued events refer to devices of the destroyed render window
+  this->InputEventTimer.stop();
+  this->InputEventQueue->Clear();
+  this->GraphicsResourcesShared = false;
+  this->updateKeepAliveSubmission(false);
+  this->PoseTraceWriter->Close();
+  this->PoseTracePlayer->Stop();
+  this->PoseTracePlayer->SetInteractor(nullptr);
   // Must break the connection between interactor and render window,
   // otherwise they would circularly refer to each other and would not
   // be deleted.
@@ -451,6 +682,119 @@ void qMRMLVirtualRealityViewPrivate::destroyRenderWindow()
   this->Camera = nullptr;
   this->Lights = nullptr;
   this->RenderWindow = nullptr;
+  this->AppliedProperties = AppliedViewNodeProperties();
+  this->TrackingReferenceHandles.clear();
+  this->TrackingReferenceHandlesValid = false;
+  if (this->MRMLVirtualRealityViewNode != nullptr)
+  {
+    this->MRMLVirtualRealityViewNode->RemoveAllDeviceStatuses();
+  }
+}
+
+//---------------------------------------------------------------------------
+vtkOpenGLRenderWindow* qMRMLVirtualRealityViewPrivate::shareGraphicsResourcesWithReferenceView()
+{
+  vtkMRMLViewNode* referenceViewNode = this->MRMLVirtualRealityViewNode->GetReferenceViewNode();
+  qSlicerLayoutManager* layoutManager = qSlicerApplication::application()->layoutManager();
+  qMRMLThreeDWidget* referenceWidget = (referenceViewNode && layoutManager) ? layoutManager->threeDWidget(referenceViewNode) : nullptr;
+  vtkOpenGLRenderWindow* referenceRenderWindow = referenceWidget ?
+    vtkOpenGLRenderWindow::SafeDownCast(referenceWidget->threeDView()->renderWindow()) : nullptr;
+  if (!referenceRenderWindow)
+  {
+    qWarning() << Q_FUNC_INFO << ": Graphics resources are not shared, reference view is not found";
+    return nullptr;
+  }
+
+  // Must be set before the render window is initialized, XR render windows render
+  // in the OpenGL context of their helper window.
+  this->RenderWindow->SetSharedRenderWindow(referenceRenderWindow);
+  if (this->RenderWindow->GetHelperWindow())
+  {
+    this->RenderWindow->GetHelperWindow()->SetSharedRenderWindow(referenceRenderWindow);
+  }
+  return referenceRenderWindow;
+}
+
+//---------------------------------------------------------------------------
+void qMRMLVirtualRealityViewPrivate::detachDisplayableManagers()
+{
+  if (this->DisplayableManagerGroup == nullptr || this->Renderer == nullptr || this->RenderWindow == nullptr)
+  {
+    return;
+  }
+
+  // Graphics resources belong to the rendering context of the render window that is destroyed
+  this->RenderWindow->ReleaseGraphicsResources(this->RenderWindow);
+
+  // Widgets are bound to the renderer and interactor they are created with, they are removed
+  // here and created again by their displayable manager when it is attached to the new renderer.
+  foreach (const QString& className, qMRMLVirtualRealityViewPrivate::widgetDisplayableManagerClassNames())
+  {
+    vtkMRMLAbstractDisplayableManager* displayableManager =
+      this->DisplayableManagerGroup->GetDisplayableManagerByClassName(className.toLatin1());
+    if (displayableManager)
+    {
+      displayableManager->SetMRMLScene(nullptr);
+    }
+  }
+
+  // Props of the interactor style (menu, pick feedback) are created again by the new interactor style
+  vtkNew<vtkPropCollection> interactorStyleProps;
+  this->getInteractorStyleProps(interactorStyleProps);
+  this->DetachedViewProps = vtkSmartPointer<vtkPropCollection>::New();
+  vtkProp* prop = nullptr;
+  vtkCollectionSimpleIterator propIt;
+  vtkPropCollection* viewProps = this->Renderer->GetViewProps();
+  for (viewProps->InitTraversal(propIt); (prop = viewProps->GetNextProp(propIt));)
+  {
+    if (!interactorStyleProps->IsItemPresent(prop))
+    {
+      this->DetachedViewProps->AddItem(prop);
+    }
+  }
+  this->Renderer->RemoveAllViewProps();
+
+  this->DetachedDisplayableManagerGroup = this->DisplayableManagerGroup;
+}
+
+//---------------------------------------------------------------------------
+QStringList qMRMLVirtualRealityViewPrivate::widgetDisplayableManagerClassNames()
+{
+  return QStringList()
+      << "vtkMRMLMarkupsDisplayableManager"
+      << "vtkMRMLLinearTransformsDisplayableManager"
+      << "vtkMRMLLinearTransformsDisplayableManager3D";
+}
+
+//---------------------------------------------------------------------------
+void qMRMLVirtualRealityViewPrivate::getInteractorStyleProps(vtkPropCollection* props)
+{
+  if (vtkVirtualRealityViewSimulatedInteractorStyle* simulatedInteractorStyle =
+        vtkVirtualRealityViewSimulatedInteractorStyle::SafeDownCast(this->InteractorStyle))
+  {
+    simulatedInteractorStyle->GetInteractorStyleProps(props);
+  }
+#if defined(SlicerVirtualReality_HAS_OPENVR_SUPPORT)
+  if (vtkVirtualRealityViewOpenVRInteractorStyle* openVRInteractorStyle =
+        vtkVirtualRealityViewOpenVRInteractorStyle::SafeDownCast(this->InteractorStyle))
+  {
+    openVRInteractorStyle->GetInteractorStyleProps(props);
+  }
+#endif
+#if defined(SlicerVirtualReality_HAS_OPENXR_SUPPORT)
+  if (vtkVirtualRealityViewOpenXRInteractorStyle* openXRInteractorStyle =
+        vtkVirtualRealityViewOpenXRInteractorStyle::SafeDownCast(this->InteractorStyle))
+  {
+    openXRInteractorStyle->GetInteractorStyleProps(props);
+  }
+#endif
+}
+
+//---------------------------------------------------------------------------
+void qMRMLVirtualRealityViewPrivate::releaseDetachedDisplayableManagers()
+{
+  this->DetachedDisplayableManagerGroup = nullptr;
+  this->DetachedViewProps = nullptr;
 }
 
 // --------------------------------------------------------------------------
@@ -460,6 +804,10 @@ vtkMRMLVirtualRealityViewNode::XRBackendType qMRMLVirtualRealityViewPrivate::cur
   {
     return vtkMRMLVirtualRealityViewNode::UndefinedXRBackend;
   }
+  if (vtkVirtualRealitySimulatedRenderWindow::SafeDownCast(this->RenderWindow) != nullptr)
+  {
+    return vtkMRMLVirtualRealityViewNode::Simulated;
+  }
 #if defined(SlicerVirtualReality_HAS_OPENVR_SUPPORT)
   if (vtkOpenVRRenderWindow::SafeDownCast(this->RenderWindow) != nullptr)
   {
@@ -509,6 +857,11 @@ void qMRMLVirtualRealityViewPrivate::updateWidgetFromMRML()
     // Updating widget from MRML is already in progress
     return;
     }
+  if (this->IsUpdatingMRMLFromInteraction)
+    {
+    // View node is updated from the current state of the view, there is nothing to apply
+    return;
+    }
   this->IsUpdatingWidgetFromMRML = true;
 
   this->updateWidgetFromMRMLNoModify();
@@ -523,49 +876,54 @@ void qMRMLVirtualRealityViewPrivate::updateWidgetFromMRMLNoModify()
   // (i.e., disconnected from hardware)
   if (!this->MRMLVirtualRealityViewNode || !this->MRMLVirtualRealityViewNode->GetVisibility())
   {
+    this->cancelInitialization();
+    if (this->MRMLVirtualRealityViewNode && this->MRMLVirtualRealityViewNode->GetWarmStandby()
+        && this->RenderWindow && this->RenderWindow->GetVRInitialized())
+    {
+      // Keep the render window and displayable managers, only stop rendering.
+      // Events queued before standby must not be processed when resuming.
+      this->VirtualRealityLoopTimer.stop();
+      this->InputEventTimer.stop();
+      this->InputEventQueue->Clear();
+      this->updateKeepAliveSubmission(false);
+      this->MRMLVirtualRealityViewNode->RemoveAllDeviceStatuses();
+      this->MRMLVirtualRealityViewNode->SetConnectionState(vtkMRMLVirtualRealityViewNode::ConnectionStateStandby);
+      return;
+    }
     this->destroyRenderWindow();
+    this->releaseDetachedDisplayableManagers();
     this->InitializationAttempts = 0;
-    this->MRMLVirtualRealityViewNode->ClearError();
+    this->GraphicsResourcesSharingFailed = false;
+    if (this->MRMLVirtualRealityViewNode)
+    {
+      this->MRMLVirtualRealityViewNode->ClearError();
+      this->MRMLVirtualRealityViewNode->SetConnectionState(vtkMRMLVirtualRealityViewNode::ConnectionStateDisconnected);
+    }
     return;
   }
 
-  // Reset initialization attempts and clear errors if the XR backend has changed
-  if (this->currentXRBackend() != this->MRMLVirtualRealityViewNode->GetXRBackend()
-      || this->currentXRBackendRemotingEnabled() != this->MRMLVirtualRealityViewNode->GetRemoting()
-      || this->currentXRBackendRemotingIPAddress() != this->MRMLVirtualRealityViewNode->GetPlayerIPAddress())
+  // Reset initialization attempts and clear errors if the requested XR backend has changed
+  if (this->InitializationXRBackend != this->MRMLVirtualRealityViewNode->GetXRBackend()
+      || this->InitializationRemoting != this->MRMLVirtualRealityViewNode->GetRemoting()
+      || this->InitializationPlayerIPAddress != this->MRMLVirtualRealityViewNode->GetPlayerIPAddress())
   {
+    this->cancelInitialization();
     this->InitializationAttempts = 0;
     this->MRMLVirtualRealityViewNode->ClearError();
   }
 
-  // Attempt to initialize XR backend if the current backend differs or is undefined, and
-  // the view is visible (i.e., connected to the hardware)
-  if ((this->currentXRBackend() != this->MRMLVirtualRealityViewNode->GetXRBackend()
-       || this->currentXRBackendRemotingEnabled() != this->MRMLVirtualRealityViewNode->GetRemoting()
-       || this->currentXRBackendRemotingIPAddress() != this->MRMLVirtualRealityViewNode->GetPlayerIPAddress()
-       || this->currentXRBackend() == vtkMRMLVirtualRealityViewNode::UndefinedXRBackend)
-      && this->MRMLVirtualRealityViewNode->GetVisibility())
+  // Initialize XR backend if the current backend differs or is undefined.
+  // Initialization continues from the event loop, the view is updated when it completes.
+  if (this->currentXRBackend() != this->MRMLVirtualRealityViewNode->GetXRBackend()
+      || this->currentXRBackendRemotingEnabled() != this->MRMLVirtualRealityViewNode->GetRemoting()
+      || this->currentXRBackendRemotingIPAddress() != this->MRMLVirtualRealityViewNode->GetPlayerIPAddress()
+      || this->currentXRBackend() == vtkMRMLVirtualRealityViewNode::UndefinedXRBackend)
   {
-    // Bail if there are no more attempts left
-    constexpr int maximumNumberOfAttempts = 1;
-    if (this->InitializationAttempts >= maximumNumberOfAttempts)
+    if (this->InitializationStage == InitializationStageIdle && this->InitializationAttempts == 0)
     {
-      return;
+      this->scheduleInitialization(0);
     }
-    this->InitializationAttempts++;
-    this->MRMLVirtualRealityViewNode->ClearError();
-
-    vtkMRMLVirtualRealityViewNode::XRBackendType xrBackend = this->MRMLVirtualRealityViewNode->GetXRBackend();
-    const char* xrBackendAsStr = vtkMRMLVirtualRealityViewNode::GetXRBackendAsString(xrBackend);
-
-    // Log the initialization attempt
-    qDebug().noquote().nospace()
-        << "Initializing \"" << xrBackendAsStr << "\" XR backend "
-        << QString("(%1/%2)").arg(this->InitializationAttempts).arg(maximumNumberOfAttempts);
-
-    // Destroy and recreate the render window
-    this->destroyRenderWindow();
-    this->createRenderWindow(xrBackend);
+    return;
   }
 
   // Skip further updates if the XR backend is undefined or if the view node has an error
@@ -575,159 +933,561 @@ void qMRMLVirtualRealityViewPrivate::updateWidgetFromMRMLNoModify()
     return;
   }
 
+  // Resume from warm standby
+  if (this->MRMLVirtualRealityViewNode->GetConnectionState() == vtkMRMLVirtualRealityViewNode::ConnectionStateStandby)
+  {
+    // Frames were not rendered while in standby, it must not be accounted as a missed frame
+    this->FramePacer->Reset();
+    this->MRMLVirtualRealityViewNode->SetConnectionState(vtkMRMLVirtualRealityViewNode::ConnectionStateConnected);
+  }
+
   if (this->DisplayableManagerGroup->GetMRMLDisplayableNode() != this->MRMLVirtualRealityViewNode.GetPointer())
   {
     this->DisplayableManagerGroup->SetMRMLDisplayableNode(this->MRMLVirtualRealityViewNode);
   }
 
+  vtkMRMLVirtualRealityViewNode* viewNode = this->MRMLVirtualRealityViewNode;
+  AppliedViewNodeProperties& applied = this->AppliedProperties;
+  bool applyAll = !applied.Valid;
+  applied.Valid = true;
+
   // Renderer properties
-  if (this->MRMLVirtualRealityViewNode->GetRemoting())
+  if (applyAll
+      || applied.Remoting != viewNode->GetRemoting()
+      || !std::equal(applied.BackgroundColor, applied.BackgroundColor + 3, viewNode->GetBackgroundColor())
+      || !std::equal(applied.BackgroundColor2, applied.BackgroundColor2 + 3, viewNode->GetBackgroundColor2()))
   {
-    this->Renderer->SetGradientBackground(0);
-    this->Renderer->SetBackground(0.0, 0.0, 0.0);
-    this->Renderer->SetBackgroundAlpha(0.0);
+    applied.Remoting = viewNode->GetRemoting();
+    std::copy_n(viewNode->GetBackgroundColor(), 3, applied.BackgroundColor);
+    std::copy_n(viewNode->GetBackgroundColor2(), 3, applied.BackgroundColor2);
+    if (viewNode->GetRemoting())
+    {
+      this->Renderer->SetGradientBackground(0);
+      this->Renderer->SetBackground(0.0, 0.0, 0.0);
+      this->Renderer->SetBackgroundAlpha(0.0);
+    }
+    else
+    {
+      this->Renderer->SetGradientBackground(1);
+      this->Renderer->SetBackground(viewNode->GetBackgroundColor());
+      this->Renderer->SetBackground2(viewNode->GetBackgroundColor2());
+    }
   }
-  else
+
+  if (applyAll || applied.TwoSidedLighting != viewNode->GetTwoSidedLighting())
   {
-    this->Renderer->SetGradientBackground(1);
-    this->Renderer->SetBackground(this->MRMLVirtualRealityViewNode->GetBackgroundColor());
-    this->Renderer->SetBackground2(this->MRMLVirtualRealityViewNode->GetBackgroundColor2());
+    applied.TwoSidedLighting = viewNode->GetTwoSidedLighting();
+    this->Renderer->SetTwoSidedLighting(viewNode->GetTwoSidedLighting());
   }
 
-  this->Renderer->SetTwoSidedLighting(this->MRMLVirtualRealityViewNode->GetTwoSidedLighting());
-
-  bool switchOnAllLights = this->MRMLVirtualRealityViewNode->GetBackLights();
-  for (int i = 2; i < this->Lights->GetNumberOfItems(); i++)
+  if (applyAll || applied.BackLights != viewNode->GetBackLights())
   {
-    vtkLight* light = vtkLight::SafeDownCast(this->Lights->GetItemAsObject(i));
-    light->SetSwitch(switchOnAllLights);
+    applied.BackLights = viewNode->GetBackLights();
+    bool switchOnAllLights = viewNode->GetBackLights();
+    for (int i = 2; i < this->Lights->GetNumberOfItems(); i++)
+    {
+      vtkLight* light = vtkLight::SafeDownCast(this->Lights->GetItemAsObject(i));
+      light->SetSwitch(switchOnAllLights);
+    }
   }
 
-  this->Renderer->SetUseDepthPeeling(this->MRMLVirtualRealityViewNode->GetUseDepthPeeling() != 0);
-  this->Renderer->SetUseDepthPeelingForVolumes(this->MRMLVirtualRealityViewNode->GetUseDepthPeeling() != 0);
+  if (applyAll || applied.UseDepthPeeling != (viewNode->GetUseDepthPeeling() != 0))
+  {
+    applied.UseDepthPeeling = (viewNode->GetUseDepthPeeling() != 0);
+    this->Renderer->SetUseDepthPeeling(applied.UseDepthPeeling);
+    this->Renderer->SetUseDepthPeelingForVolumes(applied.UseDepthPeeling);
+  }
 
   // Render window properties
   if (this->RenderWindow)
   {
     // Desired update rate
-    this->RenderWindow->SetDesiredUpdateRate(this->desiredUpdateRate());
-
-    // Magnification
-    double magnification = this->MRMLVirtualRealityViewNode->GetMagnification();
-    if (magnification < 0.01)
+    if (applyAll
+        || applied.AdaptiveQuality != viewNode->GetAdaptiveQuality()
+        || applied.AdaptiveQualityMinimum != viewNode->GetAdaptiveQualityMinimum()
+        || applied.AdaptiveQualityMaximum != viewNode->GetAdaptiveQualityMaximum()
+        || applied.DesiredUpdateRate != viewNode->GetDesiredUpdateRate())
     {
-      magnification = 0.01;
+      applied.AdaptiveQuality = viewNode->GetAdaptiveQuality();
+      applied.AdaptiveQualityMinimum = viewNode->GetAdaptiveQualityMinimum();
+      applied.AdaptiveQualityMaximum = viewNode->GetAdaptiveQualityMaximum();
+      applied.DesiredUpdateRate = viewNode->GetDesiredUpdateRate();
+      this->AdaptiveQualityController->SetMinimumQuality(viewNode->GetAdaptiveQualityMinimum());
+      this->AdaptiveQualityController->SetMaximumQuality(
+        qMax(viewNode->GetAdaptiveQualityMinimum(), viewNode->GetAdaptiveQualityMaximum()));
+      this->RenderWindow->SetDesiredUpdateRate(viewNode->GetAdaptiveQuality()
+        ? this->adaptiveQualityUpdateRate() : this->desiredUpdateRate());
     }
-    else if (magnification > 100.0)
+
+    // Render scale
+    if (applyAll
+        || applied.DynamicRenderScale != viewNode->GetDynamicRenderScale()
+        || applied.MinimumRenderScale != viewNode->GetMinimumRenderScale()
+        || applied.MaximumRenderScale != viewNode->GetMaximumRenderScale())
     {
-      magnification = 100.0;
+      applied.DynamicRenderScale = viewNode->GetDynamicRenderScale();
+      applied.MinimumRenderScale = viewNode->GetMinimumRenderScale();
+      applied.MaximumRenderScale = viewNode->GetMaximumRenderScale();
+      this->setRenderScale(viewNode->GetDynamicRenderScale()
+        ? this->dynamicRenderScale() : 1.0);
     }
-    this->InteractorStyleDelegate->SetMagnification(magnification);
-
-    // Dolly physical speed
-    double dollyPhysicalSpeedMps = this ->MRMLVirtualRealityViewNode->GetMotionSpeed();
-
-    // 1.6666 m/s is walking speed (= 6 km/h), which is the default. We multiply it with the factor
-    this->InteractorStyle->SetDollyPhysicalSpeed(dollyPhysicalSpeedMps);
 
-#if defined(SlicerVirtualReality_HAS_OPENVR_SUPPORT)
-    vtkOpenVRRenderWindow* vrRenderWindow = vtkOpenVRRenderWindow::SafeDownCast(this->RenderWindow);
-    if (vrRenderWindow != nullptr && vrRenderWindow->GetHMD() != nullptr)
+    // Magnification
+    if (applyAll || applied.Magnification != viewNode->GetMagnification())
     {
-      vtkEventDataDevice deviceIdsToUpdate[] = { vtkEventDataDevice::RightController, vtkEventDataDevice::LeftController, vtkEventDataDevice::Unknown };
-      for (int deviceIdIndex = 0; deviceIdsToUpdate[deviceIdIndex] != vtkEventDataDevice::Unknown; deviceIdIndex++)
+      applied.Magnification = viewNode->GetMagnification();
+      double magnification = viewNode->GetMagnification();
+      if (magnification < 0.01)
       {
-        vtkVRModel* model = vtkVRModel::SafeDownCast(vrRenderWindow->GetModelForDevice(deviceIdsToUpdate[deviceIdIndex]));
-        if (!model)
-        {
-          continue;
-        }
-        model->SetVisibility(this->MRMLVirtualRealityViewNode->GetControllerModelsVisible());
+        magnification = 0.01;
       }
-
-      // Update tracking reference visibility
-      for (uint32_t deviceIdIndex = 0; deviceIdIndex < vr::k_unMaxTrackedDeviceCount; ++deviceIdIndex)
+      else if (magnification > 100.0)
       {
-        if (vrRenderWindow->GetHMD()->GetTrackedDeviceClass(deviceIdIndex) == vr::TrackedDeviceClass_TrackingReference)
-        {
-          vtkVRModel* model = vtkVRModel::SafeDownCast(vrRenderWindow->GetModelForDevice(
-            vrRenderWindow->GetDeviceForOpenVRHandle(deviceIdIndex)));
-          if (!model)
-          {
-            continue;
-          }
-          model->SetVisibility(this->MRMLVirtualRealityViewNode->GetLighthouseModelsVisible());
-        }
+        magnification = 100.0;
       }
+      this->InteractorStyleDelegate->SetMagnification(magnification);
     }
-#endif
+
+    // Dolly physical speed
+    if (applyAll || applied.MotionSpeed != viewNode->GetMotionSpeed())
+    {
+      applied.MotionSpeed = viewNode->GetMotionSpeed();
+      double dollyPhysicalSpeedMps = viewNode->GetMotionSpeed();
+
+      // 1.6666 m/s is walking speed (= 6 km/h), which is the default. We multiply it with the factor
+      this->InteractorStyle->SetDollyPhysicalSpeed(dollyPhysicalSpeedMps);
+    }
+
+    this->updateDeviceModelsFromMRML(applyAll);
   }
 
   if (this->MRMLVirtualRealityViewNode->GetActive())
   {
-    this->VirtualRealityLoopTimer.start(0);
+    // Do not restart a scheduled frame, the view node is also modified from within the loop
+    if (!this->VirtualRealityLoopTimer.isActive())
+    {
+      this->VirtualRealityLoopTimer.start(0);
+    }
   }
   else
   {
     this->VirtualRealityLoopTimer.stop();
+    this->InputEventTimer.stop();
+    this->InputEventQueue->Clear();
   }
+
+  this->updateKeepAliveSubmission(this->MRMLVirtualRealityViewNode->GetKeepAliveSubmission()
+    && this->MRMLVirtualRealityViewNode->GetActive());
 }
 
-//---------------------------------------------------------------------------
-double qMRMLVirtualRealityViewPrivate::desiredUpdateRate()
+// --------------------------------------------------------------------------
+void qMRMLVirtualRealityViewPrivate::scheduleInitialization(int delay)
 {
-  double rate = this->MRMLVirtualRealityViewNode->GetDesiredUpdateRate();
+  this->InitializationXRBackend = this->MRMLVirtualRealityViewNode->GetXRBackend();
+  this->InitializationRemoting = this->MRMLVirtualRealityViewNode->GetRemoting();
+  this->InitializationPlayerIPAddress = this->MRMLVirtualRealityViewNode->GetPlayerIPAddress();
+  this->InitializationStage = InitializationStageStartAttempt;
+  this->InitializationTimer.start(delay);
+}
 
-  // enforce non-zero frame rate to avoid division by zero errors
-  const double defaultStaticViewUpdateRate = 0.0001;
-  if (rate < defaultStaticViewUpdateRate)
+// --------------------------------------------------------------------------
+void qMRMLVirtualRealityViewPrivate::cancelInitialization()
+{
+  // A runtime check running in the background cannot be interrupted, it is left running
+  // and waited for by the next initialization attempt
+  this->InitializationTimer.stop();
+  this->InitializationStage = InitializationStageIdle;
+}
+
+// --------------------------------------------------------------------------
+void qMRMLVirtualRealityViewPrivate::continueInitialization()
+{
+  vtkMRMLVirtualRealityViewNode* viewNode = this->MRMLVirtualRealityViewNode;
+  if (!viewNode)
   {
-    rate = defaultStaticViewUpdateRate;
+    this->cancelInitialization();
+    return;
   }
+  const char* xrBackendAsStr = vtkMRMLVirtualRealityViewNode::GetXRBackendAsString(this->InitializationXRBackend);
 
-  return rate;
+  switch (this->InitializationStage)
+  {
+    case InitializationStageStartAttempt:
+    {
+      this->InitializationAttempts++;
+      viewNode->ClearError();
+      viewNode->SetConnectionAttempt(this->InitializationAttempts);
+      viewNode->SetConnectionState(vtkMRMLVirtualRealityViewNode::ConnectionStateConnecting);
+
+      // Log the initialization attempt
+      qDebug().noquote().nospace()
+          << "Initializing \"" << xrBackendAsStr << "\" XR backend "
+          << QString("(%1/%2)").arg(this->InitializationAttempts).arg(MaximumNumberOfInitializationAttempts);
+
+#if defined(SlicerVirtualReality_HAS_OPENVR_SUPPORT)
+      if (this->InitializationXRBackend == vtkMRMLVirtualRealityViewNode::OpenVR)
+      {
+        // Loading the runtime client and starting the server may take a while, it is done in the background.
+        // A check abandoned by a cancelled initialization may still be running, it is waited for instead
+        // of starting another one, as OpenVR must not be initialized from two threads at once.
+        if (!this->InitializationRuntimeCheck || this->InitializationRuntimeCheck->Completed)
+        {
+          // Starting the runtime would shut down the OpenVR session of the current render window
+          this->detachDisplayableManagers();
+          this->destroyRenderWindow();
+          this->InitializationRuntimeCheck = std::make_shared<RuntimeCheckState>();
+          std::thread(CheckOpenVRRuntime, this->InitializationRuntimeCheck, vr::VRSystem() == nullptr).detach();
+        }
+        this->InitializationStage = InitializationStageCheckRuntime;
+        this->InitializationTimer.start(InitializationPollingInterval);
+        return;
+      }
+#endif
+      // Creating the session blocks the GUI, let the GUI report the connection state before
+      viewNode->SetConnectionState(vtkMRMLVirtualRealityViewNode::ConnectionStateCreatingSession);
+      this->InitializationStage = InitializationStageCreateRenderWindow;
+      this->InitializationTimer.start(0);
+      return;
+    }
+    case InitializationStageCheckRuntime:
+    {
+      if (!this->InitializationRuntimeCheck->Completed)
+      {
+        this->InitializationTimer.start(InitializationPollingInterval);
+        return;
+      }
+      if (!this->InitializationRuntimeCheck->HMDPresent)
+      {
+        qWarning() << Q_FUNC_INFO << ": No headset detected by the" << xrBackendAsStr << "runtime";
+        this->onInitializationAttemptFailed("Connection failed: No headset detected");
+        return;
+      }
+      viewNode->SetConnectionState(vtkMRMLVirtualRealityViewNode::ConnectionStateCreatingSession);
+      this->InitializationStage = InitializationStageCreateRenderWindow;
+      this->InitializationTimer.start(0);
+      return;
+    }
+    case InitializationStageCreateRenderWindow:
+    {
+      this->InitializationStage = InitializationStageIdle;
+
+      // Destroy and recreate the render window, keeping the displayable managers
+      this->detachDisplayableManagers();
+      this->destroyRenderWindow();
+      this->createRenderWindow(this->InitializationXRBackend);
+      if (this->RenderWindow && this->RenderWindow->GetVRInitialized()
+          && this->RenderWindow->GetSharedRenderWindow() && this->GraphicsResourcesSharingFailed)
+      {
+        // Context could not be shared with the reference view, create a render window with its own context
+        this->detachDisplayableManagers();
+        this->destroyRenderWindow();
+        this->createRenderWindow(this->InitializationXRBackend);
+      }
+
+      if (this->RenderWindow == nullptr || !this->RenderWindow->GetVRInitialized())
+      {
+        this->onInitializationAttemptFailed(viewNode->HasError() ? viewNode->GetError() : "Connection failed");
+        return;
+      }
+      viewNode->SetConnectionState(vtkMRMLVirtualRealityViewNode::ConnectionStateConnected);
+
+      // Apply view node properties to the new render window
+      this->updateWidgetFromMRML();
+      return;
+    }
+    case InitializationStageIdle:
+    default:
+      return;
+  }
 }
 
-//---------------------------------------------------------------------------
-double qMRMLVirtualRealityViewPrivate::stillUpdateRate()
+// --------------------------------------------------------------------------
+void qMRMLVirtualRealityViewPrivate::onInitializationAttemptFailed(const std::string& errorText)
 {
-  return 0.0001;
+  vtkMRMLVirtualRealityViewNode* viewNode = this->MRMLVirtualRealityViewNode;
+  if (this->InitializationAttempts >= MaximumNumberOfInitializationAttempts)
+  {
+    // Render window is kept, the view is not updated until the XR backend is changed
+    this->InitializationStage = InitializationStageIdle;
+    viewNode->SetError(errorText);
+    viewNode->SetConnectionState(vtkMRMLVirtualRealityViewNode::ConnectionStateFailed);
+    return;
+  }
+
+  // The runtime may still be starting, retry with an increasing delay
+  int delay = qMin(InitializationRetryMinimumDelay << (this->InitializationAttempts - 1), InitializationRetryMaximumDelay);
+  qDebug().noquote() << QString("XR backend initialization failed (%1), retrying in %2 ms")
+                        .arg(QString::fromStdString(errorText)).arg(delay);
+  this->InitializationStage = InitializationStageStartAttempt;
+  this->InitializationTimer.start(delay);
+  this->detachDisplayableManagers();
+  this->destroyRenderWindow();
+  viewNode->ClearError();
+  viewNode->SetConnectionState(vtkMRMLVirtualRealityViewNode::ConnectionStateRetrying);
 }
 
 // --------------------------------------------------------------------------
-void qMRMLVirtualRealityViewPrivate::doOpenVirtualReality()
+void qMRMLVirtualRealityViewPrivate::updateMRMLFromInteraction()
 {
-  if (this->Interactor == nullptr)
+  if (!this->PhysicalToWorldMatrixModifiedByInteraction || !this->MRMLVirtualRealityViewNode)
   {
-    qCritical() << Q_FUNC_INFO << "failed: Interactor is not set";
     return;
   }
-  if (this->Renderer == nullptr)
+  this->PhysicalToWorldMatrixModifiedByInteraction = false;
+
+  this->IsUpdatingMRMLFromInteraction = true;
+  this->MRMLVirtualRealityViewNode->SetMagnification(this->InteractorStyleDelegate->GetMagnification());
+  this->IsUpdatingMRMLFromInteraction = false;
+  // View already has this magnification
+  this->AppliedProperties.Magnification = this->MRMLVirtualRealityViewNode->GetMagnification();
+}
+
+// --------------------------------------------------------------------------
+void qMRMLVirtualRealityViewPrivate::updateDeviceModelsFromMRML(bool force)
+{
+  vtkMRMLVirtualRealityViewNode* viewNode = this->MRMLVirtualRealityViewNode;
+  if (!viewNode || !this->RenderWindow)
   {
-    qCritical() << Q_FUNC_INFO << "failed: Renderer is not set";
     return;
   }
-  if (this->RenderWindow == nullptr)
+  if (!force
+      && this->AppliedProperties.ControllerModelsVisible == viewNode->GetControllerModelsVisible()
+      && this->AppliedProperties.LighthouseModelsVisible == viewNode->GetLighthouseModelsVisible())
   {
-    qCritical() << Q_FUNC_INFO << "failed: RenderWindow is not set";
     return;
   }
+  this->AppliedProperties.ControllerModelsVisible = viewNode->GetControllerModelsVisible();
+  this->AppliedProperties.LighthouseModelsVisible = viewNode->GetLighthouseModelsVisible();
 
-  bool hmdConnected = true;
 #if defined(SlicerVirtualReality_HAS_OPENVR_SUPPORT)
   vtkOpenVRRenderWindow* vrRenderWindow = vtkOpenVRRenderWindow::SafeDownCast(this->RenderWindow);
-  if (vrRenderWindow != nullptr)
-  {
-    hmdConnected = vrRenderWindow->GetHMD() != nullptr;
-  }
-#endif
-  if (this->RenderWindow->GetVRInitialized() && hmdConnected)
+  if (vrRenderWindow != nullptr && vrRenderWindow->GetHMD() != nullptr)
   {
+    vtkEventDataDevice deviceIdsToUpdate[] = { vtkEventDataDevice::RightController, vtkEventDataDevice::LeftController, vtkEventDataDevice::Unknown };
+    for (int deviceIdIndex = 0; deviceIdsToUpdate[deviceIdIndex] != vtkEventDataDevice::Unknown; deviceIdIndex++)
+    {
+      vtkVRModel* model = vtkVRModel::SafeDownCast(vrRenderWindow->GetModelForDevice(deviceIdsToUpdate[deviceIdIndex]));
+      if (!model)
+      {
+        continue;
+      }
+      model->SetVisibility(viewNode->GetControllerModelsVisible());
+    }
+
+    // Update tracking reference visibility
+    if (!this->TrackingReferenceHandlesValid)
+    {
+      vr::TrackedDeviceIndex_t trackingReferenceHandles[vr::k_unMaxTrackedDeviceCount];
+      uint32_t numberOfTrackingReferences = vrRenderWindow->GetHMD()->GetSortedTrackedDeviceIndicesOfClass(
+        vr::TrackedDeviceClass_TrackingReference, trackingReferenceHandles, vr::k_unMaxTrackedDeviceCount);
+      this->TrackingReferenceHandles.assign(trackingReferenceHandles,
+        trackingReferenceHandles + std::min<uint32_t>(numberOfTrackingReferences, vr::k_unMaxTrackedDeviceCount));
+      this->TrackingReferenceHandlesValid = true;
+    }
+    for (uint32_t trackingReferenceHandle : this->TrackingReferenceHandles)
+    {
+      vtkVRModel* model = vtkVRModel::SafeDownCast(vrRenderWindow->GetModelForDevice(
+        vrRenderWindow->GetDeviceForOpenVRHandle(trackingReferenceHandle)));
+      if (!model)
+      {
+        continue;
+      }
+      model->SetVisibility(viewNode->GetLighthouseModelsVisible());
+    }
+  }
+#endif
+}
+
+// --------------------------------------------------------------------------
+void qMRMLVirtualRealityViewPrivate::onRenderStarted()
+{
+  this->FrameTimingLog->StartPhase(vtkVirtualRealityFrameTimingLog::RenderPhase);
+}
+
+// --------------------------------------------------------------------------
+void qMRMLVirtualRealityViewPrivate::onRenderEnded()
+{
+  this->FrameTimingLog->EndPhase(vtkVirtualRealityFrameTimingLog::RenderPhase);
+}
+
+// --------------------------------------------------------------------------
+void qMRMLVirtualRealityViewPrivate::onDeviceStatusModified()
+{
+  // Devices may have been connected or disconnected
+  this->TrackingReferenceHandlesValid = false;
+  this->updateDeviceModelsFromMRML(true);
+}
+
+//---------------------------------------------------------------------------
+double qMRMLVirtualRealityViewPrivate::desiredUpdateRate()
+{
+  double rate = this->MRMLVirtualRealityViewNode->GetDesiredUpdateRate();
+
+  // enforce non-zero frame rate to avoid division by zero errors
+  const double defaultStaticViewUpdateRate = 0.0001;
+  if (rate < defaultStaticViewUpdateRate)
+  {
+    rate = defaultStaticViewUpdateRate;
+  }
+
+  return rate;
+}
+
+//---------------------------------------------------------------------------
+double qMRMLVirtualRealityViewPrivate::stillUpdateRate()
+{
+  return 0.0001;
+}
+
+//---------------------------------------------------------------------------
+double qMRMLVirtualRealityViewPrivate::adaptiveQualityUpdateRate()
+{
+  // Lowest quality is rendering at the desired update rate, highest quality is rendering as a static view
+  return vtkVirtualRealityAdaptiveQualityController::InterpolateLogarithmic(
+    this->AdaptiveQualityController->GetQuality(), this->desiredUpdateRate(), this->stillUpdateRate());
+}
+
+//---------------------------------------------------------------------------
+double qMRMLVirtualRealityViewPrivate::dynamicRenderScale()
+{
+  double minimumScale = this->MRMLVirtualRealityViewNode->GetMinimumRenderScale();
+  double maximumScale = qMax(minimumScale, this->MRMLVirtualRealityViewNode->GetMaximumRenderScale());
+  return minimumScale + this->RenderScaleController->GetQuality() * (maximumScale - minimumScale);
+}
+
+//---------------------------------------------------------------------------
+void qMRMLVirtualRealityViewPrivate::setRenderScale(double scale)
+{
+  if (vtkVirtualRealitySimulatedRenderWindow* simulatedRenderWindow =
+        vtkVirtualRealitySimulatedRenderWindow::SafeDownCast(this->RenderWindow))
+  {
+    simulatedRenderWindow->SetRenderScale(scale);
+  }
+#if defined(SlicerVirtualReality_HAS_OPENVR_SUPPORT)
+  if (vtkVirtualRealityViewOpenVRRenderWindow* openVRRenderWindow =
+        vtkVirtualRealityViewOpenVRRenderWindow::SafeDownCast(this->RenderWindow))
+  {
+    openVRRenderWindow->SetRenderScale(scale);
+  }
+#endif
+}
+
+//---------------------------------------------------------------------------
+void qMRMLVirtualRealityViewPrivate::updateKeepAliveSubmission(bool enabled)
+{
+#if defined(SlicerVirtualReality_HAS_OPENVR_SUPPORT)
+  vtkVirtualRealityViewOpenVRRenderWindow* openVRRenderWindow =
+    vtkVirtualRealityViewOpenVRRenderWindow::SafeDownCast(this->RenderWindow);
+  if (!openVRRenderWindow)
+  {
+    return;
+  }
+  if (enabled && openVRRenderWindow->GetVRInitialized())
+  {
+    openVRRenderWindow->StartKeepAliveSubmission();
+  }
+  else
+  {
+    openVRRenderWindow->StopKeepAliveSubmission();
+  }
+#else
+  Q_UNUSED(enabled);
+#endif
+}
+
+//---------------------------------------------------------------------------
+double qMRMLVirtualRealityViewPrivate::renderScale() const
+{
+  if (vtkVirtualRealitySimulatedRenderWindow* simulatedRenderWindow =
+        vtkVirtualRealitySimulatedRenderWindow::SafeDownCast(this->RenderWindow))
+  {
+    return simulatedRenderWindow->GetRenderScale();
+  }
+#if defined(SlicerVirtualReality_HAS_OPENVR_SUPPORT)
+  if (vtkVirtualRealityViewOpenVRRenderWindow* openVRRenderWindow =
+        vtkVirtualRealityViewOpenVRRenderWindow::SafeDownCast(this->RenderWindow))
+  {
+    return openVRRenderWindow->GetRenderScale();
+  }
+#endif
+  // Render scale is not supported by the other backends
+  return 1.0;
+}
+
+//---------------------------------------------------------------------------
+double qMRMLVirtualRealityViewPrivate::displayRefreshRate() const
+{
+  double refreshRate = 90.0;
+#if defined(SlicerVirtualReality_HAS_OPENVR_SUPPORT)
+  vtkOpenVRRenderWindow* vrRenderWindow = vtkOpenVRRenderWindow::SafeDownCast(this->RenderWindow);
+  if (vrRenderWindow != nullptr && vrRenderWindow->GetHMD() != nullptr)
+  {
+    float hmdRefreshRate = vrRenderWindow->GetHMD()->GetFloatTrackedDeviceProperty(
+          vr::k_unTrackedDeviceIndex_Hmd, vr::Prop_DisplayFrequency_Float);
+    if (hmdRefreshRate > 0.0f)
+    {
+      refreshRate = hmdRefreshRate;
+    }
+  }
+#endif
+  return refreshRate;
+}
+
+// --------------------------------------------------------------------------
+void qMRMLVirtualRealityViewPrivate::doOpenVirtualReality()
+{
+  if (this->Interactor == nullptr)
+  {
+    qCritical() << Q_FUNC_INFO << "failed: Interactor is not set";
+    return;
+  }
+  if (this->Renderer == nullptr)
+  {
+    qCritical() << Q_FUNC_INFO << "failed: Renderer is not set";
+    return;
+  }
+  if (this->RenderWindow == nullptr)
+  {
+    qCritical() << Q_FUNC_INFO << "failed: RenderWindow is not set";
+    return;
+  }
+
+  bool hmdConnected = true;
+#if defined(SlicerVirtualReality_HAS_OPENVR_SUPPORT)
+  vtkOpenVRRenderWindow* vrRenderWindow = vtkOpenVRRenderWindow::SafeDownCast(this->RenderWindow);
+  if (vrRenderWindow != nullptr)
+  {
+    hmdConnected = vrRenderWindow->GetHMD() != nullptr;
+  }
+#endif
+  // Poll again after a frame period if there is nothing to render
+  double waitTime = this->FramePacer->GetFramePeriod();
+
+  if (this->RenderWindow->GetVRInitialized() && hmdConnected)
+  {
+    this->FramePacer->BeginFrame();
+    this->FrameTimingLog->StartFrame();
+
+    if (this->PoseTraceWriter->IsOpen())
+    {
+      this->PoseTraceWriter->WriteFrame(vtkVirtualRealityFramePacer::GetTime());
+    }
+
+    this->FrameTimingLog->StartPhase(vtkVirtualRealityFrameTimingLog::InteractorEventPhase);
     this->Interactor->DoOneEvent(this->RenderWindow, this->Renderer);
+    this->FrameTimingLog->EndPhase(vtkVirtualRealityFrameTimingLog::InteractorEventPhase);
+
+    this->updateMRMLFromInteraction();
+
+    if (this->PoseTraceWriter->IsOpen())
+    {
+      this->writePoseTraceFrame();
+    }
 
     this->LastViewUpdateTime->StopTimer();
     if (this->LastViewUpdateTime->GetElapsedTime() > 0.0)
     {
+      this->FrameTimingLog->StartPhase(vtkVirtualRealityFrameTimingLog::MotionCheckPhase);
       bool quickViewMotion =
           vtkSlicerVirtualRealityLogic::ShouldConsiderQuickViewMotion(
             this->MRMLVirtualRealityViewNode->GetMotionSensitivity(),
@@ -742,35 +1502,232 @@ void qMRMLVirtualRealityViewPrivate::doOpenVirtualReality()
             this->Camera->GetViewPlaneNormal(),
             this->Camera->GetViewUp());
 
-      double updateRate = quickViewMotion ? this->desiredUpdateRate() : this->stillUpdateRate();
+      // Rendering time of the scene for all eyes is the part of the frame time that depends on the quality
+      double renderTime = this->FrameTimingLog->GetCurrentPhaseDuration(vtkVirtualRealityFrameTimingLog::RenderPhase);
+      if (renderTime <= 0.0)
+      {
+        renderTime = this->FramePacer->GetLastFrameDuration();
+      }
+
+      // Quality is not increased while the view moves quickly, to favor smooth motion.
+      bool adaptiveQualityEnabled = this->MRMLVirtualRealityViewNode->GetAdaptiveQuality();
+      bool dynamicRenderScaleEnabled = this->MRMLVirtualRealityViewNode->GetDynamicRenderScale();
+      double renderScaleQuality = this->RenderScaleController->GetQuality();
+      if (adaptiveQualityEnabled && dynamicRenderScaleEnabled)
+      {
+        // Both are driven by the same render time, their corrections must not add up: resolution is
+        // only lowered once quality is at its minimum, and quality only raised once resolution is at its maximum.
+        vtkVirtualRealityAdaptiveQualityController::UpdateCascade(
+          this->AdaptiveQualityController, this->RenderScaleController, renderTime, !quickViewMotion);
+      }
+      else if (adaptiveQualityEnabled)
+      {
+        this->AdaptiveQualityController->Update(renderTime, !quickViewMotion);
+      }
+      else if (dynamicRenderScaleEnabled)
+      {
+        this->RenderScaleController->Update(renderTime);
+      }
+
+      double updateRate = 0.0;
+      if (adaptiveQualityEnabled)
+      {
+        updateRate = this->adaptiveQualityUpdateRate();
+      }
+      else
+      {
+        updateRate = quickViewMotion ? this->desiredUpdateRate() : this->stillUpdateRate();
+      }
       this->RenderWindow->SetDesiredUpdateRate(updateRate);
 
+      if (dynamicRenderScaleEnabled && this->RenderScaleController->GetQuality() != renderScaleQuality)
+      {
+        this->setRenderScale(this->dynamicRenderScale());
+      }
+
       // Save current view position and orientation
       this->Camera->GetViewPlaneNormal(this->LastViewDirection);
       this->Camera->GetViewUp(this->LastViewUp);
       this->Camera->GetPosition(this->LastViewPosition);
+      this->FrameTimingLog->EndPhase(vtkVirtualRealityFrameTimingLog::MotionCheckPhase);
+
+      // Shared by all the device poses published below
+      this->RenderWindow->GetPhysicalToWorldMatrix(this->PhysicalToWorldMatrix);
 
       if (this->MRMLVirtualRealityViewNode->GetControllerTransformsUpdate())
       {
+        this->FrameTimingLog->StartPhase(vtkVirtualRealityFrameTimingLog::ControllerPosePhase);
         this->MRMLVirtualRealityViewNode->CreateDefaultControllerTransformNodes();
         updateTransformNodeWithControllerPose(vtkEventDataDevice::LeftController);
         updateTransformNodeWithControllerPose(vtkEventDataDevice::RightController);
+        this->FrameTimingLog->EndPhase(vtkVirtualRealityFrameTimingLog::ControllerPosePhase);
       }
       if (this->MRMLVirtualRealityViewNode->GetHMDTransformUpdate())
       {
+        this->FrameTimingLog->StartPhase(vtkVirtualRealityFrameTimingLog::HMDPosePhase);
         this->MRMLVirtualRealityViewNode->CreateDefaultHMDTransformNode();
         updateTransformNodeWithHMDPose();
+        this->FrameTimingLog->EndPhase(vtkVirtualRealityFrameTimingLog::HMDPosePhase);
       }
       if (this->MRMLVirtualRealityViewNode->GetTrackerTransformUpdate())
       {
+        this->FrameTimingLog->StartPhase(vtkVirtualRealityFrameTimingLog::TrackerPosePhase);
         updateTransformNodesWithTrackerPoses();
+        this->FrameTimingLog->EndPhase(vtkVirtualRealityFrameTimingLog::TrackerPosePhase);
       }
 
       this->LastViewUpdateTime->StartTimer();
     }
+
+    this->FramePacer->EndFrame();
+    this->FrameTimingLog->EndFrame(this->FramePacer->GetLastFrameMissedDeadline());
+    waitTime = this->FramePacer->GetTimeUntilNextWakeUp();
+
+    if (this->InputEventQueue->GetNumberOfEvents() > 0 && !this->InputEventTimer.isActive())
+    {
+      this->InputEventTimer.start(0);
+    }
+  }
+
+  // Schedule next frame unless rendering was deactivated or the render window
+  // was destroyed while processing this frame.
+  if (this->RenderWindow != nullptr
+      && this->MRMLVirtualRealityViewNode != nullptr
+      && this->MRMLVirtualRealityViewNode->GetActive())
+  {
+    this->VirtualRealityLoopTimer.start(static_cast<int>(waitTime * 1000.0));
+  }
+}
+
+// --------------------------------------------------------------------------
+void qMRMLVirtualRealityViewPrivate::processInputEvents()
+{
+  // Signal handlers run on the thread of the render loop. Events are only emitted while the next
+  // frame is not due, remaining events are emitted after the next frame. At least one event is
+  // emitted per drain so that input is not starved when frames take all the available time.
+  vtkVirtualRealityInputEventQueue::InputEvent event;
+  int numberOfEmittedEvents = 0;
+  while ((numberOfEmittedEvents == 0
+          || this->FramePacer->GetTimeUntilNextWakeUp() > InputEventProcessingMinimumTime)
+         && this->InputEventQueue->Pop(event))
+  {
+    if (event.Type == vtkVirtualRealityInputEventQueue::InputEvent::ButtonEventType)
+    {
+      this->emitButtonSignals(event.Device, event.Input, event.Action, event.Values);
+    }
+    ++numberOfEmittedEvents;
+  }
+
+  vtkTypeInt64 numberOfOverflows = this->InputEventQueue->GetNumberOfOverflows();
+  if (numberOfOverflows > this->ReportedNumberOfInputEventOverflows)
+  {
+    qWarning() << Q_FUNC_INFO << ":" << numberOfOverflows - this->ReportedNumberOfInputEventOverflows
+               << "input events dropped, the input event queue is full";
+    this->ReportedNumberOfInputEventOverflows = numberOfOverflows;
+  }
+}
+
+// --------------------------------------------------------------------------
+void qMRMLVirtualRealityViewPrivate::emitButtonSignals(int device, int input, int action, const double trackPadPosition[2])
+{
+  Q_Q(qMRMLVirtualRealityView);
+  if (input == static_cast<int>(vtkEventDataDeviceInput::Trigger))
+  {
+    if (device == static_cast<int>(vtkEventDataDevice::LeftController))
+    {
+      if (action == static_cast<int>(vtkEventDataAction::Press))
+      {
+        emit q->leftControllerTriggerPressed();
+      }
+      else if (action == static_cast<int>(vtkEventDataAction::Release))
+      {
+        emit q->leftControllerTriggerReleased();
+      }
+    }
+    else if (device == static_cast<int>(vtkEventDataDevice::RightController))
+    {
+      if (action == static_cast<int>(vtkEventDataAction::Press))
+      {
+        emit q->rightControllerTriggerPressed();
+      }
+      else if (action == static_cast<int>(vtkEventDataAction::Release))
+      {
+        emit q->rightControllerTriggerReleased();
+      }
+    }
+  }
+  else if (input == static_cast<int>(vtkEventDataDeviceInput::Grip))
+  {
+    if (device == static_cast<int>(vtkEventDataDevice::LeftController))
+    {
+      if (action == static_cast<int>(vtkEventDataAction::Press))
+      {
+        emit q->leftControllerGripPressed();
+      }
+      else if (action == static_cast<int>(vtkEventDataAction::Release))
+      {
+        emit q->leftControllerGripReleased();
+      }
+    }
+    else if (device == static_cast<int>(vtkEventDataDevice::RightController))
+    {
+      if (action == static_cast<int>(vtkEventDataAction::Press))
+      {
+        emit q->rightControllerGripPressed();
+      }
+      else if (action == static_cast<int>(vtkEventDataAction::Release))
+      {
+        emit q->rightControllerGripReleased();
+      }
+    }
+  }
+  else if (input == static_cast<int>(vtkEventDataDeviceInput::TrackPad))
+  {
+    if (device == static_cast<int>(vtkEventDataDevice::LeftController))
+    {
+      if (action == static_cast<int>(vtkEventDataAction::Press))
+      {
+        emit q->leftControllerTrackpadPressed(trackPadPosition[0], trackPadPosition[1]);
+      }
+      else if (action == static_cast<int>(vtkEventDataAction::Release))
+      {
+        emit q->leftControllerTrackpadReleased(trackPadPosition[0], trackPadPosition[1]);
+      }
+    }
+    else if (device == static_cast<int>(vtkEventDataDevice::RightController))
+    {
+      if (action == static_cast<int>(vtkEventDataAction::Press))
+      {
+        emit q->rightControllerTrackpadPressed(trackPadPosition[0], trackPadPosition[1]);
+      }
+      else if (action == static_cast<int>(vtkEventDataAction::Release))
+      {
+        emit q->rightControllerTrackpadReleased(trackPadPosition[0], trackPadPosition[1]);
+      }
+    }
   }
 }
 
+// --------------------------------------------------------------------------
+void qMRMLVirtualRealityViewPrivate::writePoseTraceFrame()
+{
+  for (vtkEventDataDevice device : { vtkEventDataDevice::HeadMountedDisplay,
+                                     vtkEventDataDevice::LeftController,
+                                     vtkEventDataDevice::RightController,
+                                     vtkEventDataDevice::GenericTracker })
+  {
+    uint32_t numberOfDeviceHandles = this->RenderWindow->GetNumberOfDeviceHandlesForDevice(device);
+    for (uint32_t index = 0; index < numberOfDeviceHandles; ++index)
+    {
+      uint32_t deviceHandle = this->RenderWindow->GetDeviceHandleForDevice(device, index);
+      this->PoseTraceWriter->WriteDevicePose(
+        deviceHandle, device, this->RenderWindow->GetDeviceToPhysicalMatrixForDeviceHandle(deviceHandle));
+    }
+  }
+  this->RenderWindow->GetPhysicalToWorldMatrix(this->PoseTraceMatrix);
+  this->PoseTraceWriter->WritePhysicalToWorldMatrix(this->PoseTraceMatrix);
+}
+
 // --------------------------------------------------------------------------
 void qMRMLVirtualRealityViewPrivate::updateTransformNodeWithControllerPose(vtkEventDataDevice device)
 {
@@ -812,6 +1769,10 @@ void qMRMLVirtualRealityViewPrivate::updateTransformNodesWithTrackerPoses()
   {
     uint32_t handle = this->RenderWindow->GetDeviceHandleForDevice(vtkEventDataDevice::GenericTracker, i);
     vtkMRMLLinearTransformNode* node = this->MRMLVirtualRealityViewNode->CreateDefaultTrackerTransformNode(handle);
+    if (node == nullptr)
+    {
+      continue;
+    }
 
     int disabledModify = node->StartModify();
     this->updateTransformNodeFromDevice(node, vtkEventDataDevice::GenericTracker, i);
@@ -824,77 +1785,92 @@ void qMRMLVirtualRealityViewPrivate::updateTransformNodesWithTrackerPoses()
 void qMRMLVirtualRealityViewPrivate
 ::updateTransformNodeAttributesFromDevice(vtkMRMLTransformNode* node, vtkEventDataDevice device, uint32_t index)
 {
+  uint32_t deviceHandle = this->RenderWindow->GetDeviceHandleForDevice(device, index);
+
+  int trackingResult = vtkMRMLVirtualRealityViewNode::TrackingResultUninitialized;
+  bool connected = false;
+  bool poseValid = false;
 #ifdef SlicerVirtualReality_HAS_OPENVR_SUPPORT
   vtkOpenVRRenderWindow* vrRenderWindow = vtkOpenVRRenderWindow::SafeDownCast(this->RenderWindow);
-  if (vrRenderWindow == nullptr)
+  if (vrRenderWindow != nullptr)
   {
-    return;
+    vr::TrackedDevicePose_t* tdPose;
+    vrRenderWindow->GetOpenVRPose(device, index, &tdPose);
+    if (tdPose == nullptr)
+    {
+      switch(device)
+      {
+        case vtkEventDataDevice::HeadMountedDisplay:
+          qCritical() << Q_FUNC_INFO << ": Unable to retrieve HMD pose";
+          break;
+        case vtkEventDataDevice::RightController:
+          qCritical() << Q_FUNC_INFO << ": Unable to retrieve RightController pose";
+          break;
+        case vtkEventDataDevice::LeftController:
+          qCritical() << Q_FUNC_INFO << ": Unable to retrieve LeftController pose";
+          break;
+        case vtkEventDataDevice::GenericTracker:
+          qCritical() << Q_FUNC_INFO << ": Unable to retrieve pose associated with VR tracker"
+                      << "(index: " << index << ", handle: " << deviceHandle << ")";
+          break;
+        default:
+          qCritical() << Q_FUNC_INFO << ": Unable to retrieve pose associated with unknown device";
+          break;
+      }
+      return;
+    }
+    trackingResult = TrackingResultFromOpenVR(tdPose->eTrackingResult);
+    connected = tdPose->bDeviceIsConnected;
+    poseValid = tdPose->bPoseIsValid;
+  }
+  else
+#endif
+  {
+    // Other backends do not report tracking state, a device is considered tracked if it has a pose
+    poseValid = this->RenderWindow->GetDeviceToPhysicalMatrixForDeviceHandle(deviceHandle) != nullptr;
+    connected = poseValid;
+    trackingResult = poseValid ? vtkMRMLVirtualRealityViewNode::TrackingResultRunningOK
+                               : vtkMRMLVirtualRealityViewNode::TrackingResultUninitialized;
   }
 
-  std::string attributePrefix;
+  if (!this->MRMLVirtualRealityViewNode->SetDeviceStatus(device, deviceHandle,
+        trackingResult, connected, poseValid, vtkVirtualRealityFramePacer::GetTime()))
+  {
+    // Status did not change, attributes are up-to-date
+    return;
+  }
 
+  // Attributes are kept for backward compatibility, the typed device status of
+  // the view node should be preferred.
+  // Attribute names are literals to avoid building strings for each device at each frame
+  const char* activeAttributeName = nullptr;
+  const char* connectedAttributeName = nullptr;
   switch(device)
   {
     case vtkEventDataDevice::HeadMountedDisplay:
-      attributePrefix = "HMD";
+      activeAttributeName = "VirtualReality.HMDActive";
+      connectedAttributeName = "VirtualReality.HMDConnected";
       break;
     case vtkEventDataDevice::RightController:
-      attributePrefix = "Controller";
-      break;
     case vtkEventDataDevice::LeftController:
-      attributePrefix = "Controller";
+      activeAttributeName = "VirtualReality.ControllerActive";
+      connectedAttributeName = "VirtualReality.ControllerConnected";
       break;
     case vtkEventDataDevice::GenericTracker:
-      attributePrefix = "Tracker";
+      activeAttributeName = "VirtualReality.TrackerActive";
+      connectedAttributeName = "VirtualReality.TrackerConnected";
       break;
     default:
-      attributePrefix = "Unknown";
+      activeAttributeName = "VirtualReality.UnknownActive";
+      connectedAttributeName = "VirtualReality.UnknownConnected";
       break;
   }
 
-  vr::TrackedDevicePose_t* tdPose;
-  vrRenderWindow->GetOpenVRPose(device, index, &tdPose);
-  if (tdPose == nullptr)
-  {
-    auto handle = this->RenderWindow->GetDeviceHandleForDevice(device, index);
-    switch(device)
-    {
-      case vtkEventDataDevice::HeadMountedDisplay:
-        qCritical() << Q_FUNC_INFO << ": Unable to retrieve HMD pose";
-        break;
-      case vtkEventDataDevice::RightController:
-        qCritical() << Q_FUNC_INFO << ": Unable to retrieve RightController pose";
-        break;
-      case vtkEventDataDevice::LeftController:
-        qCritical() << Q_FUNC_INFO << ": Unable to retrieve LeftController pose";
-        break;
-      case vtkEventDataDevice::GenericTracker:
-        qCritical() << Q_FUNC_INFO << ": Unable to retrieve pose associated with VR tracker"
-                    << "(index: " << index << ", handle: " << handle << ")";
-        break;
-      default:
-        qCritical() << Q_FUNC_INFO << ": Unable to retrieve pose associated with unknown device";
-        break;
-    }
-    return;
-  }
-
-  bool active = tdPose != nullptr && tdPose->eTrackingResult == vr::TrackingResult_Running_OK;
-  std::string activeAttributeName = std::string("VirtualReality.") + attributePrefix + "Active";
-  node->SetAttribute(activeAttributeName.c_str(), active ? "1" : "0");
-
-  bool connected = tdPose != nullptr && tdPose->bDeviceIsConnected;
-  std::string connectedAttributeName = std::string("VirtualReality.") + attributePrefix + "Connected";
-  node->SetAttribute(connectedAttributeName.c_str(), connected ? "1" : "0");
-
-  bool poseValid = tdPose != nullptr && tdPose->bPoseIsValid;
+  bool active = trackingResult == vtkMRMLVirtualRealityViewNode::TrackingResultRunningOK;
+  node->SetAttribute(activeAttributeName, active ? "1" : "0");
+  node->SetAttribute(connectedAttributeName, connected ? "1" : "0");
   node->SetAttribute("VirtualReality.PoseValid", poseValid ? "True" : "False");
-  node->SetAttribute("VirtualReality.PoseStatus", tdPose ? PoseStatusToString(tdPose->eTrackingResult).c_str() : "Uninitialized");
-#else
-  Q_UNUSED(node);
-  Q_UNUSED(device);
-  Q_UNUSED(index);
-#endif
+  node->SetAttribute("VirtualReality.PoseStatus", vtkMRMLVirtualRealityViewNode::GetTrackingResultAsString(trackingResult));
 }
 
 //----------------------------------------------------------------------------
@@ -912,19 +1888,18 @@ void qMRMLVirtualRealityViewPrivate
     return;
   }
 
-  double pos[3] = { 0. };
-  double ppos[3] = { 0. };
-  double wxyz[4] = { 1., 0., 0., 0. };
-  double wdir[3] = { 1., 0., 0. };
-
   // Convert device pose to world coordinates
-  this->Interactor->ConvertPoseToWorldCoordinates(pose, pos, wxyz, ppos, wdir);
+  vtkSlicerVirtualRealityLogic::ComputeDeviceToWorldMatrix(pose, this->PhysicalToWorldMatrix, this->DeviceToWorldMatrix);
 
-  vtkNew<vtkTransform> transform;
-  transform->Translate(pos);
-  transform->RotateWXYZ(wxyz[0], wxyz[1], wxyz[2], wxyz[3]);
+  // Skip small changes to avoid needless TransformModified events
+  node->GetMatrixTransformToParent(this->PublishedDeviceToWorldMatrix);
+  if (vtkSlicerVirtualRealityLogic::AreMatricesEqual(this->DeviceToWorldMatrix, this->PublishedDeviceToWorldMatrix,
+                                                     this->MRMLVirtualRealityViewNode->GetPoseUpdateTolerance()))
+  {
+    return;
+  }
 
-  node->SetMatrixTransformToParent(transform->GetMatrix());
+  node->SetMatrixTransformToParent(this->DeviceToWorldMatrix);
 }
 
 
@@ -960,6 +1935,7 @@ void qMRMLVirtualRealityView::addDisplayableManager(const QString& displayableMa
     vtkMRMLDisplayableManagerGroup::InstantiateDisplayableManager(
       displayableManagerName.toLatin1()));
   d->DisplayableManagerGroup->AddDisplayableManager(displayableManager);
+  d->InteractorObserver->UpdateDisplayableManagerSubscriptionTable();
 }
 
 //------------------------------------------------------------------------------
@@ -974,6 +1950,9 @@ void qMRMLVirtualRealityView::setMRMLVirtualRealityViewNode(vtkMRMLVirtualRealit
   d->qvtkReconnect(
     d->MRMLVirtualRealityViewNode, newViewNode,
     vtkCommand::ModifiedEvent, d, SLOT(updateWidgetFromMRML()));
+  d->qvtkReconnect(
+    d->MRMLVirtualRealityViewNode, newViewNode,
+    vtkMRMLVirtualRealityViewNode::DeviceStatusModifiedEvent, d, SLOT(onDeviceStatusModified()));
 
   d->MRMLVirtualRealityViewNode = newViewNode;
 
@@ -1084,99 +2063,148 @@ QString qMRMLVirtualRealityView::actionManifestPath() const
 }
 
 //------------------------------------------------------------------------------
-void qMRMLVirtualRealityView::onPhysicalToWorldMatrixModified()
+vtkVirtualRealityFramePacer* qMRMLVirtualRealityView::framePacer() const
 {
-  Q_D(qMRMLVirtualRealityView);
+  Q_D(const qMRMLVirtualRealityView);
+  return d->FramePacer;
+}
 
-  d->MRMLVirtualRealityViewNode->SetMagnification(d->InteractorStyleDelegate->GetMagnification());
+//------------------------------------------------------------------------------
+vtkVirtualRealityFrameTimingLog* qMRMLVirtualRealityView::frameTimingLog() const
+{
+  Q_D(const qMRMLVirtualRealityView);
+  return d->FrameTimingLog;
+}
 
-  emit physicalToWorldMatrixModified();
+//------------------------------------------------------------------------------
+vtkVirtualRealityAdaptiveQualityController* qMRMLVirtualRealityView::adaptiveQualityController() const
+{
+  Q_D(const qMRMLVirtualRealityView);
+  return d->AdaptiveQualityController;
 }
 
 //------------------------------------------------------------------------------
-void qMRMLVirtualRealityView::onButton3DEvent(vtkObject* caller, void* call_data, unsigned long vtk_event, void* client_data)
+double qMRMLVirtualRealityView::qualityLevel() const
 {
-  Q_UNUSED(caller);
-  Q_UNUSED(vtk_event);
-  Q_UNUSED(client_data);
+  Q_D(const qMRMLVirtualRealityView);
+  return d->AdaptiveQualityController->GetQuality();
+}
+
+//------------------------------------------------------------------------------
+double qMRMLVirtualRealityView::renderScale() const
+{
+  Q_D(const qMRMLVirtualRealityView);
+  return d->renderScale();
+}
+
+//------------------------------------------------------------------------------
+vtkVirtualRealityInputEventQueue* qMRMLVirtualRealityView::inputEventQueue() const
+{
+  Q_D(const qMRMLVirtualRealityView);
+  return d->InputEventQueue;
+}
 
-  vtkEventDataDevice3D * ed = reinterpret_cast<vtkEventDataDevice3D*>(call_data);
+//------------------------------------------------------------------------------
+QVariantMap qMRMLVirtualRealityView::frameTimingStatistics() const
+{
+  Q_D(const qMRMLVirtualRealityView);
+  vtkVirtualRealityFrameTimingLog* log = d->FrameTimingLog;
 
-  if(ed->GetInput() == vtkEventDataDeviceInput::Trigger)
+  QVariantMap statistics;
+  statistics["NumberOfFrames"] = log->GetNumberOfFrames();
+  statistics["NumberOfDroppedFrames"] = log->GetNumberOfDroppedFrames();
+  for (int phase = 0; phase < vtkVirtualRealityFrameTimingLog::Phase_Last; ++phase)
   {
-    if(ed->GetDevice() == vtkEventDataDevice::LeftController)
-    {
-      if (ed->GetAction() == vtkEventDataAction::Press)
-      {
-        emit leftControllerTriggerPressed();
-      }
-      else if (ed->GetAction() == vtkEventDataAction::Release)
-      {
-        emit leftControllerTriggerReleased();
-      }
-    }
-    else if (ed->GetDevice() == vtkEventDataDevice::RightController)
-    {
-      if (ed->GetAction() == vtkEventDataAction::Press)
-      {
-        emit rightControllerTriggerPressed();
-      }
-      else if (ed->GetAction() == vtkEventDataAction::Release)
-      {
-        emit rightControllerTriggerReleased();
-      }
-    }
+    QVariantMap phaseStatistics;
+    phaseStatistics["Mean"] = log->GetPhaseDurationMean(phase) * 1000.0;
+    phaseStatistics["Median"] = log->GetPhaseDurationPercentile(phase, 50.0) * 1000.0;
+    phaseStatistics["P90"] = log->GetPhaseDurationPercentile(phase, 90.0) * 1000.0;
+    phaseStatistics["P95"] = log->GetPhaseDurationPercentile(phase, 95.0) * 1000.0;
+    phaseStatistics["P99"] = log->GetPhaseDurationPercentile(phase, 99.0) * 1000.0;
+    phaseStatistics["Maximum"] = log->GetPhaseDurationMaximum(phase) * 1000.0;
+    statistics[vtkVirtualRealityFrameTimingLog::GetPhaseAsString(phase)] = phaseStatistics;
   }
-  else if (ed->GetInput() == vtkEventDataDeviceInput::Grip)
+  return statistics;
+}
+
+//------------------------------------------------------------------------------
+bool qMRMLVirtualRealityView::exportFrameTimings(const QString& fileName) const
+{
+  Q_D(const qMRMLVirtualRealityView);
+  return d->FrameTimingLog->WriteCSV(fileName.toUtf8().constData());
+}
+
+//------------------------------------------------------------------------------
+bool qMRMLVirtualRealityView::startPoseTraceRecording(const QString& fileName)
+{
+  Q_D(qMRMLVirtualRealityView);
+  return d->PoseTraceWriter->Open(fileName.toUtf8().constData());
+}
+
+//------------------------------------------------------------------------------
+void qMRMLVirtualRealityView::stopPoseTraceRecording()
+{
+  Q_D(qMRMLVirtualRealityView);
+  d->PoseTraceWriter->Close();
+}
+
+//------------------------------------------------------------------------------
+bool qMRMLVirtualRealityView::isPoseTraceRecording() const
+{
+  Q_D(const qMRMLVirtualRealityView);
+  return d->PoseTraceWriter->IsOpen();
+}
+
+//------------------------------------------------------------------------------
+vtkVirtualRealityPoseTraceWriter* qMRMLVirtualRealityView::poseTraceWriter() const
+{
+  Q_D(const qMRMLVirtualRealityView);
+  return d->PoseTraceWriter;
+}
+
+//------------------------------------------------------------------------------
+bool qMRMLVirtualRealityView::replayPoseTrace(const QString& fileName, bool loop)
+{
+  Q_D(qMRMLVirtualRealityView);
+  vtkVirtualRealityViewSimulatedInteractor* simulatedInteractor =
+    vtkVirtualRealityViewSimulatedInteractor::SafeDownCast(d->Interactor);
+  if (simulatedInteractor == nullptr)
   {
-    if (ed->GetDevice() == vtkEventDataDevice::LeftController)
-    {
-      if (ed->GetAction() == vtkEventDataAction::Press)
-      {
-        emit leftControllerGripPressed();
-      }
-      else if (ed->GetAction() == vtkEventDataAction::Release)
-      {
-        emit leftControllerGripReleased();
-      }
-    }
-    else if (ed->GetDevice() == vtkEventDataDevice::RightController)
-    {
-      if (ed->GetAction() == vtkEventDataAction::Press)
-      {
-        emit rightControllerGripPressed();
-      }
-      else if (ed->GetAction() == vtkEventDataAction::Release)
-      {
-        emit rightControllerGripReleased();
-      }
-    }
+    qCritical() << Q_FUNC_INFO << " failed: pose traces can only be replayed with the Simulated XR backend";
+    return false;
   }
-  else if (ed->GetInput() == vtkEventDataDeviceInput::TrackPad)
+  if (!d->PoseTracePlayer->Load(fileName.toUtf8().constData()))
   {
-    if (ed->GetDevice() == vtkEventDataDevice::LeftController)
-    {
-      if (ed->GetAction() == vtkEventDataAction::Press)
-      {
-        emit leftControllerTrackpadPressed(ed->GetTrackPadPosition()[0],ed->GetTrackPadPosition()[1]);
-      }
-      else if (ed->GetAction() == vtkEventDataAction::Release)
-      {
-        emit leftControllerTrackpadReleased(ed->GetTrackPadPosition()[0], ed->GetTrackPadPosition()[1]);
-      }
-    }
-    else if (ed->GetDevice() == vtkEventDataDevice::RightController)
-    {
-      if (ed->GetAction() == vtkEventDataAction::Press)
-      {
-        emit rightControllerTrackpadPressed(ed->GetTrackPadPosition()[0], ed->GetTrackPadPosition()[1]);
-      }
-      else if (ed->GetAction() == vtkEventDataAction::Release)
-      {
-        emit rightControllerTrackpadReleased(ed->GetTrackPadPosition()[0], ed->GetTrackPadPosition()[1]);
-      }
-    }
+    qCritical() << Q_FUNC_INFO << " failed: unable to load pose trace" << fileName;
+    return false;
   }
+  d->PoseTracePlayer->SetLoop(loop);
+  d->PoseTracePlayer->SetInteractor(simulatedInteractor);
+  d->PoseTracePlayer->Play();
+  return true;
+}
+
+//------------------------------------------------------------------------------
+vtkVirtualRealityPoseTracePlayer* qMRMLVirtualRealityView::poseTracePlayer() const
+{
+  Q_D(const qMRMLVirtualRealityView);
+  return d->PoseTracePlayer;
+}
+
+//------------------------------------------------------------------------------
+void qMRMLVirtualRealityView::onPhysicalToWorldMatrixModified()
+{
+  Q_D(qMRMLVirtualRealityView);
+
+  // Matrix modified when applying the view node magnification, the view node is up-to-date
+  if (!d->IsUpdatingWidgetFromMRML)
+  {
+    // Interactions may modify the matrix on each controller event, the view node
+    // is updated once per frame
+    d->PhysicalToWorldMatrixModifiedByInteraction = true;
+  }
+
+  emit physicalToWorldMatrixModified();
 }
 
 //---------------------------------------------------------------------------
@@ -1255,3 +2283,28 @@ void qMRMLVirtualRealityView::updateViewFromReferenceViewCamera()
 
   ren->ResetCameraClippingRange();
 }
+
+//------------------------------------------------------------------------------
+void qMRMLVirtualRealityView::onDevice3DEventForPoseTrace(vtkObject* caller, void* call_data, unsigned long vtk_event, void* client_data)
+{
+  Q_D(qMRMLVirtualRealityView);
+  Q_UNUSED(caller);
+  Q_UNUSED(client_data);
+
+  if (!d->PoseTraceWriter->IsOpen())
+  {
+    return;
+  }
+  d->PoseTraceWriter->WriteEvent(vtk_event, reinterpret_cast<vtkEventDataDevice3D*>(call_data));
+}
+
+//------------------------------------------------------------------------------
+void qMRMLVirtualRealityView::onDevice3DEventForInputQueue(vtkObject* caller, void* call_data, unsigned long vtk_event, void* client_data)
+{
+  Q_D(qMRMLVirtualRealityView);
+  Q_UNUSED(caller);
+  Q_UNUSED(client_data);
+
+  d->InputEventQueue->PushEvent(vtk_event, reinterpret_cast<vtkEventDataDevice3D*>(call_data),
+                                vtkVirtualRealityFramePacer::GetTime());
+}
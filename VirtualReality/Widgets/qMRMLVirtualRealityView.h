@@ -23,11 +23,17 @@
 
 // VR Logic includes
 class vtkSlicerVirtualRealityLogic;
+class vtkVirtualRealityAdaptiveQualityController;
+class vtkVirtualRealityFramePacer;
+class vtkVirtualRealityFrameTimingLog;
+class vtkVirtualRealityInputEventQueue;
+class vtkVirtualRealityPoseTraceWriter;
 
 // VR MRML includes
 class vtkMRMLVirtualRealityViewNode;
 
 // VR MRMLDM includes
+class vtkVirtualRealityPoseTracePlayer;
 class vtkVirtualRealityViewInteractorObserver;
 
 // VR Widgets includes
@@ -36,6 +42,7 @@ class qMRMLVirtualRealityViewPrivate;
 
 // Qt includes
 #include <QString>
+#include <QVariantMap>
 #include <QWidget>
 
 // CTK includes
@@ -123,6 +130,15 @@ public:
   /// \sa renderWindow()
   Q_INVOKABLE int currentXRBackend() const;
 
+  /// Destroy and create again the render window of the current XR backend, for example
+  /// to recover after the XR runtime was restarted. Displayable managers are reused.
+  /// Initialization continues from the event loop.
+  Q_INVOKABLE void reinitializeXRBackend();
+
+  /// Return true if the OpenGL context of the render window is shared with the one of the reference view.
+  /// \sa vtkMRMLVirtualRealityViewNode::GetSharedGraphicsResources()
+  Q_INVOKABLE bool graphicsResourcesShared() const;
+
   /// Get underlying RenderWindow
   Q_INVOKABLE vtkVRRenderWindowInteractor* interactor()const;
 
@@ -156,6 +172,62 @@ public:
   Q_INVOKABLE QString actionManifestPath() const;
   ///@}
 
+  /// Get the scheduler pacing the render loop on the headset refresh rate.
+  /// It may be used to query the number of frames that missed their deadline.
+  Q_INVOKABLE vtkVirtualRealityFramePacer* framePacer() const;
+
+  /// Get the ring buffer of per-frame phase timings of the render loop.
+  Q_INVOKABLE vtkVirtualRealityFrameTimingLog* frameTimingLog() const;
+
+  /// Get the queue of controller input events received while processing frames.
+  /// The view consumes the queue to emit the controller signals after each frame, it may be
+  /// used to query the number of events dropped because the queue was full.
+  /// Only button events are queued by the view. Handlers of the controller signals still run
+  /// on the thread of the render loop: events are emitted between frames while the next frame
+  /// is not due, but a slow handler delays the next frame.
+  Q_INVOKABLE vtkVirtualRealityInputEventQueue* inputEventQueue() const;
+
+  /// Get the controller adjusting rendering quality to the measured frame time.
+  /// \sa vtkMRMLVirtualRealityViewNode::GetAdaptiveQuality()
+  Q_INVOKABLE vtkVirtualRealityAdaptiveQualityController* adaptiveQualityController() const;
+
+  /// Get current rendering quality level (between 0.0 and 1.0) of the adaptive quality controller.
+  Q_INVOKABLE double qualityLevel() const;
+
+  /// Get the fraction of the eye render size currently used for rendering.
+  /// \sa vtkMRMLVirtualRealityViewNode::GetDynamicRenderScale()
+  Q_INVOKABLE double renderScale() const;
+
+  /// Get statistics of the frame timings currently stored in the log.
+  ///
+  /// The returned map contains "NumberOfFrames", "NumberOfDroppedFrames" and, for each
+  /// phase (e.g "InteractorEvent", "Total"), a map with "Mean", "Median", "P90", "P95",
+  /// "P99" and "Maximum" durations in milliseconds.
+  ///
+  /// \sa vtkVirtualRealityFrameTimingLog::GetPhaseAsString()
+  Q_INVOKABLE QVariantMap frameTimingStatistics() const;
+
+  /// Write the frame timings currently stored in the log to a CSV file.
+  Q_INVOKABLE bool exportFrameTimings(const QString& fileName) const;
+
+  ///@{
+  /// Record device poses, physical-to-world matrix and input events of each frame to a binary trace file.
+  /// Recording stops when the render window is destroyed.
+  /// \sa vtkVirtualRealityPoseTraceWriter
+  Q_INVOKABLE bool startPoseTraceRecording(const QString& fileName);
+  Q_INVOKABLE void stopPoseTraceRecording();
+  Q_INVOKABLE bool isPoseTraceRecording() const;
+  Q_INVOKABLE vtkVirtualRealityPoseTraceWriter* poseTraceWriter() const;
+  ///@}
+
+  ///@{
+  /// Replay a trace recorded with startPoseTraceRecording(), one recorded frame per rendered frame.
+  /// Only supported by the "Simulated" XR backend.
+  /// \sa vtkVirtualRealityPoseTracePlayer
+  Q_INVOKABLE bool replayPoseTrace(const QString& fileName, bool loop = false);
+  Q_INVOKABLE vtkVirtualRealityPoseTracePlayer* poseTracePlayer() const;
+  ///@}
+
 signals:
 
   void physicalToWorldMatrixModified();
@@ -183,7 +255,8 @@ public slots:
   void setMRMLVirtualRealityViewNode(vtkMRMLVirtualRealityViewNode* newViewNode);
 
   void onPhysicalToWorldMatrixModified();
-  void onButton3DEvent(vtkObject* caller, void* call_data, unsigned long vtk_event, void* client_data);
+  void onDevice3DEventForPoseTrace(vtkObject* caller, void* call_data, unsigned long vtk_event, void* client_data);
+  void onDevice3DEventForInputQueue(vtkObject* caller, void* call_data, unsigned long vtk_event, void* client_data);
 
 protected:
 
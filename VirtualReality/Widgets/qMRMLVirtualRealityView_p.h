@@ -32,10 +32,17 @@
 // We mean it.
 //
 
+// VR Logic includes
+#include "vtkVirtualRealityInputEventQueue.h"
+class vtkVirtualRealityAdaptiveQualityController;
+class vtkVirtualRealityFramePacer;
+class vtkVirtualRealityFrameTimingLog;
+
 // VR MRML includes
 #include "vtkMRMLVirtualRealityViewNode.h"
 
 // VR MRMLDM includes
+class vtkVirtualRealityPoseTracePlayer;
 class vtkVirtualRealityViewInteractorStyleDelegate;
 class vtkVirtualRealityViewInteractorObserver;
 
@@ -58,7 +65,10 @@ class vtkVRRenderWindowInteractor;
 #include <vtkSmartPointer.h>
 #include <vtkWeakPointer.h>
 class vtkLightCollection;
+class vtkMatrix4x4;
 class vtkObject;
+class vtkOpenGLRenderWindow;
+class vtkPropCollection;
 class vtkTimerLog;
 
 // CTK includes
@@ -67,8 +77,15 @@ class vtkTimerLog;
 // Qt includes
 #include <QObject>
 #include <QString>
+#include <QStringList>
 #include <QTimer>
 
+// STD includes
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
 //-----------------------------------------------------------------------------
 class qMRMLVirtualRealityViewPrivate: public QObject
 {
@@ -88,6 +105,28 @@ public:
 
   double desiredUpdateRate();
   double stillUpdateRate();
+  /// Update rate corresponding to the current quality level of the adaptive quality controller.
+  double adaptiveQualityUpdateRate();
+
+  /// Render scale corresponding to the current level of the render scale controller.
+  double dynamicRenderScale();
+  ///@{
+  /// Fraction of the eye render size used for rendering.
+  /// Only supported by the OpenVR and Simulated XR backends.
+  void setRenderScale(double scale);
+  double renderScale() const;
+  ///@}
+
+  /// Start or stop submitting the last frame while the render loop is stalled.
+  /// \sa vtkMRMLVirtualRealityViewNode::GetKeepAliveSubmission()
+  void updateKeepAliveSubmission(bool enabled);
+
+  /// Emit the controller button signals corresponding to a button event.
+  void emitButtonSignals(int device, int input, int action, const double trackPadPosition[2]);
+
+  /// Get refresh rate of the headset display (in Hz).
+  /// Falls back to 90 Hz if the XR backend does not report it.
+  double displayRefreshRate() const;
 
   vtkMRMLVirtualRealityViewNode::XRBackendType currentXRBackend() const;
   bool currentXRBackendRemotingEnabled() const;
@@ -96,23 +135,85 @@ public:
 public slots:
   void updateWidgetFromMRML();
   void doOpenVirtualReality();
+  /// Apply controller and lighthouse model visibility again, as device models may have been created.
+  void onDeviceStatusModified();
+
+  /// Record the rendering time of the scene in the frame timing log.
+  void onRenderStarted();
+  void onRenderEnded();
+
+  /// Run the next stage of the XR backend initialization.
+  /// \sa scheduleInitialization()
+  void continueInitialization();
+
+  /// Emit the signals of the input events queued while processing frames, until the next frame is due.
+  void processInputEvents();
 
 protected:
   void updateWidgetFromMRMLNoModify();
+
+  /// Write the magnification changed by interactions in the view node, at most once per frame.
+  /// The view node modification is not applied back to the view.
+  void updateMRMLFromInteraction();
   void updateTransformNodeWithControllerPose(vtkEventDataDevice device);
   void updateTransformNodeWithHMDPose();
   void updateTransformNodesWithTrackerPoses();
 
+  /// Append device poses and physical-to-world matrix of the current frame to the pose trace.
+  void writePoseTraceFrame();
+
   void updateTransformNodeFromDevice(vtkMRMLTransformNode* node, vtkEventDataDevice device, uint32_t index=0);
   void updateTransformNodeAttributesFromDevice(vtkMRMLTransformNode* node, vtkEventDataDevice device, uint32_t index=0);
 
+  /// Show or hide the controller and lighthouse models.
+  /// If \a force is false, models are only updated if the visibility properties changed.
+  void updateDeviceModelsFromMRML(bool force);
+
+  /// Start an XR backend initialization attempt after \a delay milliseconds.
+  ///
+  /// Initialization is split in stages run from the event loop, so that progress is reported
+  /// through the view node connection state:
+  /// - OpenVR: the presence of a headset is checked and the runtime server is started in a
+  ///   background thread
+  /// - the render window is created and initialized in the main thread, as the rendering
+  ///   context must be created in the main thread. The GUI is blocked meanwhile, for up to
+  ///   a few seconds if the XR runtime was not started yet (OpenXR runtimes are started by
+  ///   the render window initialization).
+  ///
+  /// Failed attempts are retried with an increasing delay, up to a maximum number of attempts.
+  void scheduleInitialization(int delay);
+  /// Stop the initialization in progress, if any.
+  void cancelInitialization();
+  /// Retry or give up after a failed initialization attempt.
+  void onInitializationAttemptFailed(const std::string& errorText);
+
   void createRenderWindow(vtkMRMLVirtualRealityViewNode::XRBackendType xrBackend);
   void destroyRenderWindow();
 
+  /// Share the OpenGL context of the render window with the one of the reference view.
+  /// Returns the render window of the reference view, or nullptr if it is not found.
+  /// \sa vtkMRMLVirtualRealityViewNode::GetSharedGraphicsResources()
+  vtkOpenGLRenderWindow* shareGraphicsResourcesWithReferenceView();
+
+  /// Detach the displayable managers and their props from the renderer, before the render window
+  /// is destroyed, so that the next render window created reuses them instead of rebuilding the scene.
+  /// \sa releaseDetachedDisplayableManagers()
+  void detachDisplayableManagers();
+  /// Delete the displayable managers kept by detachDisplayableManagers(), if they were not reused.
+  void releaseDetachedDisplayableManagers();
+  /// Class names of the displayable managers that create widgets. Their widgets are bound to the
+  /// renderer, they are created again when the displayable managers are reused.
+  static QStringList widgetDisplayableManagerClassNames();
+  /// Add the props that the current interactor style displays in the renderer to the collection.
+  void getInteractorStyleProps(vtkPropCollection* props);
+
   vtkSlicerCamerasModuleLogic* CamerasLogic;
   vtkSmartPointer<vtkSlicerVirtualRealityLogic> VirtualRealityLogic;
 
   vtkSmartPointer<vtkMRMLDisplayableManagerGroup> DisplayableManagerGroup;
+  /// Displayable managers and props kept while the XR backend is reinitialized
+  vtkSmartPointer<vtkMRMLDisplayableManagerGroup> DetachedDisplayableManagerGroup;
+  vtkSmartPointer<vtkPropCollection> DetachedViewProps;
   vtkSmartPointer<vtkVirtualRealityViewInteractorObserver>  InteractorObserver;
   vtkSmartPointer<vtkVirtualRealityViewInteractorStyleDelegate> InteractorStyleDelegate;
   vtkWeakPointer<vtkMRMLVirtualRealityViewNode> MRMLVirtualRealityViewNode;
@@ -131,12 +232,89 @@ protected:
   double LastViewUp[3];
   double LastViewPosition[3];
 
+  /// Matrices reused for publishing device poses, to avoid allocations in the render loop
+  vtkSmartPointer<vtkMatrix4x4> PhysicalToWorldMatrix;
+  vtkSmartPointer<vtkMatrix4x4> DeviceToWorldMatrix;
+  vtkSmartPointer<vtkMatrix4x4> PublishedDeviceToWorldMatrix;
+
   QString ActionManifestPath;
 
   bool IsUpdatingWidgetFromMRML{false};
+  bool IsUpdatingMRMLFromInteraction{false};
+
+  /// View node properties applied to the view. When the view node is modified, only the
+  /// properties that differ from these are applied. Reset when the render window is destroyed.
+  struct AppliedViewNodeProperties
+  {
+    bool Valid{false};
+    bool Remoting{false};
+    double BackgroundColor[3]{0.0, 0.0, 0.0};
+    double BackgroundColor2[3]{0.0, 0.0, 0.0};
+    bool TwoSidedLighting{false};
+    bool BackLights{false};
+    bool UseDepthPeeling{false};
+    bool AdaptiveQuality{false};
+    double AdaptiveQualityMinimum{0.0};
+    double AdaptiveQualityMaximum{0.0};
+    double DesiredUpdateRate{0.0};
+    bool DynamicRenderScale{false};
+    double MinimumRenderScale{0.0};
+    double MaximumRenderScale{0.0};
+    double Magnification{0.0};
+    double MotionSpeed{0.0};
+    bool ControllerModelsVisible{false};
+    bool LighthouseModelsVisible{false};
+  };
+  AppliedViewNodeProperties AppliedProperties;
+
+  /// OpenVR handles of the tracking references (lighthouses), updated when device statuses change
+  std::vector<uint32_t> TrackingReferenceHandles;
+  bool TrackingReferenceHandlesValid{false};
+  /// Set when the physical to world matrix was modified by interactions since the last frame
+  bool PhysicalToWorldMatrixModifiedByInteraction{false};
   int InitializationAttempts{0};
+  /// Set if the OpenGL context of the render window is shared with the one of the reference view
+  bool GraphicsResourcesShared{false};
+  /// Set if the context could not be shared, the render window is then created without sharing
+  /// until the view is disconnected
+  bool GraphicsResourcesSharingFailed{false};
+
+  enum InitializationStageType
+  {
+    InitializationStageIdle,
+    InitializationStageStartAttempt,
+    InitializationStageCheckRuntime,
+    InitializationStageCreateRenderWindow
+  };
+  InitializationStageType InitializationStage{InitializationStageIdle};
+  QTimer InitializationTimer;
+  /// XR backend that initialization attempts are made for
+  vtkMRMLVirtualRealityViewNode::XRBackendType InitializationXRBackend{vtkMRMLVirtualRealityViewNode::UndefinedXRBackend};
+  bool InitializationRemoting{false};
+  std::string InitializationPlayerIPAddress;
+  /// Result of a runtime check performed in a background thread. The state is shared with the
+  /// detached thread, so that a check abandoned by a cancelled initialization completes on its own.
+  struct RuntimeCheckState
+  {
+    std::atomic<bool> Completed{false};
+    std::atomic<bool> HMDPresent{false};
+  };
+  std::shared_ptr<RuntimeCheckState> InitializationRuntimeCheck;
 
   QTimer VirtualRealityLoopTimer;
+  vtkSmartPointer<vtkVirtualRealityFramePacer> FramePacer;
+  vtkSmartPointer<vtkVirtualRealityFrameTimingLog> FrameTimingLog;
+  vtkSmartPointer<vtkVirtualRealityAdaptiveQualityController> AdaptiveQualityController;
+  vtkSmartPointer<vtkVirtualRealityAdaptiveQualityController> RenderScaleController;
+
+  vtkSmartPointer<vtkVirtualRealityPoseTraceWriter> PoseTraceWriter;
+  vtkSmartPointer<vtkVirtualRealityPoseTracePlayer> PoseTracePlayer;
+  vtkSmartPointer<vtkMatrix4x4> PoseTraceMatrix;
+
+  /// Filled while processing a frame, drained by processInputEvents() after the frame
+  vtkSmartPointer<vtkVirtualRealityInputEventQueue> InputEventQueue;
+  QTimer InputEventTimer;
+  vtkTypeInt64 ReportedNumberOfInputEventOverflows{0};
 };
 
 #endif
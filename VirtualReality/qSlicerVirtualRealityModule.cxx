@@ -58,6 +58,12 @@
 // MRML includes
 #include <vtkMRMLScene.h>
 
+// VTK includes
+#include <vtkWeakPointer.h>
+
+// STD includes
+#include <algorithm>
+
 // Slicer includes
 #include <vtkSlicerApplicationLogic.h>
 #include <vtkSlicerCamerasModuleLogic.h>
@@ -97,7 +103,10 @@ public:
   QAction* ConfigureAction;
   QAction* OptimizeSceneAction;
   qMRMLVirtualRealityView* VirtualRealityViewWidget;
+  /// Toolbar actions of the device status widgets, in toolbar order
   std::vector<QAction*> TransformWidgets;
+  /// View node the device status widgets were created for
+  vtkWeakPointer<vtkMRMLVirtualRealityViewNode> TransformWidgetsViewNode;
   QAction* Spacer;
 };
 
@@ -269,44 +278,102 @@ void qSlicerVirtualRealityModulePrivate::updateToolBar()
 
   this->UpdateViewFromReferenceViewCameraAction->setEnabled(this->VirtualRealityToggleAction->isChecked());
 
-  // Remove all transform nodes, add widgets for each enabled transform node
-  for (QAction* action : this->TransformWidgets)
-  {
-    this->ToolBar->removeAction(action);
-  }
-  this->TransformWidgets.clear();
-  this->ToolBar->removeAction(this->Spacer);
-
+  // Device status widgets are only added or removed when the set of device transform nodes changes
+  std::vector<vtkMRMLLinearTransformNode*> transformNodes;
   if (vrViewNode != nullptr)
   {
     if (vrViewNode->GetHMDTransformNode() != nullptr)
     {
-      qMRMLVirtualRealityTransformWidget* widget = new qMRMLVirtualRealityTransformWidget(vrViewNode);
-      this->TransformWidgets.push_back(this->ToolBar->addWidget(widget));
-      widget->setMRMLLinearTransformNode(vrViewNode->GetHMDTransformNode());
+      transformNodes.push_back(vrViewNode->GetHMDTransformNode());
     }
     if (vrViewNode->GetLeftControllerTransformNode() != nullptr)
     {
-      qMRMLVirtualRealityTransformWidget* widget = new qMRMLVirtualRealityTransformWidget(vrViewNode);
-      this->TransformWidgets.push_back(this->ToolBar->addWidget(widget));
-      widget->setMRMLLinearTransformNode(vrViewNode->GetLeftControllerTransformNode());
+      transformNodes.push_back(vrViewNode->GetLeftControllerTransformNode());
     }
     if (vrViewNode->GetRightControllerTransformNode() != nullptr)
     {
-      qMRMLVirtualRealityTransformWidget* widget = new qMRMLVirtualRealityTransformWidget(vrViewNode);
-      this->TransformWidgets.push_back(this->ToolBar->addWidget(widget));
-      widget->setMRMLLinearTransformNode(vrViewNode->GetRightControllerTransformNode());
+      transformNodes.push_back(vrViewNode->GetRightControllerTransformNode());
     }
     for (auto node : vrViewNode->GetTrackerTransformNodes())
     {
-      qMRMLVirtualRealityTransformWidget* widget = new qMRMLVirtualRealityTransformWidget(vrViewNode);
-      this->TransformWidgets.push_back(this->ToolBar->addWidget(widget));
-      widget->setMRMLLinearTransformNode(node);
+      transformNodes.push_back(node);
+    }
+  }
+
+  // Widgets observe the view node, they are all recreated if the view node changed
+  if (this->TransformWidgetsViewNode != vrViewNode)
+  {
+    for (QAction* action : this->TransformWidgets)
+    {
+      this->ToolBar->removeAction(action);
+      // Deletes the widget, which stops observing the view node
+      delete action;
+    }
+    this->TransformWidgets.clear();
+    this->TransformWidgetsViewNode = vrViewNode;
+  }
+
+  // Remove widgets of the transform nodes that are no longer used
+  for (auto actionIt = this->TransformWidgets.begin(); actionIt != this->TransformWidgets.end();)
+  {
+    qMRMLVirtualRealityTransformWidget* widget =
+      qobject_cast<qMRMLVirtualRealityTransformWidget*>(this->ToolBar->widgetForAction(*actionIt));
+    vtkMRMLLinearTransformNode* node = widget ? widget->mrmlLinearTransformNode() : nullptr;
+    if (node == nullptr || std::find(transformNodes.begin(), transformNodes.end(), node) == transformNodes.end())
+    {
+      this->ToolBar->removeAction(*actionIt);
+      delete *actionIt;
+      actionIt = this->TransformWidgets.erase(actionIt);
+    }
+    else
+    {
+      ++actionIt;
+    }
+  }
+
+  // Widgets are inserted before the spacer, which aligns the widgets to the left
+  if (this->Spacer == nullptr)
+  {
+    QWidget* spacerWidget = new QWidget();
+    spacerWidget->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Preferred);
+    this->Spacer = this->ToolBar->addWidget(spacerWidget);
+  }
+
+  // Add widgets for the new transform nodes, keeping the order of the devices
+  for (size_t nodeIndex = 0; nodeIndex < transformNodes.size(); ++nodeIndex)
+  {
+    vtkMRMLLinearTransformNode* node = transformNodes[nodeIndex];
+    // Widgets before nodeIndex are in place, the widget of the node may follow if devices changed order
+    size_t widgetIndex = nodeIndex;
+    for (; widgetIndex < this->TransformWidgets.size(); ++widgetIndex)
+    {
+      qMRMLVirtualRealityTransformWidget* existingWidget =
+        qobject_cast<qMRMLVirtualRealityTransformWidget*>(this->ToolBar->widgetForAction(this->TransformWidgets[widgetIndex]));
+      if (existingWidget && existingWidget->mrmlLinearTransformNode() == node)
+      {
+        break;
+      }
+    }
+    bool widgetExists = widgetIndex < this->TransformWidgets.size();
+    if (widgetExists && widgetIndex == nodeIndex)
+    {
+      continue;
+    }
+    QAction* before = nodeIndex < this->TransformWidgets.size() ? this->TransformWidgets[nodeIndex] : this->Spacer;
+    if (widgetExists)
+    {
+      // Move the existing widget
+      QAction* action = this->TransformWidgets[widgetIndex];
+      this->TransformWidgets.erase(this->TransformWidgets.begin() + widgetIndex);
+      this->ToolBar->removeAction(action);
+      this->ToolBar->insertAction(before, action);
+      this->TransformWidgets.insert(this->TransformWidgets.begin() + nodeIndex, action);
+      continue;
     }
+    qMRMLVirtualRealityTransformWidget* widget = new qMRMLVirtualRealityTransformWidget(vrViewNode);
+    this->TransformWidgets.insert(this->TransformWidgets.begin() + nodeIndex, this->ToolBar->insertWidget(before, widget));
+    widget->setMRMLLinearTransformNode(node);
   }
-  QWidget* widget = new QWidget();
-  widget->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Preferred);
-  this->Spacer = this->ToolBar->addWidget(widget);
 }
 
 //-----------------------------------------------------------------------------
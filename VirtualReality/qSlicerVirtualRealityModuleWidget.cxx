@@ -91,6 +91,9 @@ void qSlicerVirtualRealityModuleWidget::setup()
         vtkMRMLVirtualRealityViewNode::GetXRBackendAsString(vtkMRMLVirtualRealityViewNode::OpenXR),
         vtkMRMLVirtualRealityViewNode::OpenXR);
 #endif
+  d->XRBackendComboBox->addItem(
+        vtkMRMLVirtualRealityViewNode::GetXRBackendAsString(vtkMRMLVirtualRealityViewNode::Simulated),
+        vtkMRMLVirtualRealityViewNode::Simulated);
 
   connect(d->XRBackendComboBox, SIGNAL(currentIndexChanged(int)), this, SLOT(setVirtualRealityXRBackend(int)));
   connect(d->RemotingEnabledCheckBox, SIGNAL(toggled(bool)), this, SLOT(setRemotingEnabled(bool)));
@@ -144,12 +147,24 @@ void qSlicerVirtualRealityModuleWidget::updateWidgetFromMRML()
         && !vrLogic->GetVirtualRealityConnected());
   d->XRBackendComboBox->blockSignals(wasBlocked);
 
-  QString errorText;
+  QString statusText;
   if (vrViewNode && vrViewNode->HasError())
   {
-    errorText = vrViewNode->GetError().c_str();
+    statusText = vrViewNode->GetError().c_str();
+  }
+  else if (vrViewNode && vrViewNode->GetConnectionState() == vtkMRMLVirtualRealityViewNode::ConnectionStateConnecting)
+  {
+    statusText = tr("Connecting (attempt %1)...").arg(vrViewNode->GetConnectionAttempt());
+  }
+  else if (vrViewNode && vrViewNode->GetConnectionState() == vtkMRMLVirtualRealityViewNode::ConnectionStateCreatingSession)
+  {
+    statusText = tr("Creating session (attempt %1)...").arg(vrViewNode->GetConnectionAttempt());
+  }
+  else if (vrViewNode && vrViewNode->GetConnectionState() == vtkMRMLVirtualRealityViewNode::ConnectionStateRetrying)
+  {
+    statusText = tr("Connection attempt %1 failed, retrying...").arg(vrViewNode->GetConnectionAttempt());
   }
-  d->ConnectionStatusLabel->setText(errorText);
+  d->ConnectionStatusLabel->setText(statusText);
 
   wasBlocked = d->RenderingEnabledCheckBox->blockSignals(true);
   d->RenderingEnabledCheckBox->setChecked(vrViewNode != nullptr && vrViewNode->GetActive());